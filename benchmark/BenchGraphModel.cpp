@@ -0,0 +1,191 @@
+#include "BenchmarkModels.hpp"
+#include "BenchmarkRunner.hpp"
+
+#include <QtNodes/GraphAnalysis>
+
+#include <cstddef>
+
+static std::vector<int> const ModelSizes{1000, 10000, 100000};
+
+static void addNodes(BenchmarkContext &context)
+{
+    DataFlowGraphModel model(benchmarkRegistry());
+
+    context.measure([&] {
+        for (int i = 0; i < context.size(); ++i) {
+            model.addNode(SumModel<1>::Name());
+        }
+    });
+}
+
+static void addNodesByTypeId(BenchmarkContext &context)
+{
+    DataFlowGraphModel model(benchmarkRegistry());
+
+    ModelTypeId const typeId = model.dataModelRegistry()->modelTypeId(SumModel<1>::Name());
+
+    context.measure([&] {
+        for (int i = 0; i < context.size(); ++i) {
+            model.addNode(typeId);
+        }
+    });
+}
+
+static void registerDescriptors(BenchmarkContext &context)
+{
+    std::vector<QString> names;
+    names.reserve(context.size());
+    for (int i = 0; i < context.size(); ++i) {
+        names.push_back(QString("Model%1").arg(i));
+    }
+
+    NodeDelegateModelRegistry registry;
+
+    context.measure([&] {
+        for (QString const &name : names) {
+            ModelDescriptor descriptor;
+            descriptor.name = name;
+            descriptor.category = "Operators";
+
+            registry.registerModel(std::move(descriptor),
+                                   []() { return std::make_unique<SumModel<1>>(); });
+        }
+    });
+}
+
+static void connectChain(BenchmarkContext &context)
+{
+    DataFlowGraphModel model(benchmarkRegistry());
+
+    std::vector<NodeId> nodes;
+    nodes.reserve(context.size());
+    for (int i = 0; i < context.size(); ++i) {
+        nodes.push_back(model.addNode(SumModel<1>::Name()));
+    }
+
+    context.measure([&] {
+        for (std::size_t i = 1; i < nodes.size(); ++i) {
+            model.addConnection(ConnectionId{nodes[i - 1], 0, nodes[i], 0});
+        }
+    });
+}
+
+/// Every connection goes against the creation order, which forces the
+/// maintained topological order to move the whole chain built so far.
+static void connectChainReversed(BenchmarkContext &context)
+{
+    DataFlowGraphModel model(benchmarkRegistry());
+
+    std::vector<NodeId> nodes;
+    nodes.reserve(context.size());
+    for (int i = 0; i < context.size(); ++i) {
+        nodes.push_back(model.addNode(SumModel<1>::Name()));
+    }
+
+    context.measure([&] {
+        for (std::size_t i = 1; i < nodes.size(); ++i) {
+            model.addConnection(ConnectionId{nodes[i], 0, nodes[i - 1], 0});
+        }
+    });
+}
+
+static void deleteNodes(BenchmarkContext &context)
+{
+    DataFlowGraphModel model(benchmarkRegistry());
+
+    std::vector<NodeId> const nodes = BenchmarkGraphs::layered(model, context.size());
+
+    context.measure([&] {
+        for (NodeId const nodeId : nodes) {
+            model.deleteNode(nodeId);
+        }
+    });
+}
+
+static void queryConnections(BenchmarkContext &context)
+{
+    DataFlowGraphModel model(benchmarkRegistry());
+
+    std::vector<NodeId> const nodes = BenchmarkGraphs::layered(model, context.size());
+
+    std::size_t found = 0;
+
+    context.measure([&] {
+        for (NodeId const nodeId : nodes) {
+            found += model.connections(nodeId, PortType::Out, 0).size();
+            found += model.connections(nodeId, PortType::In, 0).size();
+        }
+    });
+
+    context.setCounter("connections_found", static_cast<double>(found));
+}
+
+static void queryAllConnectionIds(BenchmarkContext &context)
+{
+    DataFlowGraphModel model(benchmarkRegistry());
+
+    std::vector<NodeId> const nodes = BenchmarkGraphs::layered(model, context.size());
+
+    std::size_t found = 0;
+
+    context.measure([&] {
+        for (NodeId const nodeId : nodes) {
+            found += model.allConnectionIds(nodeId).size();
+        }
+    });
+
+    context.setCounter("connections_found", static_cast<double>(found));
+}
+
+/// Downstream cone of every tenth node, each query misses the cache.
+static void analysisDownstream(BenchmarkContext &context)
+{
+    DataFlowGraphModel model(benchmarkRegistry());
+
+    std::vector<NodeId> const nodes = BenchmarkGraphs::layered(model, context.size());
+
+    QtNodes::GraphAnalysis analysis(model);
+
+    std::size_t found = 0;
+
+    context.measure([&] {
+        for (std::size_t i = 0; i < nodes.size(); i += 10) {
+            found += analysis.downstream(nodes[i]).size();
+        }
+    });
+
+    context.setCounter("nodes_found", static_cast<double>(found));
+}
+
+/// Strong components and depths from scratch, then one cached longest path.
+static void analysisLongestPath(BenchmarkContext &context)
+{
+    DataFlowGraphModel model(benchmarkRegistry());
+
+    BenchmarkGraphs::layered(model, context.size());
+
+    QtNodes::GraphAnalysis analysis(model);
+
+    std::size_t length = 0;
+
+    context.measure([&] { length = analysis.longestPath().size(); });
+
+    context.setCounter("path_length", static_cast<double>(length));
+}
+
+void registerGraphModelBenchmarks(BenchmarkRunner &runner)
+{
+    runner.add("model/add_nodes", ModelSizes, addNodes);
+    runner.add("model/add_nodes_by_type_id", ModelSizes, addNodesByTypeId);
+    runner.add("registry/register_descriptors", {100, 1000}, registerDescriptors);
+    runner.add("model/connect_chain", ModelSizes, connectChain);
+    runner.add("model/connect_chain_reversed", {1000, 10000}, connectChainReversed);
+    runner.add("model/delete_nodes", ModelSizes, deleteNodes);
+
+    // The queries are linear in the number of connections, keep them smaller.
+    runner.add("model/connections", {1000, 10000}, queryConnections);
+    runner.add("model/all_connection_ids", {1000, 10000}, queryAllConnectionIds);
+
+    runner.add("analysis/downstream", {1000, 10000}, analysisDownstream);
+    runner.add("analysis/longest_path", ModelSizes, analysisLongestPath);
+}
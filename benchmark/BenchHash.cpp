@@ -0,0 +1,109 @@
+#include "BenchmarkRunner.hpp"
+
+#include <QtNodes/internal/ConnectionIdHash.hpp>
+#include <QtNodes/internal/FlatHash.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+using QtNodes::ConnectionId;
+using QtNodes::FlatHashSet;
+
+static std::vector<int> const HashSizes{100000, 1000000};
+
+/// Connections of a layered graph with four ports per node, shuffled.
+static std::vector<ConnectionId> makeConnections(int size)
+{
+    std::vector<ConnectionId> result;
+    result.reserve(size);
+
+    std::mt19937 rng(1);
+
+    for (int i = 0; i < size; ++i) {
+        unsigned int const out = static_cast<unsigned int>(i / 4);
+        result.push_back(ConnectionId{out,
+                                      static_cast<unsigned int>(i % 4),
+                                      out + 1 + static_cast<unsigned int>(rng() % 64),
+                                      static_cast<unsigned int>(rng() % 4)});
+    }
+
+    std::shuffle(result.begin(), result.end(), rng);
+
+    return result;
+}
+
+template<typename Set>
+static void insertConnections(BenchmarkContext &context)
+{
+    std::vector<ConnectionId> const connections = makeConnections(context.size());
+
+    Set set;
+
+    context.measure([&] {
+        for (ConnectionId const &cid : connections) {
+            set.insert(cid);
+        }
+    });
+
+    context.setCounter("size", static_cast<double>(set.size()));
+}
+
+template<typename Set>
+static void findConnections(BenchmarkContext &context)
+{
+    std::vector<ConnectionId> const connections = makeConnections(context.size());
+
+    Set set;
+    for (ConnectionId const &cid : connections) {
+        set.insert(cid);
+    }
+
+    // Every second lookup misses.
+    std::vector<ConnectionId> queries = connections;
+    for (std::size_t i = 0; i < queries.size(); i += 2) {
+        queries[i].inPortIndex += 4;
+    }
+
+    std::size_t found = 0;
+
+    context.measure([&] {
+        for (ConnectionId const &cid : queries) {
+            found += set.count(cid);
+        }
+    });
+
+    context.setCounter("found", static_cast<double>(found));
+}
+
+template<typename Set>
+static void eraseConnections(BenchmarkContext &context)
+{
+    std::vector<ConnectionId> const connections = makeConnections(context.size());
+
+    Set set;
+    for (ConnectionId const &cid : connections) {
+        set.insert(cid);
+    }
+
+    context.measure([&] {
+        for (ConnectionId const &cid : connections) {
+            set.erase(cid);
+        }
+    });
+}
+
+void registerHashBenchmarks(BenchmarkRunner &runner)
+{
+    using StdSet = std::unordered_set<ConnectionId>;
+    using FlatSet = FlatHashSet<ConnectionId>;
+
+    runner.add("hash/std_insert", HashSizes, insertConnections<StdSet>);
+    runner.add("hash/flat_insert", HashSizes, insertConnections<FlatSet>);
+    runner.add("hash/std_find", HashSizes, findConnections<StdSet>);
+    runner.add("hash/flat_find", HashSizes, findConnections<FlatSet>);
+    runner.add("hash/std_erase", HashSizes, eraseConnections<StdSet>);
+    runner.add("hash/flat_erase", HashSizes, eraseConnections<FlatSet>);
+}
@@ -0,0 +1,48 @@
+#include "BenchmarkModels.hpp"
+#include "BenchmarkRunner.hpp"
+
+#include <functional>
+
+// Propagation is recursive (one `dataUpdated` leads to the next `setInData`),
+// deep chains of 10k nodes could exhaust the stack. Deep layered graphs are
+// not used at all: every node re-propagates on each input, the amount of work
+// grows with the number of paths.
+static std::vector<int> const PropagationSizes{1000, 4000};
+
+using GraphBuilder = std::function<std::vector<NodeId>(DataFlowGraphModel &, int)>;
+
+static void propagate(BenchmarkContext &context, GraphBuilder const &build)
+{
+    DataFlowGraphModel model(benchmarkRegistry());
+
+    std::vector<NodeId> const nodes = build(model, context.size());
+
+    std::vector<SourceModel *> sources;
+    for (NodeId const nodeId : nodes) {
+        if (auto source = model.delegateModel<SourceModel>(nodeId))
+            sources.push_back(source);
+    }
+
+    context.measure([&] {
+        for (SourceModel *source : sources) {
+            source->setNumber(2.0);
+        }
+    });
+
+    context.setCounter("sources", static_cast<double>(sources.size()));
+}
+
+void registerPropagationBenchmarks(BenchmarkRunner &runner)
+{
+    runner.add("propagation/chain", PropagationSizes, [](BenchmarkContext &context) {
+        propagate(context, BenchmarkGraphs::chain);
+    });
+
+    runner.add("propagation/diamonds", {1000, 10000, 100000}, [](BenchmarkContext &context) {
+        propagate(context, BenchmarkGraphs::diamonds);
+    });
+
+    runner.add("propagation/fan_out", {1000, 10000, 100000}, [](BenchmarkContext &context) {
+        propagate(context, BenchmarkGraphs::fanOut);
+    });
+}
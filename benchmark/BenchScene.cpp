@@ -0,0 +1,72 @@
+#include "BenchmarkModels.hpp"
+#include "BenchmarkRunner.hpp"
+
+#include <QtNodes/DataFlowGraphicsScene>
+#include <QtNodes/GraphicsView>
+
+#include <QtGui/QImage>
+#include <QtGui/QPainter>
+
+#include <memory>
+
+using QtNodes::DataFlowGraphicsScene;
+using QtNodes::GraphicsView;
+
+static std::vector<int> const SceneSizes{1000, 10000, 100000};
+
+static void populate(BenchmarkContext &context)
+{
+    DataFlowGraphModel model(benchmarkRegistry());
+    BenchmarkGraphs::layered(model, context.size());
+
+    std::unique_ptr<DataFlowGraphicsScene> scene;
+
+    context.measure([&] { scene = std::make_unique<DataFlowGraphicsScene>(model); });
+
+    context.setCounter("items", static_cast<double>(scene->items().size()));
+}
+
+static void addNodesToScene(BenchmarkContext &context)
+{
+    DataFlowGraphModel model(benchmarkRegistry());
+    DataFlowGraphicsScene scene(model);
+
+    context.measure([&] { BenchmarkGraphs::layered(model, context.size()); });
+}
+
+static void render(BenchmarkContext &context, bool wholeScene)
+{
+    DataFlowGraphModel model(benchmarkRegistry());
+    BenchmarkGraphs::layered(model, context.size());
+
+    DataFlowGraphicsScene scene(model);
+
+    GraphicsView view(&scene);
+    view.resize(1920, 1080);
+
+    if (wholeScene)
+        view.fitInView(scene.itemsBoundingRect(), Qt::KeepAspectRatio);
+    else
+        view.centerOn(0.0, 0.0);
+
+    QImage image(view.size(), QImage::Format_ARGB32_Premultiplied);
+
+    context.measure([&] {
+        QPainter painter(&image);
+        view.render(&painter);
+    });
+}
+
+void registerSceneBenchmarks(BenchmarkRunner &runner)
+{
+    runner.add("scene/populate", SceneSizes, populate);
+    runner.add("scene/add_nodes", SceneSizes, addNodesToScene);
+
+    runner.add("scene/render_viewport", SceneSizes, [](BenchmarkContext &context) {
+        render(context, false);
+    });
+
+    runner.add("scene/render_all", {1000, 10000}, [](BenchmarkContext &context) {
+        render(context, true);
+    });
+}
@@ -0,0 +1,54 @@
+#include "BenchmarkModels.hpp"
+#include "BenchmarkRunner.hpp"
+
+#include <QtCore/QJsonDocument>
+
+static std::vector<int> const SerializationSizes{1000, 10000, 100000};
+
+static QJsonObject layeredSceneJson(int size)
+{
+    DataFlowGraphModel model(benchmarkRegistry());
+
+    BenchmarkGraphs::layered(model, size);
+
+    return model.save();
+}
+
+static void save(BenchmarkContext &context)
+{
+    DataFlowGraphModel model(benchmarkRegistry());
+
+    BenchmarkGraphs::layered(model, context.size());
+
+    QByteArray bytes;
+
+    context.measure([&] { bytes = QJsonDocument(model.save()).toJson(QJsonDocument::Compact); });
+
+    context.setCounter("bytes", static_cast<double>(bytes.size()));
+}
+
+static void load(BenchmarkContext &context, bool parallel)
+{
+    QByteArray const bytes = QJsonDocument(layeredSceneJson(context.size()))
+                                 .toJson(QJsonDocument::Compact);
+
+    DataFlowGraphModel model(benchmarkRegistry());
+    model.setParallelLoadEnabled(parallel);
+
+    context.measure([&] { model.load(QJsonDocument::fromJson(bytes).object()); });
+
+    context.setCounter("bytes", static_cast<double>(bytes.size()));
+}
+
+void registerSerializationBenchmarks(BenchmarkRunner &runner)
+{
+    runner.add("serialization/save", SerializationSizes, save);
+
+    runner.add("serialization/load", SerializationSizes, [](BenchmarkContext &context) {
+        load(context, false);
+    });
+
+    runner.add("serialization/load_parallel", SerializationSizes, [](BenchmarkContext &context) {
+        load(context, true);
+    });
+}
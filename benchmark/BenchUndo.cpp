@@ -0,0 +1,99 @@
+#include "BenchmarkModels.hpp"
+#include "BenchmarkRunner.hpp"
+
+#include <QtNodes/DataFlowGraphicsScene>
+#include <QtNodes/internal/UndoCommands.hpp>
+
+#include <QUndoStack>
+#include <QtWidgets/QGraphicsItem>
+
+using QtNodes::DataFlowGraphicsScene;
+using QtNodes::DeleteCommand;
+
+static std::vector<int> const UndoSizes{1000, 10000};
+
+static void selectAll(DataFlowGraphicsScene &scene)
+{
+    for (QGraphicsItem *item : scene.items()) {
+        item->setSelected(true);
+    }
+}
+
+static void deleteSelection(BenchmarkContext &context)
+{
+    DataFlowGraphModel model(benchmarkRegistry());
+    BenchmarkGraphs::layered(model, context.size());
+
+    DataFlowGraphicsScene scene(model);
+    selectAll(scene);
+
+    context.measure([&] { scene.undoStack().push(new DeleteCommand(&scene)); });
+}
+
+static void undoDelete(BenchmarkContext &context)
+{
+    DataFlowGraphModel model(benchmarkRegistry());
+    BenchmarkGraphs::layered(model, context.size());
+
+    DataFlowGraphicsScene scene(model);
+    selectAll(scene);
+
+    scene.undoStack().push(new DeleteCommand(&scene));
+
+    context.measure([&] { scene.undoStack().undo(); });
+}
+
+static void redoDelete(BenchmarkContext &context)
+{
+    DataFlowGraphModel model(benchmarkRegistry());
+    BenchmarkGraphs::layered(model, context.size());
+
+    DataFlowGraphicsScene scene(model);
+    selectAll(scene);
+
+    scene.undoStack().push(new DeleteCommand(&scene));
+    scene.undoStack().undo();
+
+    context.measure([&] { scene.undoStack().redo(); });
+}
+
+/// Deletes the whole graph and brings it back repeatedly, the node models are
+/// recreated every time unless the registry pools them.
+static void deleteUndoCycles(BenchmarkContext &context, std::size_t poolCapacity)
+{
+    DataFlowGraphModel model(benchmarkRegistry(poolCapacity));
+    BenchmarkGraphs::layered(model, context.size());
+
+    DataFlowGraphicsScene scene(model);
+    selectAll(scene);
+
+    scene.undoStack().push(new DeleteCommand(&scene));
+    scene.undoStack().undo();
+
+    int const cycles = 5;
+
+    context.measure([&] {
+        for (int i = 0; i < cycles; ++i) {
+            scene.undoStack().redo();
+            scene.undoStack().undo();
+        }
+    });
+
+    std::size_t const pooled = model.dataModelRegistry()->pooledModelCount();
+
+    context.setCounter("pooled_models", static_cast<double>(pooled));
+}
+
+void registerUndoBenchmarks(BenchmarkRunner &runner)
+{
+    runner.add("undo/delete_selection", UndoSizes, deleteSelection);
+    runner.add("undo/undo_delete", UndoSizes, undoDelete);
+    runner.add("undo/redo_delete", UndoSizes, redoDelete);
+
+    runner.add("undo/delete_undo_cycles", UndoSizes, [](BenchmarkContext &context) {
+        deleteUndoCycles(context, 0);
+    });
+    runner.add("undo/delete_undo_cycles_pooled", UndoSizes, [](BenchmarkContext &context) {
+        deleteUndoCycles(context, static_cast<std::size_t>(context.size()));
+    });
+}
@@ -0,0 +1,113 @@
+#include "BenchmarkModels.hpp"
+
+#include <QtCore/QPointF>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace BenchmarkGraphs {
+
+static NodeId addNode(DataFlowGraphModel &model, QString const &name, int index)
+{
+    NodeId const nodeId = model.addNode(name);
+
+    int const columns = 100;
+    model.setNodeData(nodeId,
+                      QtNodes::NodeRole::Position,
+                      QPointF((index % columns) * 250.0, (index / columns) * 150.0));
+
+    return nodeId;
+}
+
+std::vector<NodeId> chain(DataFlowGraphModel &model, int size)
+{
+    std::vector<NodeId> nodes;
+    nodes.reserve(size);
+
+    nodes.push_back(addNode(model, SourceModel::Name(), 0));
+
+    for (int i = 1; i < size; ++i) {
+        nodes.push_back(addNode(model, SumModel<1>::Name(), i));
+        model.addConnection(ConnectionId{nodes[i - 1], 0, nodes[i], 0});
+    }
+
+    return nodes;
+}
+
+std::vector<NodeId> diamonds(DataFlowGraphModel &model, int size)
+{
+    std::vector<NodeId> nodes;
+    nodes.reserve(size);
+
+    NodeId const source = addNode(model, SourceModel::Name(), 0);
+    nodes.push_back(source);
+
+    while (static_cast<int>(nodes.size()) + 3 <= size) {
+        int const index = static_cast<int>(nodes.size());
+
+        NodeId const left = addNode(model, SumModel<1>::Name(), index);
+        NodeId const right = addNode(model, SumModel<1>::Name(), index + 1);
+        NodeId const join = addNode(model, SumModel<2>::Name(), index + 2);
+
+        model.addConnection(ConnectionId{source, 0, left, 0});
+        model.addConnection(ConnectionId{source, 0, right, 0});
+        model.addConnection(ConnectionId{left, 0, join, 0});
+        model.addConnection(ConnectionId{right, 0, join, 1});
+
+        nodes.push_back(left);
+        nodes.push_back(right);
+        nodes.push_back(join);
+    }
+
+    return nodes;
+}
+
+std::vector<NodeId> fanOut(DataFlowGraphModel &model, int size)
+{
+    std::vector<NodeId> nodes;
+    nodes.reserve(size);
+
+    nodes.push_back(addNode(model, SourceModel::Name(), 0));
+
+    for (int i = 1; i < size; ++i) {
+        nodes.push_back(addNode(model, SumModel<1>::Name(), i));
+        model.addConnection(ConnectionId{nodes.front(), 0, nodes.back(), 0});
+    }
+
+    return nodes;
+}
+
+std::vector<NodeId> layered(DataFlowGraphModel &model, int size, unsigned int seed)
+{
+    std::vector<NodeId> nodes;
+    nodes.reserve(size);
+
+    int const width = std::max(1, static_cast<int>(std::sqrt(static_cast<double>(size))));
+
+    std::mt19937 generator(seed);
+
+    for (int i = 0; i < size; ++i) {
+        if (i < width) {
+            nodes.push_back(addNode(model, SourceModel::Name(), i));
+            continue;
+        }
+
+        nodes.push_back(addNode(model, SumModel<2>::Name(), i));
+
+        // Both inputs come from the previous layer.
+        int const layerStart = (i / width - 1) * width;
+
+        // The raw engine output is used: the distributions are not portable
+        // between standard libraries.
+        NodeId const first = nodes[layerStart + generator() % width];
+        NodeId const second = nodes[layerStart + generator() % width];
+
+        model.addConnection(ConnectionId{first, 0, nodes.back(), 0});
+        model.addConnection(ConnectionId{second, 0, nodes.back(), 1});
+    }
+
+    return nodes;
+}
+
+} // namespace BenchmarkGraphs
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <QtNodes/DataFlowGraphModel>
+#include <QtNodes/NodeData>
+#include <QtNodes/NodeDelegateModel>
+#include <QtNodes/NodeDelegateModelRegistry>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+
+#include <memory>
+#include <vector>
+
+using QtNodes::ConnectionId;
+using QtNodes::DataFlowGraphModel;
+using QtNodes::ModelDescriptor;
+using QtNodes::ModelTypeId;
+using QtNodes::NodeData;
+using QtNodes::NodeDataType;
+using QtNodes::NodeDelegateModel;
+using QtNodes::NodeDelegateModelRegistry;
+using QtNodes::NodeId;
+using QtNodes::PortIndex;
+using QtNodes::PortType;
+
+class NumberData : public NodeData
+{
+public:
+    explicit NumberData(double number = 0.0)
+        : _number(number)
+    {}
+
+    NodeDataType type() const override { return NodeDataType{"number", "Number"}; }
+
+    double number() const { return _number; }
+
+private:
+    double _number;
+};
+
+/// A node without inputs and with one output, the value is set from the code.
+class SourceModel : public NodeDelegateModel
+{
+    Q_OBJECT
+
+public:
+    static QString Name() { return QStringLiteral("Source"); }
+
+    QString caption() const override { return Name(); }
+
+    QString name() const override { return Name(); }
+
+    unsigned int nPorts(PortType portType) const override
+    {
+        return portType == PortType::Out ? 1 : 0;
+    }
+
+    NodeDataType dataType(PortType, PortIndex) const override { return NumberData().type(); }
+
+    std::shared_ptr<NodeData> outData(PortIndex) override { return _data; }
+
+    void setInData(std::shared_ptr<NodeData>, PortIndex) override {}
+
+    QWidget *embeddedWidget() override { return nullptr; }
+
+    QJsonObject save() const override
+    {
+        QJsonObject json = NodeDelegateModel::save();
+        json["number"] = _data ? _data->number() : 0.0;
+        return json;
+    }
+
+    void load(QJsonObject const &json) override
+    {
+        _data = std::make_shared<NumberData>(json["number"].toDouble());
+    }
+
+    void setNumber(double number)
+    {
+        _data = std::make_shared<NumberData>(number);
+        Q_EMIT dataUpdated(0);
+    }
+
+    bool reset() override
+    {
+        _data = std::make_shared<NumberData>(1.0);
+        return true;
+    }
+
+private:
+    std::shared_ptr<NumberData> _data = std::make_shared<NumberData>(1.0);
+};
+
+/// Adds all its inputs, the number of inputs is given by the registered name.
+template<unsigned int InputCount>
+class SumModel : public NodeDelegateModel
+{
+public:
+    static QString Name() { return QStringLiteral("Sum%1").arg(InputCount); }
+
+    QString caption() const override { return Name(); }
+
+    QString name() const override { return Name(); }
+
+    unsigned int nPorts(PortType portType) const override
+    {
+        return portType == PortType::In ? InputCount : 1;
+    }
+
+    NodeDataType dataType(PortType, PortIndex) const override { return NumberData().type(); }
+
+    std::shared_ptr<NodeData> outData(PortIndex) override { return _result; }
+
+    void setInData(std::shared_ptr<NodeData> data, PortIndex portIndex) override
+    {
+        _inputs[portIndex] = std::static_pointer_cast<NumberData>(data);
+
+        double sum = 0.0;
+        for (auto const &input : _inputs) {
+            if (input)
+                sum += input->number();
+        }
+
+        _result = std::make_shared<NumberData>(sum);
+
+        Q_EMIT dataUpdated(0);
+    }
+
+    QWidget *embeddedWidget() override { return nullptr; }
+
+    bool reset() override
+    {
+        for (auto &input : _inputs)
+            input.reset();
+
+        _result.reset();
+        return true;
+    }
+
+private:
+    std::shared_ptr<NumberData> _inputs[InputCount];
+
+    std::shared_ptr<NumberData> _result;
+};
+
+/// `poolCapacity` is passed to `NodeDelegateModelRegistry::setPoolCapacity`.
+inline std::shared_ptr<NodeDelegateModelRegistry> benchmarkRegistry(std::size_t poolCapacity = 0)
+{
+    auto registry = std::make_shared<NodeDelegateModelRegistry>();
+    registry->setPoolCapacity(poolCapacity);
+
+    registry->registerModel<SourceModel>("Sources");
+    registry->registerModel<SumModel<1>>("Operators");
+    registry->registerModel<SumModel<2>>("Operators");
+
+    return registry;
+}
+
+/// Topologies used by the benchmarks, all the nodes are laid out on a grid.
+namespace BenchmarkGraphs {
+
+/// Source followed by `size - 1` single-input nodes.
+std::vector<NodeId> chain(DataFlowGraphModel &model, int size);
+
+/// One source feeding independent diamonds: two parallel nodes and a joining node.
+/**
+ * Each joining node is evaluated twice per source update. The diamonds are
+ * not stacked since the amount of work would double with every level.
+ */
+std::vector<NodeId> diamonds(DataFlowGraphModel &model, int size);
+
+/// One source feeding `size - 1` nodes directly.
+std::vector<NodeId> fanOut(DataFlowGraphModel &model, int size);
+
+/// Layered DAG with two inputs per node, deterministic for the given seed.
+std::vector<NodeId> layered(DataFlowGraphModel &model, int size, unsigned int seed = 1);
+
+} // namespace BenchmarkGraphs
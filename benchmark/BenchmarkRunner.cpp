@@ -0,0 +1,135 @@
+#include "BenchmarkRunner.hpp"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QJsonArray>
+#include <QtCore/QSysInfo>
+#include <QtCore/QThread>
+#include <QtCore/QtGlobal>
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+
+QJsonObject BenchmarkResult::toJson() const
+{
+    QJsonObject json;
+
+    json["name"] = name;
+    json["size"] = size;
+    json["samples"] = samples;
+    json["min_ms"] = minMs;
+    json["median_ms"] = medianMs;
+    json["mean_ms"] = meanMs;
+    json["max_ms"] = maxMs;
+
+    if (!counters.isEmpty())
+        json["counters"] = counters;
+
+    return json;
+}
+
+void BenchmarkRunner::add(QString const &name,
+                          std::vector<int> const &sizes,
+                          BenchmarkFunction function)
+{
+    _entries.push_back(Entry{name, sizes, std::move(function)});
+}
+
+std::vector<BenchmarkResult> BenchmarkRunner::run(Options const &options) const
+{
+    std::vector<BenchmarkResult> results;
+
+    for (Entry const &entry : _entries) {
+        if (options.filter.isValid() && !options.filter.pattern().isEmpty()
+            && !options.filter.match(entry.name).hasMatch())
+            continue;
+
+        for (int const size : entry.sizes) {
+            if (options.maxSize > 0 && size > options.maxSize)
+                continue;
+
+            std::cerr << entry.name.toStdString() << " [" << size << "]" << std::flush;
+
+            std::vector<double> samples;
+            QJsonObject counters;
+
+            for (int r = 0; r < std::max(options.repetitions, 1); ++r) {
+                BenchmarkContext context(size);
+
+                entry.function(context);
+
+                samples.insert(samples.end(), context.samples().begin(), context.samples().end());
+
+                counters = context.counters();
+            }
+
+            if (samples.empty()) {
+                std::cerr << " - no samples" << std::endl;
+                continue;
+            }
+
+            std::vector<double> sorted = samples;
+            std::sort(sorted.begin(), sorted.end());
+
+            std::size_t const n = sorted.size();
+
+            double const median = (n % 2 == 1) ? sorted[n / 2]
+                                               : 0.5 * (sorted[n / 2 - 1] + sorted[n / 2]);
+
+            double const mean = std::accumulate(sorted.begin(), sorted.end(), 0.0)
+                                / static_cast<double>(n);
+
+            results.push_back(BenchmarkResult{entry.name,
+                                              size,
+                                              static_cast<int>(n),
+                                              sorted.front(),
+                                              median,
+                                              mean,
+                                              sorted.back(),
+                                              counters});
+
+            std::cerr << " median " << median << " ms" << std::endl;
+        }
+    }
+
+    return results;
+}
+
+std::vector<QString> BenchmarkRunner::names() const
+{
+    std::vector<QString> result;
+
+    for (Entry const &entry : _entries) {
+        result.push_back(entry.name);
+    }
+
+    return result;
+}
+
+QJsonObject BenchmarkRunner::report(std::vector<BenchmarkResult> const &results)
+{
+    QJsonObject environment;
+    environment["qt_version"] = QString(qVersion());
+    environment["cpu_architecture"] = QSysInfo::currentCpuArchitecture();
+    environment["kernel"] = QSysInfo::kernelType() + " " + QSysInfo::kernelVersion();
+    environment["product"] = QSysInfo::prettyProductName();
+    environment["ideal_thread_count"] = QThread::idealThreadCount();
+#ifdef NDEBUG
+    environment["build"] = QStringLiteral("release");
+#else
+    environment["build"] = QStringLiteral("debug");
+#endif
+
+    QJsonArray resultsJson;
+    for (BenchmarkResult const &result : results) {
+        resultsJson.append(result.toJson());
+    }
+
+    QJsonObject json;
+    json["format_version"] = 1;
+    json["date"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    json["environment"] = environment;
+    json["results"] = resultsJson;
+
+    return json;
+}
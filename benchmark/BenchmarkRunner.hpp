@@ -0,0 +1,125 @@
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonObject>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QString>
+
+#include <functional>
+#include <vector>
+
+/// Passed to every benchmark run, collects the timed samples.
+/**
+ * A benchmark function prepares its input and wraps only the measured part
+ * into `measure`. The runner calls the function `repetitions` times for
+ * every problem size, each run starts from a freshly prepared state.
+ */
+class BenchmarkContext
+{
+public:
+    explicit BenchmarkContext(int size)
+        : _size(size)
+    {}
+
+    /// Number of nodes (or other items) the benchmark should work with.
+    int size() const { return _size; }
+
+    template<typename F>
+    void measure(F &&body)
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        body();
+
+        _samples.push_back(static_cast<double>(timer.nsecsElapsed()) / 1.0e6);
+    }
+
+    /// Extra value reported with the result, e.g. a checksum or an item count.
+    void setCounter(QString const &name, double value) { _counters[name] = value; }
+
+    std::vector<double> const &samples() const { return _samples; }
+
+    QJsonObject const &counters() const { return _counters; }
+
+private:
+    int _size;
+
+    std::vector<double> _samples;
+
+    QJsonObject _counters;
+};
+
+struct BenchmarkResult
+{
+    QString name;
+
+    int size;
+
+    int samples;
+
+    double minMs;
+
+    double medianMs;
+
+    double meanMs;
+
+    double maxMs;
+
+    QJsonObject counters;
+
+    QJsonObject toJson() const;
+};
+
+class BenchmarkRunner
+{
+public:
+    using BenchmarkFunction = std::function<void(BenchmarkContext &)>;
+
+    struct Options
+    {
+        int repetitions = 5;
+
+        /// Sizes above this value are skipped; 0 means no limit.
+        int maxSize = 0;
+
+        /// Only the benchmarks with matching names are run.
+        QRegularExpression filter;
+    };
+
+public:
+    void add(QString const &name, std::vector<int> const &sizes, BenchmarkFunction function);
+
+    /// Runs the selected benchmarks, the progress is printed to stderr.
+    std::vector<BenchmarkResult> run(Options const &options) const;
+
+    /// Names of all the registered benchmarks.
+    std::vector<QString> names() const;
+
+    /// Machine-readable report: environment description and the results.
+    static QJsonObject report(std::vector<BenchmarkResult> const &results);
+
+private:
+    struct Entry
+    {
+        QString name;
+
+        std::vector<int> sizes;
+
+        BenchmarkFunction function;
+    };
+
+    std::vector<Entry> _entries;
+};
+
+void registerGraphModelBenchmarks(BenchmarkRunner &runner);
+
+void registerPropagationBenchmarks(BenchmarkRunner &runner);
+
+void registerSerializationBenchmarks(BenchmarkRunner &runner);
+
+void registerUndoBenchmarks(BenchmarkRunner &runner);
+
+void registerSceneBenchmarks(BenchmarkRunner &runner);
+
+void registerHashBenchmarks(BenchmarkRunner &runner);
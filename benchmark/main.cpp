@@ -0,0 +1,89 @@
+#include "BenchmarkRunner.hpp"
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtWidgets/QApplication>
+
+#include <iostream>
+
+int main(int argc, char *argv[])
+{
+    // The scene benchmarks never show a window.
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication app(argc, argv);
+    app.setAttribute(Qt::AA_Use96Dpi, true);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("QtNodes benchmarks, results are written as json.");
+    parser.addHelpOption();
+
+    QCommandLineOption outputOption({"o", "output"},
+                                    "Write the json report to <file> instead of stdout.",
+                                    "file");
+    QCommandLineOption filterOption({"f", "filter"},
+                                    "Run only the benchmarks matching <regex>.",
+                                    "regex");
+    QCommandLineOption repetitionsOption({"r", "repetitions"},
+                                         "Number of runs per benchmark and size (default 5).",
+                                         "n",
+                                         "5");
+    QCommandLineOption maxSizeOption({"s", "max-size"},
+                                     "Skip the problem sizes above <n>.",
+                                     "n",
+                                     "0");
+    QCommandLineOption listOption({"l", "list"}, "List the benchmarks and exit.");
+
+    parser.addOption(outputOption);
+    parser.addOption(filterOption);
+    parser.addOption(repetitionsOption);
+    parser.addOption(maxSizeOption);
+    parser.addOption(listOption);
+
+    parser.process(app);
+
+    BenchmarkRunner runner;
+
+    registerGraphModelBenchmarks(runner);
+    registerPropagationBenchmarks(runner);
+    registerSerializationBenchmarks(runner);
+    registerUndoBenchmarks(runner);
+    registerSceneBenchmarks(runner);
+    registerHashBenchmarks(runner);
+
+    if (parser.isSet(listOption)) {
+        for (QString const &name : runner.names()) {
+            std::cout << name.toStdString() << std::endl;
+        }
+        return 0;
+    }
+
+    BenchmarkRunner::Options options;
+    options.repetitions = parser.value(repetitionsOption).toInt();
+    options.maxSize = parser.value(maxSizeOption).toInt();
+    options.filter = QRegularExpression(parser.value(filterOption));
+
+    if (!options.filter.isValid()) {
+        std::cerr << "Invalid filter: " << options.filter.errorString().toStdString() << std::endl;
+        return 1;
+    }
+
+    QByteArray const report = QJsonDocument(BenchmarkRunner::report(runner.run(options))).toJson();
+
+    if (parser.isSet(outputOption)) {
+        QFile file(parser.value(outputOption));
+
+        if (!file.open(QIODevice::WriteOnly)) {
+            std::cerr << "Cannot write " << file.fileName().toStdString() << std::endl;
+            return 1;
+        }
+
+        file.write(report);
+    } else {
+        std::cout << report.constData();
+    }
+
+    return 0;
+}
@@ -1,11 +1,6 @@
 #pragma once
 
-#include <QtCore/QJsonObject>
-#include <QtCore/QPointF>
-#include <QtCore/QSize>
-
-#include <QtNodes/AbstractGraphModel>
-#include <QtNodes/StyleCollection>
+#include <QtNodes/StoredGraphModel>
 
 using ConnectionId = QtNodes::ConnectionId;
 using ConnectionPolicy = QtNodes::ConnectionPolicy;
@@ -15,52 +10,27 @@ using NodeRole = QtNodes::NodeRole;
 using PortIndex = QtNodes::PortIndex;
 using PortRole = QtNodes::PortRole;
 using PortType = QtNodes::PortType;
-using StyleCollection = QtNodes::StyleCollection;
 using QtNodes::InvalidNodeId;
 
 class PortAddRemoveWidget;
 
+/// Per-node data kept in the `GraphStore` next to the geometry and the ports.
+struct DynamicPortsNode
+{
+    PortAddRemoveWidget *widget = nullptr;
+};
+
 /**
  * The class implements a bare minimum required to demonstrate a model-based
  * graph.
+ *
+ * The ports are added and removed with `StoredGraphModel::insertPorts` and
+ * `StoredGraphModel::removePorts`, which shift the existing connections.
  */
-class DynamicPortsModel : public QtNodes::AbstractGraphModel
+class DynamicPortsModel : public QtNodes::StoredGraphModel<DynamicPortsNode>
 {
     Q_OBJECT
 public:
-    struct NodeGeometryData
-    {
-        QSize size;
-        QPointF pos;
-    };
-
-public:
-    DynamicPortsModel();
-
-    ~DynamicPortsModel() override;
-
-    std::unordered_set<NodeId> allNodeIds() const override;
-
-    std::unordered_set<ConnectionId> allConnectionIds(NodeId const nodeId) const override;
-
-    std::unordered_set<ConnectionId> connections(NodeId nodeId,
-                                                 PortType portType,
-                                                 PortIndex portIndex) const override;
-
-    bool connectionExists(ConnectionId const connectionId) const override;
-
-    NodeId addNode(QString const nodeType = QString()) override;
-
-    /**
-   * Connection is possible when graph contains no connectivity data
-   * in both directions `Out -> In` and `In -> Out`.
-   */
-    bool connectionPossible(ConnectionId const connectionId) const override;
-
-    void addConnection(ConnectionId const connectionId) override;
-
-    bool nodeExists(NodeId const nodeId) const override;
-
     QVariant nodeData(NodeId nodeId, NodeRole role) const override;
 
     bool setNodeData(NodeId nodeId, NodeRole role, QVariant value) override;
@@ -76,51 +46,6 @@ public:
                      QVariant const &value,
                      PortRole role = PortRole::Data) override;
 
-    bool deleteConnection(ConnectionId const connectionId) override;
-
-    bool deleteNode(NodeId const nodeId) override;
-
-    QJsonObject saveNode(NodeId const) const override;
-
-    QJsonObject save() const;
-
-    /// @brief Creates a new node based on the informatoin in `nodeJson`.
-    /**
-   * @param nodeJson conains a `NodeId`, node's position, internal node
-   * information.
-   */
-    void loadNode(QJsonObject const &nodeJson) override;
-
-    void load(QJsonObject const &jsonDocument);
-
-    void addPort(NodeId nodeId, PortType portType, PortIndex portIndex);
-
-    void removePort(NodeId nodeId, PortType portType, PortIndex first);
-
-    NodeId newNodeId() override { return _nextNodeId++; }
-
-private:
-    std::unordered_set<NodeId> _nodeIds;
-
-    /// [Important] This is a user defined data structure backing your model.
-    /// In your case it could be anything else representing a graph, for example, a
-    /// table. Or a collection of structs with pointers to each other. Or an
-    /// abstract syntax tree, you name it.
-    std::unordered_set<ConnectionId> _connectivity;
-
-    mutable std::unordered_map<NodeId, NodeGeometryData> _nodeGeometryData;
-
-    struct NodePortCount
-    {
-        unsigned int in = 0;
-        unsigned int out = 0;
-    };
-
-    PortAddRemoveWidget *widget(NodeId) const;
-
-    mutable std::unordered_map<NodeId, NodePortCount> _nodePortCounts;
-    mutable std::unordered_map<NodeId, PortAddRemoveWidget *> _nodeWidgets;
-
-    /// A convenience variable needed for generating unique node ids.
-    NodeId _nextNodeId;
+protected:
+    void initializeNode(NodeId const nodeId, QString const &nodeType) override;
 };
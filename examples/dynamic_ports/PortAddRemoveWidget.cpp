@@ -108,7 +108,7 @@ void PortAddRemoveWidget::onPlusClicked()
     addButtonGroupToLayout((portType == PortType::In) ? _left : _right, portIndex + 1);
 
     // Trigger changes in the model
-    _model.addPort(_nodeId, portType, portIndex + 1);
+    _model.insertPorts(_nodeId, portType, portIndex + 1);
 
     adjustSize();
 }
@@ -126,7 +126,7 @@ void PortAddRemoveWidget::onMinusClicked()
     removeButtonGroupFromLayout((portType == PortType::In) ? _left : _right, portIndex);
 
     // Trigger changes in the model
-    _model.removePort(_nodeId, portType, portIndex);
+    _model.removePorts(_nodeId, portType, portIndex);
 
     adjustSize();
 }
@@ -0,0 +1,124 @@
+#include <QtNodes/GraphGenerator>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+
+#include <iostream>
+#include <stdexcept>
+
+using QtNodes::GeneratedGraph;
+using QtNodes::GraphGenerator;
+using QtNodes::GraphGeneratorOptions;
+
+/**
+ * Writes a synthetic scene which could be opened by the `calculator` example:
+ *
+ *   graph_generator --nodes 10000 --topology layered --seed 42 -o big.flow
+ *
+ * The same arguments always produce the same file.
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Generates reproducible .flow scenes.");
+    parser.addHelpOption();
+
+    QCommandLineOption nodesOption({"n", "nodes"}, "Number of nodes (default 100).", "count", "100");
+    QCommandLineOption topologyOption({"t", "topology"},
+                                      "chain, tree, layered (default) or random.",
+                                      "topology",
+                                      "layered");
+    QCommandLineOption seedOption({"s", "seed"}, "Random seed (default 1).", "seed", "1");
+    QCommandLineOption branchingOption("branching", "Children per tree node (default 2).", "n", "2");
+    QCommandLineOption layerWidthOption("layer-width", "Nodes per layer, 0 for sqrt(nodes).", "n", "0");
+    QCommandLineOption fanInOption("max-fan-in", "Connected inputs per node, 0 for all.", "n", "0");
+    QCommandLineOption fanOutOption("max-fan-out", "Outgoing connections per node, 0 for no limit.", "n", "0");
+    QCommandLineOption probabilityOption("probability",
+                                         "Chance to connect an input in random topology.",
+                                         "p",
+                                         "0.8");
+    QCommandLineOption modelsOption({"m", "models"},
+                                    "calculator (default) or simple.",
+                                    "models",
+                                    "calculator");
+    QCommandLineOption outputOption({"o", "output"}, "Output file, stdout by default.", "file");
+
+    parser.addOptions({nodesOption,
+                       topologyOption,
+                       seedOption,
+                       branchingOption,
+                       layerWidthOption,
+                       fanInOption,
+                       fanOutOption,
+                       probabilityOption,
+                       modelsOption,
+                       outputOption});
+
+    parser.process(app);
+
+    GraphGeneratorOptions options;
+    options.nodeCount = parser.value(nodesOption).toUInt();
+    options.seed = parser.value(seedOption).toULongLong();
+    options.branching = parser.value(branchingOption).toUInt();
+    options.layerWidth = parser.value(layerWidthOption).toUInt();
+    options.maxFanIn = parser.value(fanInOption).toUInt();
+    options.maxFanOut = parser.value(fanOutOption).toUInt();
+    options.connectionProbability = parser.value(probabilityOption).toDouble();
+
+    QString const topology = parser.value(topologyOption);
+    if (topology == "chain") {
+        options.topology = GraphGeneratorOptions::Topology::Chain;
+    } else if (topology == "tree") {
+        options.topology = GraphGeneratorOptions::Topology::Tree;
+    } else if (topology == "layered") {
+        options.topology = GraphGeneratorOptions::Topology::Layered;
+    } else if (topology == "random") {
+        options.topology = GraphGeneratorOptions::Topology::Random;
+    } else {
+        std::cerr << "Unknown topology: " << topology.toStdString() << std::endl;
+        return 1;
+    }
+
+    QString const models = parser.value(modelsOption);
+    if (models == "calculator") {
+        options.nodeTypes = GraphGenerator::calculatorNodeTypes();
+    } else if (models == "simple") {
+        options.nodeTypes = GraphGenerator::simpleNodeTypes();
+    } else {
+        std::cerr << "Unknown models: " << models.toStdString() << std::endl;
+        return 1;
+    }
+
+    GeneratedGraph graph;
+
+    try {
+        graph = GraphGenerator::generate(options);
+    } catch (std::logic_error const &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    QByteArray const data = QJsonDocument(graph.toJson()).toJson();
+
+    if (parser.isSet(outputOption)) {
+        QFile file(parser.value(outputOption));
+
+        if (!file.open(QIODevice::WriteOnly)) {
+            std::cerr << "Cannot write " << file.fileName().toStdString() << std::endl;
+            return 1;
+        }
+
+        file.write(data);
+    } else {
+        std::cout << data.constData();
+    }
+
+    std::cerr << graph.nodes.size() << " nodes, " << graph.connections.size() << " connections"
+              << std::endl;
+
+    return 0;
+}
@@ -1,7 +1,9 @@
 #include "ImageLoaderModel.hpp"
 
+#include <QtCore/QBuffer>
 #include <QtCore/QDir>
 #include <QtCore/QEvent>
+#include <QtCore/QJsonValue>
 
 #include <QtWidgets/QFileDialog>
 
@@ -69,6 +71,48 @@ bool ImageLoaderModel::eventFilter(QObject *object, QEvent *event)
     return false;
 }
 
+QJsonObject ImageLoaderModel::save() const
+{
+    QJsonObject modelJson = NodeDelegateModel::save();
+
+    if (!_pixmap.isNull()) {
+        QByteArray bytes;
+        QBuffer buffer(&bytes);
+        buffer.open(QIODevice::WriteOnly);
+        _pixmap.save(&buffer, "PNG");
+
+        modelJson["image"] = QString::fromLatin1(bytes.toBase64());
+    }
+
+    return modelJson;
+}
+
+void ImageLoaderModel::preload(QJsonObject const &p)
+{
+    // QImage, unlike QPixmap, could be safely used outside the GUI thread.
+    QJsonValue v = p["image"];
+
+    if (!v.isUndefined()) {
+        _preloadedImage.loadFromData(QByteArray::fromBase64(v.toString().toLatin1()), "PNG");
+    }
+}
+
+void ImageLoaderModel::load(QJsonObject const &p)
+{
+    if (_preloadedImage.isNull())
+        preload(p);
+
+    if (_preloadedImage.isNull())
+        return;
+
+    _pixmap = QPixmap::fromImage(_preloadedImage);
+    _preloadedImage = QImage();
+
+    _label->setPixmap(_pixmap.scaled(_label->width(), _label->height(), Qt::KeepAspectRatio));
+
+    Q_EMIT dataUpdated(0);
+}
+
 NodeDataType ImageLoaderModel::dataType(PortType const, PortIndex const) const
 {
     return PixmapData().type();
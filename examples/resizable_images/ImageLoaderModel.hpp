@@ -3,6 +3,7 @@
 #include <iostream>
 
 #include <QtCore/QObject>
+#include <QtGui/QImage>
 #include <QtWidgets/QLabel>
 
 #include <QtNodes/NodeDelegateModel>
@@ -45,6 +46,12 @@ public:
 
     QWidget *embeddedWidget() override { return _label; }
 
+    QJsonObject save() const override;
+
+    void preload(QJsonObject const &p) override;
+
+    void load(QJsonObject const &p) override;
+
     bool resizable() const override { return true; }
 
 protected:
@@ -54,4 +61,7 @@ private:
     QLabel *_label;
 
     QPixmap _pixmap;
+
+    /// Image decoded by `preload` on a worker thread.
+    QImage _preloadedImage;
 };
@@ -34,6 +34,9 @@ int main(int argc, char *argv[])
 
     DataFlowGraphModel dataFlowGraphModel(registry);
 
+    // Embedded images are decoded on the worker threads when a scene is loaded.
+    dataFlowGraphModel.setParallelLoadEnabled(true);
+
     DataFlowGraphicsScene scene(dataFlowGraphModel);
 
     GraphicsView view(&scene);
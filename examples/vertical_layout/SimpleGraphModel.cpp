@@ -1,177 +1,26 @@
 #include "SimpleGraphModel.hpp"
 
-SimpleGraphModel::SimpleGraphModel()
-    : _nextNodeId{0}
-{}
-
-SimpleGraphModel::~SimpleGraphModel()
-{
-    //
-}
-
-std::unordered_set<NodeId> SimpleGraphModel::allNodeIds() const
-{
-    return _nodeIds;
-}
-
-std::unordered_set<ConnectionId> SimpleGraphModel::allConnectionIds(NodeId const nodeId) const
-{
-    std::unordered_set<ConnectionId> result;
-
-    std::copy_if(_connectivity.begin(),
-                 _connectivity.end(),
-                 std::inserter(result, std::end(result)),
-                 [&nodeId](ConnectionId const &cid) {
-                     return cid.inNodeId == nodeId || cid.outNodeId == nodeId;
-                 });
-
-    return result;
-}
-
-std::unordered_set<ConnectionId> SimpleGraphModel::connections(NodeId nodeId,
-                                                               PortType portType,
-                                                               PortIndex portIndex) const
-{
-    std::unordered_set<ConnectionId> result;
-
-    std::copy_if(_connectivity.begin(),
-                 _connectivity.end(),
-                 std::inserter(result, std::end(result)),
-                 [&portType, &portIndex, &nodeId](ConnectionId const &cid) {
-                     return (getNodeId(portType, cid) == nodeId
-                             && getPortIndex(portType, cid) == portIndex);
-                 });
-
-    return result;
-}
-
-bool SimpleGraphModel::connectionExists(ConnectionId const connectionId) const
-{
-    return (_connectivity.find(connectionId) != _connectivity.end());
-}
-
-NodeId SimpleGraphModel::addNode(QString const nodeType)
-{
-    NodeId newId = _nextNodeId++;
-    // Create new node.
-    _nodeIds.insert(newId);
-
-    Q_EMIT nodeCreated(newId);
-
-    return newId;
-}
-
-bool SimpleGraphModel::connectionPossible(ConnectionId const connectionId) const
-{
-    return _connectivity.find(connectionId) == _connectivity.end();
-}
-
-void SimpleGraphModel::addConnection(ConnectionId const connectionId)
-{
-    _connectivity.insert(connectionId);
-
-    Q_EMIT connectionCreated(connectionId);
-}
-
-bool SimpleGraphModel::nodeExists(NodeId const nodeId) const
-{
-    return (_nodeIds.find(nodeId) != _nodeIds.end());
-}
-
 QVariant SimpleGraphModel::nodeData(NodeId nodeId, NodeRole role) const
 {
-    Q_UNUSED(nodeId);
-
-    QVariant result;
-
-    switch (role) {
-    case NodeRole::Type:
-        result = QString("Default Node Type");
-        break;
-
-    case NodeRole::Position:
-        result = _nodeGeometryData[nodeId].pos;
-        break;
-
-    case NodeRole::Size:
-        result = _nodeGeometryData[nodeId].size;
-        break;
-
-    case NodeRole::CaptionVisible:
-        result = true;
-        break;
-
-    case NodeRole::Caption:
-        result = QString("Node");
-        break;
-
-    case NodeRole::Style: {
-        auto style = StyleCollection::nodeStyle();
-        result = style.toJson().toVariantMap();
-    } break;
-
-    case NodeRole::InternalData:
-        break;
-
-    case NodeRole::InPortCount:
-        result = 5u;
-        break;
-
-    case NodeRole::OutPortCount:
-        result = 3u;
-        break;
-
-    case NodeRole::Widget:
-        result = QVariant();
-        break;
-    }
-
-    return result;
-}
-
-bool SimpleGraphModel::setNodeData(NodeId nodeId, NodeRole role, QVariant value)
-{
-    bool result = false;
+    if (!nodeExists(nodeId))
+        return QVariant();
 
     switch (role) {
     case NodeRole::Type:
-        break;
-    case NodeRole::Position: {
-        _nodeGeometryData[nodeId].pos = value.value<QPointF>();
-
-        Q_EMIT nodePositionUpdated(nodeId);
-
-        result = true;
-    } break;
-
-    case NodeRole::Size: {
-        _nodeGeometryData[nodeId].size = value.value<QSize>();
-        result = true;
-    } break;
+        return QString("Default Node Type");
 
     case NodeRole::CaptionVisible:
-        break;
+        return true;
 
     case NodeRole::Caption:
-        break;
+        return QString("Node");
 
-    case NodeRole::Style:
-        break;
-
-    case NodeRole::InternalData:
-        break;
-
-    case NodeRole::InPortCount:
-        break;
-
-    case NodeRole::OutPortCount:
-        break;
-
-    case NodeRole::Widget:
+    default:
         break;
     }
 
-    return result;
+    // Position, size, style and port counts.
+    return StoredGraphModel::nodeData(nodeId, role);
 }
 
 QVariant SimpleGraphModel::portData(NodeId nodeId,
@@ -179,6 +28,9 @@ QVariant SimpleGraphModel::portData(NodeId nodeId,
                                     PortIndex portIndex,
                                     PortRole role) const
 {
+    Q_UNUSED(nodeId);
+    Q_UNUSED(portIndex);
+
     switch (role) {
     case PortRole::Data:
         return QVariant();
@@ -188,6 +40,10 @@ QVariant SimpleGraphModel::portData(NodeId nodeId,
         return QVariant();
         break;
 
+    case PortRole::DataTypeId:
+        return QVariant();
+        break;
+
     case PortRole::ConnectionPolicyRole:
         return QVariant::fromValue(ConnectionPolicy::One);
         break;
@@ -220,74 +76,10 @@ bool SimpleGraphModel::setPortData(
     return false;
 }
 
-bool SimpleGraphModel::deleteConnection(ConnectionId const connectionId)
+void SimpleGraphModel::initializeNode(NodeId const nodeId, QString const &nodeType)
 {
-    bool disconnected = false;
+    Q_UNUSED(nodeType);
 
-    auto it = _connectivity.find(connectionId);
-
-    if (it != _connectivity.end()) {
-        disconnected = true;
-
-        _connectivity.erase(it);
-    }
-
-    if (disconnected)
-        Q_EMIT connectionDeleted(connectionId);
-
-    return disconnected;
-}
-
-bool SimpleGraphModel::deleteNode(NodeId const nodeId)
-{
-    // Delete connections to this node first.
-    auto connectionIds = allConnectionIds(nodeId);
-    for (auto &cId : connectionIds) {
-        deleteConnection(cId);
-    }
-
-    _nodeIds.erase(nodeId);
-    _nodeGeometryData.erase(nodeId);
-
-    Q_EMIT nodeDeleted(nodeId);
-
-    return true;
-}
-
-QJsonObject SimpleGraphModel::saveNode(NodeId const nodeId) const
-{
-    QJsonObject nodeJson;
-
-    nodeJson["id"] = static_cast<qint64>(nodeId);
-
-    {
-        QPointF const pos = nodeData(nodeId, NodeRole::Position).value<QPointF>();
-
-        QJsonObject posJson;
-        posJson["x"] = pos.x();
-        posJson["y"] = pos.y();
-        nodeJson["position"] = posJson;
-    }
-
-    return nodeJson;
-}
-
-void SimpleGraphModel::loadNode(QJsonObject const &nodeJson)
-{
-    NodeId restoredNodeId = nodeJson["id"].toInt();
-
-    // Next NodeId must be larger that any id existing in the graph
-    _nextNodeId = std::max(restoredNodeId + 1, _nextNodeId);
-
-    // Create new node.
-    _nodeIds.insert(restoredNodeId);
-
-    Q_EMIT nodeCreated(restoredNodeId);
-
-    {
-        QJsonObject posJson = nodeJson["position"].toObject();
-        QPointF const pos(posJson["x"].toDouble(), posJson["y"].toDouble());
-
-        setNodeData(restoredNodeId, NodeRole::Position, pos);
-    }
+    store().setPortCount(nodeId, PortType::In, 5u);
+    store().setPortCount(nodeId, PortType::Out, 3u);
 }
@@ -7,10 +7,16 @@
 
 #include <QtCore/QJsonObject>
 #include <QtCore/QObject>
+#include <QtCore/QPointF>
+#include <QtCore/QSize>
 #include <QtCore/QVariant>
 
+#include <memory>
+#include <vector>
+
 #include "ConnectionIdHash.hpp"
 #include "Definitions.hpp"
+#include "NodeData.hpp"
 
 namespace QtNodes {
 
@@ -29,8 +35,16 @@ class NODE_EDITOR_PUBLIC AbstractGraphModel : public QObject
     Q_OBJECT
 public:
     /// Generates a new unique NodeId.
+    /**
+   * A model may reserve the id until a node is created under it with
+   * `loadNode` or `addSubgraph`; `DataFlowGraphModel` and `StoredGraphModel`
+   * do. Hand an id no node was created under back with `releaseNodeId`.
+   */
     virtual NodeId newNodeId() = 0;
 
+    /// Gives back an unused id obtained from `newNodeId`.
+    virtual void releaseNodeId(NodeId const nodeId) { Q_UNUSED(nodeId); }
+
     /// @brief Returns the full set of unique Node Ids.
     /**
    * Model creator is responsible for generating unique `unsigned int`
@@ -154,6 +168,47 @@ public:
 
     virtual bool deleteNode(NodeId const nodeId) = 0;
 
+    /// `NodeRole::Position`.
+    /**
+   * This and the following typed accessors are queried on every paint and
+   * propagation. The default implementations unwrap `nodeData`/`portData`;
+   * models storing the values natively can override them and avoid the
+   * `QVariant` boxing.
+   */
+    virtual QPointF nodePosition(NodeId nodeId) const;
+
+    /// `NodeRole::Size`.
+    virtual QSize nodeSize(NodeId nodeId) const;
+
+    /// `NodeRole::InPortCount` or `NodeRole::OutPortCount`.
+    virtual PortCount portCount(NodeId nodeId, PortType portType) const;
+
+    /// `PortRole::DataType`.
+    virtual NodeDataType portDataType(NodeId nodeId, PortType portType, PortIndex index) const;
+
+    /// `PortRole::DataTypeId`, falls back to interning `portDataType().id`.
+    virtual NodeDataTypeId portDataTypeId(NodeId nodeId, PortType portType, PortIndex index) const;
+
+    /// `PortRole::Data` of an out-port.
+    virtual std::shared_ptr<NodeData> outPortData(NodeId nodeId, PortIndex index) const;
+
+    /// Deletes the nodes together with all their connections.
+    /**
+   * This, `addSubgraph` and `clear` edit the model by sets for the scene, the
+   * undo commands and the clipboard. The default implementations fall back to
+   * the per-item functions; models can override them to skip the work on
+   * items that are about to disappear. Overrides must emit
+   * `nodesAboutToBeDeleted` and `nodesDeleted` around the deletion.
+   */
+    virtual void deleteNodes(std::vector<NodeId> const &nodeIds);
+
+    /// Restores the nodes produced by `saveNode` and adds the connections.
+    virtual void addSubgraph(std::vector<QJsonObject> const &nodesJson,
+                             std::vector<ConnectionId> const &connectionIds);
+
+    /// Deletes all the nodes and connections.
+    virtual void clear();
+
     /**
    * Reimplement the function if you want to store/restore the node's
    * inner state during undo/redo node deletion operations.
@@ -234,6 +289,16 @@ Q_SIGNALS:
 
     void nodeDeleted(NodeId const nodeId);
 
+    /// Emitted by `deleteNodes` before the first of the existing `nodeIds` is deleted.
+    void nodesAboutToBeDeleted(std::vector<NodeId> const &nodeIds);
+
+    /// Emitted by `deleteNodes` once the nodes and their connections are gone.
+    /**
+   * `nodeDeleted` and `connectionDeleted` are still emitted for every item in
+   * between, listeners handling the pair can skip them.
+   */
+    void nodesDeleted(std::vector<NodeId> const &nodeIds);
+
     void nodeUpdated(NodeId const nodeId);
 
     void nodeFlagsUpdated(NodeId const nodeId);
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <QPainter>
+
+#include "Export.hpp"
+
+class QPainter;
+
+namespace QtNodes {
+
+class GraphicsView;
+
+/// Class enables painting on top of the scene in the view's coordinates.
+/**
+ * Overlays are registered with `GraphicsView::addOverlayPainter` and are
+ * painted from `GraphicsView::drawForeground`; they do not move or scale
+ * together with the scene (legends, statistics, etc).
+ */
+class NODE_EDITOR_PUBLIC AbstractOverlayPainter
+{
+public:
+    virtual ~AbstractOverlayPainter() = default;
+
+    /**
+   * The painter's transformation is reset: (0, 0) is the top left corner of
+   * `view.viewport()`.
+   */
+    virtual void paint(QPainter *painter, GraphicsView const &view) const = 0;
+};
+} // namespace QtNodes
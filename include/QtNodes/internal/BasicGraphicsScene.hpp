@@ -14,8 +14,11 @@
 #include "ConnectionIdHash.hpp"
 #include "Definitions.hpp"
 #include "Export.hpp"
+#include "FlatHash.hpp"
+#include "PortGrid.hpp"
 
 #include "QUuidStdHash.hpp"
+#include "UndoCommands.hpp"
 
 class QUndoStack;
 
@@ -25,6 +28,7 @@ class AbstractConnectionPainter;
 class AbstractGraphModel;
 class AbstractNodePainter;
 class ConnectionGraphicsObject;
+class GraphProfiler;
 class NodeGraphicsObject;
 class NodeStyle;
 
@@ -58,6 +62,22 @@ public:
 
     QUndoStack &undoStack();
 
+    /// Receives the timings of the scene reactions and of the painting.
+    /**
+   * `nullptr` (the default) disables the scene instrumentation.
+   */
+    void setProfiler(GraphProfiler *profiler) { _profiler = profiler; }
+
+    GraphProfiler *profiler() const { return _profiler; }
+
+    /// Sets the limits applied after every change of the undo stack index.
+    void setUndoMemoryBudget(UndoMemoryBudget const &budget);
+
+    UndoMemoryBudget const &undoMemoryBudget() const { return _undoMemoryBudget; }
+
+    /// Memory and disk space held by the snapshot commands of the undo stack.
+    UndoMemoryStats undoMemoryStats() const;
+
 public:
     /// Creates a "draft" instance of ConnectionGraphicsObject.
     /**
@@ -78,6 +98,40 @@ public:
    */
     void resetDraftConnection();
 
+    /// `AbstractGraphModel::connectionPossible` cached while a draft connection exists.
+    /**
+   * The painters ask about every port of every node hovered by the draft on
+   * each repaint. The answers are kept until the draft connection is reset
+   * or the graph changes.
+   */
+    bool connectionPossible(ConnectionId const connectionId);
+
+    /// Ports accepting the draft connection, empty when there is no draft.
+    /**
+   * Collected once when the draft connection is made. During the drag a
+   * node update, a node created or deleted and a connection created or
+   * deleted re-index only the affected nodes' ports; `deleteNodes` collects
+   * them all again. The answers of the other nodes are kept, so a port whose
+   * answer changed because a cycle through other nodes appeared or vanished
+   * keeps its highlight until the next draft; the drop is checked anyway.
+   */
+    PortGrid const &draftTargets() const { return _draftTargets; }
+
+    /// Whether the port accepts the draft connection, used for highlighting.
+    bool isDraftTarget(NodeId const nodeId, PortType const portType, PortIndex const portIndex) const;
+
+    /// The draft target nearest to `scenePos` within the snap radius.
+    /**
+   * @returns `nullptr` when there is no draft connection or no accepting
+   * port close enough.
+   */
+    PortLocation const *snapTarget(QPointF const &scenePos) const;
+
+    /// Distance in scene units at which the draft connection snaps to a port.
+    void setSnapRadius(double const radius);
+
+    double snapRadius() const { return _draftTargets.cellSize(); }
+
     /// Deletes all the nodes. Connections are removed automatically.
     void clearScene();
 
@@ -136,9 +190,32 @@ private:
    */
     void traverseGraphAndPopulateGraphicsObjects();
 
+    /// Compresses, spills and finally evicts the undo snapshots to fit the budget.
+    void enforceUndoMemoryBudget();
+
+    /// Removes the evicted commands once nothing newer is left to undo.
+    void dropEvictedCommands();
+
     /// Redraws adjacent nodes for given `connectionId`
     void updateAttachedNodes(ConnectionId const connectionId, PortType const portType);
 
+    /// Drops the cached `connectionPossible` answers and re-collects the draft targets.
+    /**
+   * Used when the draft connection is made or reset, after `deleteNodes` and
+   * when the draft's own node changes its ports.
+   */
+    void updateDraftTargets();
+
+    /// Re-indexes the ports of a single node during the drag.
+    /**
+   * With `portsChanged` the node's cached answers are asked again, otherwise
+   * only the port positions are refreshed.
+   */
+    void updateDraftTargets(NodeId const nodeId, bool const portsChanged);
+
+    /// Adds the node's ports accepting the draft connection, @returns whether any did.
+    bool indexDraftTargets(NodeId const nodeId);
+
 public Q_SLOTS:
     /// Slot called when the `connectionId` is erased form the AbstractGraphModel.
     void onConnectionDeleted(ConnectionId const connectionId);
@@ -148,6 +225,16 @@ public Q_SLOTS:
 
     void onNodeDeleted(NodeId const nodeId);
 
+    /// Removes the graphics objects of all the nodes and their connections at once.
+    /**
+   * The `nodeDeleted` and `connectionDeleted` signals following it find
+   * nothing left to remove.
+   */
+    void onNodesAboutToBeDeleted(std::vector<NodeId> const &nodeIds);
+
+    /// Re-collects the draft targets and reports the modification once per batch.
+    void onNodesDeleted(std::vector<NodeId> const &nodeIds);
+
     void onNodeCreated(NodeId const nodeId);
 
     void onNodePositionUpdated(NodeId const nodeId);
@@ -165,12 +252,19 @@ private:
 
     using UniqueConnectionGraphicsObject = std::unique_ptr<ConnectionGraphicsObject>;
 
-    std::unordered_map<NodeId, UniqueNodeGraphicsObject> _nodeGraphicsObjects;
+    /// The graphics objects are created before being inserted, the flat maps
+    /// move their values on every insertion.
+    FlatHashMap<NodeId, UniqueNodeGraphicsObject> _nodeGraphicsObjects;
 
-    std::unordered_map<ConnectionId, UniqueConnectionGraphicsObject> _connectionGraphicsObjects;
+    FlatHashMap<ConnectionId, UniqueConnectionGraphicsObject> _connectionGraphicsObjects;
 
     std::unique_ptr<ConnectionGraphicsObject> _draftConnection;
 
+    FlatHashMap<ConnectionId, bool> _connectionPossibleCache;
+
+    /// The cell size is the snap radius.
+    PortGrid _draftTargets;
+
     std::unique_ptr<AbstractNodeGeometry> _nodeGeometry;
 
     std::unique_ptr<AbstractNodePainter> _nodePainter;
@@ -181,6 +275,12 @@ private:
 
     QUndoStack *_undoStack;
 
+    bool _droppingEvictedCommands;
+
+    UndoMemoryBudget _undoMemoryBudget;
+
+    GraphProfiler *_profiler;
+
     Qt::Orientation _orientation;
 };
 
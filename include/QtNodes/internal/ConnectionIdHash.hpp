@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
 
 #include "Definitions.hpp"
@@ -17,15 +18,34 @@ inline void hash_combine(std::size_t &seed, const T &v, Rest... rest)
     hash_combine(seed, rest...);
 }
 
+namespace QtNodes {
+
+/// MurmurHash3 64-bit finalizer.
+inline std::uint64_t mixHash64(std::uint64_t x)
+{
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    x ^= x >> 33;
+    return x;
+}
+
+} // namespace QtNodes
+
 namespace std {
 template<>
 struct hash<QtNodes::ConnectionId>
 {
+    /// The id is packed into two 64-bit words and mixed with the MurmurHash3
+    /// finalizer; all the bits of the four fields affect every bit of the hash.
     inline std::size_t operator()(QtNodes::ConnectionId const &id) const
     {
-        std::size_t h = 0;
-        hash_combine(h, id.outNodeId, id.outPortIndex, id.inNodeId, id.inPortIndex);
-        return h;
+        std::uint64_t const out = (static_cast<std::uint64_t>(id.outNodeId) << 32)
+                                  | id.outPortIndex;
+        std::uint64_t const in = (static_cast<std::uint64_t>(id.inNodeId) << 32) | id.inPortIndex;
+
+        return static_cast<std::size_t>(QtNodes::mixHash64(out ^ QtNodes::mixHash64(in)));
     }
 };
 
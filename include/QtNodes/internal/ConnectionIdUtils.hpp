@@ -126,6 +126,15 @@ inline std::ostream &operator<<(std::ostream &ostr, ConnectionId const connectio
     return ostr;
 }
 
+/// Reads a node id saved as a json number, the values above `INT_MAX` included.
+/**
+ * `InvalidNodeId` when the value is missing.
+ */
+inline NodeId nodeIdFromJson(QJsonValue const &value)
+{
+    return static_cast<NodeId>(static_cast<qint64>(value.toDouble(-1.0)));
+}
+
 inline QJsonObject toJson(ConnectionId const &connId)
 {
     QJsonObject connJson;
@@ -140,9 +149,9 @@ inline QJsonObject toJson(ConnectionId const &connId)
 
 inline ConnectionId fromJson(QJsonObject const &connJson)
 {
-    ConnectionId connId{static_cast<NodeId>(connJson["outNodeId"].toInt(InvalidNodeId)),
+    ConnectionId connId{nodeIdFromJson(connJson["outNodeId"]),
                         static_cast<PortIndex>(connJson["outPortIndex"].toInt(InvalidPortIndex)),
-                        static_cast<NodeId>(connJson["intNodeId"].toInt(InvalidNodeId)),
+                        nodeIdFromJson(connJson["intNodeId"]),
                         static_cast<PortIndex>(connJson["inPortIndex"].toInt(InvalidPortIndex))};
 
     return connId;
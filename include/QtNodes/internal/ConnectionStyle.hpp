@@ -3,8 +3,15 @@
 #include <QtGui/QColor>
 
 #include "Export.hpp"
+#include "NodeData.hpp"
+#include "QStringStdHash.hpp"
 #include "Style.hpp"
 
+#include <QtCore/QStringList>
+
+#include <unordered_map>
+#include <vector>
+
 namespace QtNodes {
 
 class NODE_EDITOR_PUBLIC ConnectionStyle : public Style
@@ -27,7 +34,15 @@ public:
 public:
     QColor constructionColor() const;
     QColor normalColor() const;
+    /// Color of the data type, used when `useDataDefinedColors()` is on.
+    /**
+   * Registered colors (`setDataTypeColor`, `setDataTypePalette` or the
+   * "DataTypeColors" object of the style JSON) are used first, the other
+   * types get a color derived from the hash of the id. Every color is
+   * computed once and cached.
+   */
     QColor normalColor(QString typeId) const;
+    QColor normalColor(NodeDataTypeId typeId) const;
     QColor selectedColor() const;
     QColor selectedHaloColor() const;
     QColor hoveredColor() const;
@@ -38,6 +53,26 @@ public:
 
     bool useDataDefinedColors() const;
 
+public:
+    void setDataTypeColor(QString const &typeId, QColor const &color);
+
+    /// Registers evenly distributed hues for the known data types.
+    /**
+   * Unlike the hash derived colors the palette never gives two of the listed
+   * types similar colors. Explicitly registered colors are kept.
+   */
+    void setDataTypePalette(QStringList const &typeIds);
+
+    /// Explicitly registered colors, saved under "DataTypeColors".
+    std::unordered_map<QString, QColor> const &dataTypeColors() const
+    {
+        return _registeredDataTypeColors;
+    }
+
+private:
+    /// Deterministic color for the types without a registered one.
+    static QColor generatedColor(QString const &typeId);
+
 private:
     QColor ConstructionColor;
     QColor NormalColor;
@@ -50,5 +85,13 @@ private:
     float PointDiameter;
 
     bool UseDataDefinedColors;
+
+    std::unordered_map<QString, QColor> _registeredDataTypeColors;
+
+    /// Assigned by `setDataTypePalette`, not saved.
+    std::unordered_map<QString, QColor> _paletteDataTypeColors;
+
+    /// Indexed by `NodeDataTypeId`, invalid colors are not computed yet.
+    mutable std::vector<QColor> _dataTypeColors;
 };
 } // namespace QtNodes
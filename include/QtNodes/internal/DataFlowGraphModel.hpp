@@ -2,12 +2,18 @@
 
 #include "AbstractGraphModel.hpp"
 #include "ConnectionIdUtils.hpp"
+#include "FlatHash.hpp"
+#include "GraphProfiler.hpp"
+#include "GraphSnapshot.hpp"
 #include "NodeDelegateModelRegistry.hpp"
+#include "NodeSlots.hpp"
 #include "Serializable.hpp"
 #include "StyleCollection.hpp"
+#include "TopologicalOrder.hpp"
 
 #include "Export.hpp"
 
+#include <QJsonArray>
 #include <QJsonObject>
 
 #include <memory>
@@ -18,13 +24,6 @@ class NODE_EDITOR_PUBLIC DataFlowGraphModel : public AbstractGraphModel, public
 {
     Q_OBJECT
 
-public:
-    struct NodeGeometryData
-    {
-        QSize size;
-        QPointF pos;
-    };
-
 public:
     DataFlowGraphModel(std::shared_ptr<NodeDelegateModelRegistry> registry);
 
@@ -43,6 +42,9 @@ public:
 
     NodeId addNode(QString const nodeType) override;
 
+    /// Skips the name lookup, see `NodeDelegateModelRegistry::modelTypeId`.
+    NodeId addNode(ModelTypeId const modelTypeId);
+
     bool connectionPossible(ConnectionId const connectionId) const override;
 
     void addConnection(ConnectionId const connectionId) override;
@@ -66,10 +68,44 @@ public:
                      QVariant const &value,
                      PortRole role = PortRole::Data) override;
 
+    /// Reads the node state directly, bypassing `nodeData`.
+    /**
+   * The typed accessors below bypass `nodeData` and `portData` likewise. A
+   * derived model answering one of these roles differently in `nodeData` or
+   * `portData` has to override the matching accessor as well.
+   */
+    QPointF nodePosition(NodeId nodeId) const override;
+
+    QSize nodeSize(NodeId nodeId) const override;
+
+    PortCount portCount(NodeId nodeId, PortType portType) const override;
+
+    NodeDataType portDataType(NodeId nodeId, PortType portType, PortIndex index) const override;
+
+    NodeDataTypeId portDataTypeId(NodeId nodeId,
+                                  PortType portType,
+                                  PortIndex index) const override;
+
+    std::shared_ptr<NodeData> outPortData(NodeId nodeId, PortIndex index) const override;
+
     bool deleteConnection(ConnectionId const connectionId) override;
 
     bool deleteNode(NodeId const nodeId) override;
 
+    /// Visits only the connections attached to the deleted nodes.
+    /**
+   * Nodes outside of the set losing an input are notified once all the
+   * nodes are deleted; no data is propagated into the deleted nodes.
+   */
+    void deleteNodes(std::vector<NodeId> const &nodeIds) override;
+
+    /// Delivers the data along the new connections in one topological pass.
+    void addSubgraph(std::vector<QJsonObject> const &nodesJson,
+                     std::vector<ConnectionId> const &connectionIds) override;
+
+    /// Releases all the nodes without any propagation and emits `modelReset`.
+    void clear() override;
+
     QJsonObject saveNode(NodeId const) const override;
 
     QJsonObject save() const override;
@@ -78,6 +114,55 @@ public:
 
     void load(QJsonObject const &json) override;
 
+    /// Decodes the nodes' `internal-data` on worker threads during `load`.
+    /**
+   * When enabled, `load` first instantiates all the delegate models, then
+   * calls `NodeDelegateModel::preload` for each of them on a pool of worker
+   * threads and finally installs the nodes and connections on the owning
+   * thread in one pass.
+   */
+    void setParallelLoadEnabled(bool enabled) { _parallelLoadEnabled = enabled; }
+
+    bool parallelLoadEnabled() const { return _parallelLoadEnabled; }
+
+    /// Per-node timings of `setInData` and of the data propagation.
+    /**
+   * The profiler is disabled by default, see `GraphProfiler::setEnabled`.
+   * `DataFlowGraphicsScene` reports its own timings into the same instance.
+   */
+    GraphProfiler &profiler() { return _profiler; }
+
+    GraphProfiler const &profiler() const { return _profiler; }
+
+    /// Node ids sorted so that every node goes after all its upstream nodes.
+    /**
+   * The order is maintained incrementally while the connections change, see
+   * `TopologicalOrder`. Connections closing a cycle are refused by
+   * `connectionPossible` and `addConnection` throws `std::logic_error` for
+   * them; `load` skips them with a warning.
+   */
+    std::vector<NodeId> topologicalOrder() const;
+
+    /// Publishes a `GraphSnapshot` after every batch of edits, off by default.
+    /**
+   * The edits mark the affected chunks of the snapshot; the new snapshot is
+   * published once the control returns to the event loop, so a whole batch
+   * of edits results in one snapshot. Enabling publishes the first one
+   * immediately.
+   */
+    void setSnapshotsEnabled(bool enabled);
+
+    bool snapshotsEnabled() const { return _snapshotsEnabled; }
+
+    /// The last published snapshot, may be called from any thread.
+    /**
+   * Never `nullptr`; before the first publication the snapshot is empty.
+   */
+    std::shared_ptr<GraphSnapshot const> snapshot() const;
+
+    /// Publishes the pending changes right away, on the model's thread only.
+    void publishSnapshot();
+
     /**
    * Fetches the NodeDelegateModel for the given `nodeId` and tries to cast the
    * stored pointer to the given type
@@ -85,25 +170,58 @@ public:
     template<typename NodeDelegateModelType>
     NodeDelegateModelType *delegateModel(NodeId const nodeId)
     {
-        auto it = _models.find(nodeId);
-        if (it == _models.end())
-            return nullptr;
-
-        auto model = dynamic_cast<NodeDelegateModelType *>(it->second.get());
-
-        return model;
+        return dynamic_cast<NodeDelegateModelType *>(_nodes.model(nodeId));
     }
 
 Q_SIGNALS:
     void inPortDataWasSet(NodeId const, PortType const, PortIndex const);
 
+    void snapshotPublished(quint64 version);
+
 private:
-    NodeId newNodeId() override { return _nextNodeId++; }
+    /// Reserves a slot, the id stays unique until the node is installed.
+    NodeId newNodeId() override { return _nodes.reserve(); }
+
+    void releaseNodeId(NodeId const nodeId) override { _nodes.unreserve(nodeId); }
 
     void sendConnectionCreation(ConnectionId const connectionId);
 
     void sendConnectionDeletion(ConnectionId const connectionId);
 
+    /// Connects the delegate's signals and takes the ownership over the model.
+    void installModel(NodeId const nodeId, std::unique_ptr<NodeDelegateModel> model);
+
+    void loadNodesInParallel(QJsonArray const &nodesJsonArray);
+
+    /// Delivers the data along the given connections once.
+    /**
+   * The receiving nodes are visited in the topological order, the nested
+   * propagation triggered by `NodeDelegateModel::dataUpdated` is suppressed
+   * during the pass. Used after all the connections of a loaded scene or of
+   * an inserted subgraph are wired.
+   *
+   * @returns The receiving nodes in the visiting order.
+   */
+    std::vector<NodeId> propagateInTopologicalOrder(std::vector<ConnectionId> const &connectionIds);
+
+    /// Records the connection.
+    /**
+   * Throws `std::logic_error` if it closes a cycle or one of its nodes does
+   * not exist.
+   */
+    void insertConnection(ConnectionId const connectionId);
+
+    /// Forgets the connection without any notification.
+    bool eraseConnection(ConnectionId const connectionId);
+
+    /// Releases the model of a node without connections and emits `nodeDeleted`.
+    void removeNode(NodeId const nodeId);
+
+    /// `InvalidNodeId` marks the whole snapshot.
+    void markSnapshotDirty(NodeId const nodeId);
+
+    std::shared_ptr<GraphSnapshot::Chunk const> buildSnapshotChunk(std::size_t const chunkIndex) const;
+
 private Q_SLOTS:
     /**
    * Fuction is called in three cases:
@@ -120,16 +238,38 @@ private Q_SLOTS:
     /// Function is called after detaching a connection.
     void propagateEmptyDataTo(NodeId const nodeId, PortIndex const portIndex);
 
+private:
+    /// `setPortData` for `PortRole::Data` without the `QVariant` round trip.
+    void setInPortData(NodeId const nodeId,
+                       PortIndex const portIndex,
+                       std::shared_ptr<NodeData> const &data);
+
 private:
     std::shared_ptr<NodeDelegateModelRegistry> _registry;
 
-    NodeId _nextNodeId;
+    /// Delegate models, positions and sizes addressed by generational ids.
+    NodeSlots _nodes;
+
+    FlatHashSet<ConnectionId> _connectivity;
+
+    TopologicalOrder _topology;
+
+    bool _parallelLoadEnabled;
+
+    bool _propagationSuppressed;
+
+    GraphProfiler _profiler;
+
+    /// Accessed atomically, see `snapshot`.
+    std::shared_ptr<GraphSnapshot const> _snapshot;
+
+    FlatHashSet<std::size_t> _dirtySnapshotChunks;
 
-    std::unordered_map<NodeId, std::unique_ptr<NodeDelegateModel>> _models;
+    bool _snapshotsEnabled;
 
-    std::unordered_set<ConnectionId> _connectivity;
+    bool _snapshotScheduled;
 
-    mutable std::unordered_map<NodeId, NodeGeometryData> _nodeGeometryData;
+    bool _snapshotAllDirty;
 };
 
 } // namespace QtNodes
@@ -57,6 +57,7 @@ enum class PortRole {
     ConnectionPolicyRole = 2, ///< `enum` ConnectionPolicyRole
     CaptionVisible = 3,       ///< `bool` for caption visibility.
     Caption = 4,              ///< `QString` for port caption.
+    DataTypeId = 5,           ///< `NodeDataTypeId`, the interned `NodeDataType::id`.
 };
 Q_ENUM_NS(PortRole)
 
@@ -92,6 +93,11 @@ using NodeId = unsigned int;
 
 static constexpr NodeId InvalidNodeId = std::numeric_limits<NodeId>::max();
 
+/// Interned id of a registered model type, see `NodeDelegateModelRegistry`.
+using ModelTypeId = unsigned int;
+
+static constexpr ModelTypeId InvalidModelTypeId = std::numeric_limits<ModelTypeId>::max();
+
 /**
  * A unique connection identificator that stores
  * out `NodeId`, out `PortIndex`, in `NodeId`, in `PortIndex`
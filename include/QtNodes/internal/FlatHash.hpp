@@ -0,0 +1,371 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace QtNodes {
+
+namespace detail {
+
+/// Open addressing table with linear probing and backward shift deletion.
+/**
+ * The values are stored inline in one array, a lookup usually touches a
+ * single cache line. The hash is spread over the table with a Fibonacci
+ * multiplication, so weak hashes (the identity `std::hash<unsigned>`) do not
+ * cluster.
+ *
+ * Unlike the node-based standard containers, any insertion or erasure
+ * invalidates the iterators and the references to the values. An erased or
+ * cleared value is destroyed only after the table is consistent again, so
+ * its destructor may safely look up the same table.
+ */
+template<typename Value, typename Key, typename KeyOf, typename Hash, typename KeyEqual>
+class FlatHashTable
+{
+    static_assert(std::is_default_constructible<Value>::value,
+                  "Empty slots hold default constructed values");
+
+public:
+    template<bool Const>
+    class Iterator
+    {
+        using Table = typename std::conditional<Const, FlatHashTable const, FlatHashTable>::type;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Value;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<Const, Value const *, Value *>::type;
+        using reference = typename std::conditional<Const, Value const &, Value &>::type;
+
+        Iterator() = default;
+
+        Iterator(Table *table, std::size_t index)
+            : _table(table)
+            , _index(index)
+        {
+            skipEmpty();
+        }
+
+        /// `iterator` to `const_iterator`.
+        template<bool OtherConst, typename = typename std::enable_if<Const && !OtherConst>::type>
+        Iterator(Iterator<OtherConst> const &other)
+            : _table(other._table)
+            , _index(other._index)
+        {}
+
+        reference operator*() const { return _table->_values[_index]; }
+
+        pointer operator->() const { return &_table->_values[_index]; }
+
+        Iterator &operator++()
+        {
+            ++_index;
+            skipEmpty();
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator result = *this;
+            ++(*this);
+            return result;
+        }
+
+        bool operator==(Iterator const &other) const { return _index == other._index; }
+
+        bool operator!=(Iterator const &other) const { return _index != other._index; }
+
+    private:
+        void skipEmpty()
+        {
+            while (_index < _table->_used.size() && !_table->_used[_index])
+                ++_index;
+        }
+
+        friend class FlatHashTable;
+
+        template<bool>
+        friend class Iterator;
+
+        Table *_table = nullptr;
+
+        std::size_t _index = 0;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    using key_type = Key;
+    using value_type = Value;
+    using size_type = std::size_t;
+
+public:
+    std::size_t size() const { return _size; }
+
+    bool empty() const { return _size == 0; }
+
+    std::size_t capacity() const { return _values.size(); }
+
+    iterator begin() { return iterator(this, 0); }
+
+    iterator end() { return iterator(this, _values.size()); }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+
+    const_iterator end() const { return const_iterator(this, _values.size()); }
+
+    iterator find(Key const &key)
+    {
+        std::size_t const index = locate(key);
+        return index != NotFound ? iterator(this, index) : end();
+    }
+
+    const_iterator find(Key const &key) const
+    {
+        std::size_t const index = locate(key);
+        return index != NotFound ? const_iterator(this, index) : end();
+    }
+
+    std::size_t count(Key const &key) const { return locate(key) != NotFound ? 1 : 0; }
+
+    bool contains(Key const &key) const { return locate(key) != NotFound; }
+
+    std::pair<iterator, bool> insert(Value value)
+    {
+        auto const slot = findOrPrepare(KeyOf()(value));
+
+        if (slot.second) {
+            _values[slot.first] = std::move(value);
+            _used[slot.first] = 1;
+            ++_size;
+        }
+
+        return {iterator(this, slot.first), slot.second};
+    }
+
+    /// Invalidates all the iterators, unlike `std::unordered_map::erase`.
+    void erase(const_iterator position) { eraseAt(position._index); }
+
+    std::size_t erase(Key const &key)
+    {
+        std::size_t const index = locate(key);
+        if (index == NotFound)
+            return 0;
+
+        eraseAt(index);
+        return 1;
+    }
+
+    void clear()
+    {
+        // The values are destroyed once the table is empty.
+        std::vector<Value> values;
+        values.swap(_values);
+
+        _used.clear();
+        _size = 0;
+        _shift = 64;
+    }
+
+    /// Allocates the room for `count` values without rehashing.
+    void reserve(std::size_t count)
+    {
+        std::size_t capacity = MinCapacity;
+        while (capacity * MaxLoadNum < count * MaxLoadDen)
+            capacity *= 2;
+
+        if (capacity > _values.size())
+            rehash(capacity);
+    }
+
+protected:
+    static constexpr std::size_t NotFound = static_cast<std::size_t>(-1);
+
+    static constexpr std::size_t MinCapacity = 8;
+
+    /// The table is kept at most 7/8 full.
+    static constexpr std::size_t MaxLoadNum = 7;
+    static constexpr std::size_t MaxLoadDen = 8;
+
+    std::size_t idealIndex(Key const &key) const
+    {
+        std::uint64_t const h = static_cast<std::uint64_t>(Hash()(key));
+        return static_cast<std::size_t>((h * 0x9e3779b97f4a7c15ull) >> _shift);
+    }
+
+    std::size_t locate(Key const &key) const
+    {
+        if (_size == 0)
+            return NotFound;
+
+        std::size_t const mask = _values.size() - 1;
+
+        for (std::size_t i = idealIndex(key);; i = (i + 1) & mask) {
+            if (!_used[i])
+                return NotFound;
+
+            if (KeyEqual()(KeyOf()(_values[i]), key))
+                return i;
+        }
+    }
+
+    /// Index of the key, or of the empty slot it should go to (`second == true`).
+    std::pair<std::size_t, bool> findOrPrepare(Key const &key)
+    {
+        std::size_t const existing = locate(key);
+        if (existing != NotFound)
+            return {existing, false};
+
+        if ((_size + 1) * MaxLoadDen > _values.size() * MaxLoadNum)
+            rehash(_values.empty() ? MinCapacity : _values.size() * 2);
+
+        std::size_t const mask = _values.size() - 1;
+
+        std::size_t i = idealIndex(key);
+        while (_used[i])
+            i = (i + 1) & mask;
+
+        return {i, true};
+    }
+
+    void eraseAt(std::size_t index)
+    {
+        // Destroyed on return, once the table is consistent again.
+        Value removed = std::move(_values[index]);
+        static_cast<void>(removed);
+
+        std::size_t const mask = _values.size() - 1;
+
+        // Moves the following values of the probe chain one step back, no
+        // tombstones are left behind.
+        std::size_t hole = index;
+        for (std::size_t i = (hole + 1) & mask; _used[i]; i = (i + 1) & mask) {
+            std::size_t const ideal = idealIndex(KeyOf()(_values[i]));
+
+            // Whether `ideal` lies cyclically within (hole, i].
+            bool const reachable = hole <= i ? (hole < ideal && ideal <= i)
+                                             : (hole < ideal || ideal <= i);
+
+            if (!reachable) {
+                _values[hole] = std::move(_values[i]);
+                hole = i;
+            }
+        }
+
+        _values[hole] = Value();
+        _used[hole] = 0;
+        --_size;
+    }
+
+    void rehash(std::size_t capacity)
+    {
+        std::vector<Value> values(capacity);
+        std::vector<std::uint8_t> used(capacity, 0);
+
+        values.swap(_values);
+        used.swap(_used);
+
+        _shift = 64;
+        for (std::size_t c = capacity; c > 1; c /= 2)
+            --_shift;
+
+        std::size_t const mask = capacity - 1;
+
+        for (std::size_t j = 0; j < values.size(); ++j) {
+            if (!used[j])
+                continue;
+
+            std::size_t i = idealIndex(KeyOf()(values[j]));
+            while (_used[i])
+                i = (i + 1) & mask;
+
+            _values[i] = std::move(values[j]);
+            _used[i] = 1;
+        }
+    }
+
+protected:
+    std::vector<Value> _values;
+
+    std::vector<std::uint8_t> _used;
+
+    std::size_t _size = 0;
+
+    /// 64 - log2(capacity).
+    unsigned int _shift = 64;
+};
+
+template<typename Key, typename T>
+struct MapKeyOf
+{
+    Key const &operator()(std::pair<Key, T> const &value) const { return value.first; }
+};
+
+template<typename Key>
+struct SetKeyOf
+{
+    Key const &operator()(Key const &value) const { return value; }
+};
+
+} // namespace detail
+
+/// Cache friendly replacement of `std::unordered_map`, see `detail::FlatHashTable`.
+/**
+ * The values are `std::pair<Key, T>`; the key must not be modified through
+ * an iterator.
+ */
+template<typename Key,
+         typename T,
+         typename Hash = std::hash<Key>,
+         typename KeyEqual = std::equal_to<Key>>
+class FlatHashMap
+    : public detail::FlatHashTable<std::pair<Key, T>, Key, detail::MapKeyOf<Key, T>, Hash, KeyEqual>
+{
+public:
+    using mapped_type = T;
+
+    T &operator[](Key const &key)
+    {
+        auto const slot = this->findOrPrepare(key);
+
+        if (slot.second) {
+            this->_values[slot.first].first = key;
+            this->_used[slot.first] = 1;
+            ++this->_size;
+        }
+
+        return this->_values[slot.first].second;
+    }
+
+    T &at(Key const &key)
+    {
+        std::size_t const index = this->locate(key);
+        if (index == this->NotFound)
+            throw std::out_of_range("FlatHashMap::at");
+
+        return this->_values[index].second;
+    }
+
+    T const &at(Key const &key) const
+    {
+        std::size_t const index = this->locate(key);
+        if (index == this->NotFound)
+            throw std::out_of_range("FlatHashMap::at");
+
+        return this->_values[index].second;
+    }
+};
+
+/// Cache friendly replacement of `std::unordered_set`, see `detail::FlatHashTable`.
+template<typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class FlatHashSet
+    : public detail::FlatHashTable<Key, Key, detail::SetKeyOf<Key>, Hash, KeyEqual>
+{};
+
+} // namespace QtNodes
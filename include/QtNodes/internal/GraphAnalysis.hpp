@@ -0,0 +1,182 @@
+#pragma once
+
+#include "Definitions.hpp"
+#include "Export.hpp"
+#include "FlatHash.hpp"
+
+#include <QtCore/QObject>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace QtNodes {
+
+class AbstractGraphModel;
+
+/// Structural queries over the connections of any `AbstractGraphModel`.
+/**
+ * The analysis keeps its own adjacency lists, updated from the model's
+ * signals, and computes every result lazily on the first query. The results
+ * are cached and a change of the graph drops only the ones it can affect:
+ *
+ * - a connection agreeing with the current topological order, or staying
+ *   inside a cycle, keeps the strongly connected components;
+ * - a new connection merges the connected components in place;
+ * - the cached upstream and downstream cones are dropped only when they
+ *   contain an end of the changed connection.
+ *
+ * A connection starting and ending at the same node counts as a cycle.
+ */
+class NODE_EDITOR_PUBLIC GraphAnalysis : public QObject
+{
+    Q_OBJECT
+
+public:
+    GraphAnalysis(AbstractGraphModel &model, QObject *parent = nullptr);
+
+    AbstractGraphModel &graphModel() const { return _model; }
+
+    bool isAcyclic() const;
+
+    /// Every node goes after all its upstream nodes.
+    /**
+   * The nodes of a cycle are placed next to each other, in no particular
+   * order.
+   */
+    std::vector<NodeId> topologicalOrder() const;
+
+    /// Groups of nodes reaching each other, in the topological order.
+    std::vector<std::vector<NodeId>> stronglyConnectedComponents() const;
+
+    bool isOnCycle(NodeId const nodeId) const;
+
+    /// Nodes reaching the given node, sorted by id.
+    /**
+   * The node itself is included only when it lies on a cycle.
+   */
+    std::vector<NodeId> upstream(NodeId const nodeId) const;
+
+    /// Nodes reachable from the given node, sorted by id.
+    /**
+   * The node itself is included only when it lies on a cycle.
+   */
+    std::vector<NodeId> downstream(NodeId const nodeId) const;
+
+    /// Whether `to` belongs to the downstream cone of `from`.
+    /**
+   * Answered from the cached cones or by a search pruned with the
+   * topological order, without building a cone.
+   */
+    bool reaches(NodeId const from, NodeId const to) const;
+
+    /// Number of connections on the longest path ending at the node.
+    /**
+   * A cycle counts as a single node, all its nodes have the same depth.
+   */
+    std::size_t depth(NodeId const nodeId) const;
+
+    /// Nodes of a longest path, from its source to its end.
+    /**
+   * A cycle counts as a single node: only the nodes where the path enters
+   * and leaves it are listed.
+   */
+    std::vector<NodeId> longestPath() const;
+
+    /// Number of the connected components, the directions are ignored.
+    std::size_t componentCount() const;
+
+    /// A node identifying the connected component of `nodeId`.
+    /**
+   * The same for all the nodes of the component while the graph does not
+   * change. `InvalidNodeId` for unknown nodes.
+   */
+    NodeId component(NodeId const nodeId) const;
+
+    std::vector<std::vector<NodeId>> components() const;
+
+private Q_SLOTS:
+    void onNodeCreated(NodeId const nodeId);
+
+    void onNodeDeleted(NodeId const nodeId);
+
+    void onConnectionCreated(ConnectionId const connectionId);
+
+    void onConnectionDeleted(ConnectionId const connectionId);
+
+    void onModelReset();
+
+private:
+    struct Vertex
+    {
+        /// One entry per connection, a node may appear several times.
+        std::vector<NodeId> successors;
+
+        std::vector<NodeId> predecessors;
+    };
+
+    /// Reads the whole graph from the model after a reset.
+    void ensureVertices() const;
+
+    /// Strongly connected components and their order, Tarjan's algorithm.
+    void ensureStrongComponents() const;
+
+    void ensureDepths() const;
+
+    void ensureComponents() const;
+
+    void addVertex(NodeId const nodeId);
+
+    void addEdge(NodeId const from, NodeId const to);
+
+    void removeEdge(NodeId const from, NodeId const to);
+
+    /// Drops the cached cones containing `from` downstream or `to` upstream.
+    void dropCones(NodeId const from, NodeId const to);
+
+    std::vector<NodeId> cone(NodeId const nodeId, bool downstream) const;
+
+    NodeId findRoot(NodeId nodeId) const;
+
+private:
+    static constexpr std::size_t MaxCachedCones = 64;
+
+    AbstractGraphModel &_model;
+
+    /// Lookups do not insert, inserting may move the vertices.
+    mutable FlatHashMap<NodeId, Vertex> _vertices;
+
+    mutable bool _verticesValid;
+
+    /// In the topological order; the entries of deleted nodes stay empty.
+    mutable std::vector<std::vector<NodeId>> _strongComponents;
+
+    /// Index in `_strongComponents`.
+    mutable FlatHashMap<NodeId, std::size_t> _strongComponentOf;
+
+    /// Whether the strong component contains a cycle.
+    mutable std::vector<std::uint8_t> _cyclic;
+
+    mutable bool _strongComponentsValid;
+
+    mutable std::vector<std::size_t> _depths;
+
+    /// Connection through which the deepest path enters every strong component.
+    mutable std::vector<std::pair<NodeId, NodeId>> _deepestEdge;
+
+    mutable bool _depthsValid;
+
+    /// Union-find forest of the connected components.
+    mutable FlatHashMap<NodeId, NodeId> _componentParent;
+
+    mutable std::size_t _componentCount;
+
+    mutable bool _componentsValid;
+
+    mutable FlatHashMap<NodeId, std::vector<NodeId>> _downstreamCones;
+
+    mutable FlatHashMap<NodeId, std::vector<NodeId>> _upstreamCones;
+};
+
+} // namespace QtNodes
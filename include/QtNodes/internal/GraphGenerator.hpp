@@ -0,0 +1,120 @@
+#pragma once
+
+#include "Definitions.hpp"
+#include "Export.hpp"
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QPointF>
+#include <QtCore/QString>
+#include <QtCore/QtGlobal>
+
+#include <vector>
+
+namespace QtNodes {
+
+class AbstractGraphModel;
+
+/// Node type the generator is allowed to place.
+struct NODE_EDITOR_PUBLIC GeneratedNodeType
+{
+    /// Value written to `internal-data/model-name` and passed to `addNode`.
+    QString modelName;
+
+    unsigned int inPorts;
+
+    unsigned int outPorts;
+
+    /// Extra keys merged into the node's `internal-data`.
+    QJsonObject internalData;
+};
+
+struct NODE_EDITOR_PUBLIC GraphGeneratorOptions
+{
+    enum class Topology {
+        Chain,   ///< Every node is fed by the previous one.
+        Tree,    ///< Each node feeds `branching` children.
+        Layered, ///< Inputs are taken from the previous layer only.
+        Random   ///< Inputs are taken from any earlier node.
+    };
+
+    Topology topology = Topology::Layered;
+
+    unsigned int nodeCount = 100;
+
+    quint64 seed = 1;
+
+    /// Children per node in `Tree` topology.
+    unsigned int branching = 2;
+
+    /// Nodes per layer in `Layered` topology; 0 selects the square root of `nodeCount`.
+    unsigned int layerWidth = 0;
+
+    /// Upper limit of connected inputs per node, 0 means all the input ports.
+    unsigned int maxFanIn = 0;
+
+    /// Upper limit of outgoing connections per node, 0 means no limit.
+    unsigned int maxFanOut = 0;
+
+    /// Probability of connecting a free input port in `Random` topology.
+    double connectionProbability = 0.8;
+
+    /// Distance between the neighbouring columns and rows of the layout.
+    QPointF spacing = QPointF(250.0, 150.0);
+
+    /// Node types used for placing nodes. The calculator models by default.
+    std::vector<GeneratedNodeType> nodeTypes;
+};
+
+/// Result of `GraphGenerator::generate`, nodes are referenced by their indices.
+struct NODE_EDITOR_PUBLIC GeneratedGraph
+{
+    struct Node
+    {
+        /// Index into `GeneratedGraph::nodeTypes`.
+        unsigned int type;
+
+        QPointF position;
+    };
+
+    struct Connection
+    {
+        unsigned int outNode;
+        PortIndex outPort;
+        unsigned int inNode;
+        PortIndex inPort;
+    };
+
+    std::vector<GeneratedNodeType> nodeTypes;
+
+    std::vector<Node> nodes;
+
+    std::vector<Connection> connections;
+
+    /// Scene in the `DataFlowGraphModel::save` format, node ids are the node indices.
+    QJsonObject toJson() const;
+
+    /// Creates nodes and connections using `addNode`, `setNodeData` and `addConnection`.
+    /**
+   * `GeneratedNodeType::internalData` is not applied here, load the result
+   * of `toJson` when the models need it.
+   * @returns the ids assigned by the model, in the order of `nodes`.
+   */
+    std::vector<NodeId> populate(AbstractGraphModel &model) const;
+};
+
+/// Builds large synthetic graphs, the same options and seed give the same graph
+/// on every platform.
+class NODE_EDITOR_PUBLIC GraphGenerator
+{
+public:
+    /// Number sources, the four arithmetic operations and result displays.
+    static std::vector<GeneratedNodeType> calculatorNodeTypes();
+
+    /// A single type with one input and one output, as used by `SimpleGraphModel`.
+    static std::vector<GeneratedNodeType> simpleNodeTypes();
+
+    /// @throws std::logic_error when the node types cannot form the topology.
+    static GeneratedGraph generate(GraphGeneratorOptions const &options);
+};
+
+} // namespace QtNodes
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "Definitions.hpp"
+#include "Export.hpp"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QObject>
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+namespace QtNodes {
+
+/// Kinds of work measured by `GraphProfiler`.
+enum class ProfileCategory : int {
+    SetInData = 0,   ///< `NodeDelegateModel::setInData`, the node's own computation.
+    Propagation,     ///< Delivering a node's output to all downstream nodes.
+    NodeUpdate,      ///< `BasicGraphicsScene::onNodeUpdated`, geometry and repaint.
+    MoveConnections, ///< `NodeGraphicsObject::moveConnections`.
+    PaintNode,       ///< `NodeGraphicsObject::paint`.
+    PaintConnection, ///< `ConnectionGraphicsObject::paint`, reported without a node.
+    Count
+};
+
+constexpr int ProfileCategoryCount = static_cast<int>(ProfileCategory::Count);
+
+/// Point events reported through `GraphProfiler::mark`.
+enum class ProfileMark : int {
+    PortDataSet = 0, ///< `DataFlowGraphModel::setPortData` delivered data to an in-port.
+    SceneFlush,      ///< The scene processed its pending updates.
+};
+
+/// Receives every finished measurement and mark of a `GraphProfiler`.
+/**
+ * The listeners are called synchronously from the measured code, they should
+ * only store the event.
+ */
+class NODE_EDITOR_PUBLIC AbstractProfileListener
+{
+public:
+    virtual ~AbstractProfileListener() = default;
+
+    /// `startNs` and `endNs` are `GraphProfiler::now()` values.
+    virtual void measured(NodeId const nodeId,
+                          ProfileCategory const category,
+                          qint64 startNs,
+                          qint64 endNs)
+        = 0;
+
+    virtual void marked(ProfileMark const mark,
+                        NodeId const nodeId,
+                        PortIndex const portIndex,
+                        qint64 timeNs)
+        = 0;
+};
+
+struct ProfileStats
+{
+    quint64 count = 0;
+
+    /// Wall time including the nested measured calls.
+    qint64 totalNs = 0;
+
+    /// Wall time without the nested measured calls.
+    qint64 selfNs = 0;
+
+    qint64 maxNs = 0;
+
+    /// Inclusive duration of the latest call.
+    qint64 lastNs = 0;
+
+    /// `GraphProfiler::now()` at the end of the latest call.
+    qint64 lastEndNs = 0;
+
+    void add(qint64 durationNs, qint64 selfDurationNs, qint64 endNs);
+};
+
+struct NodeProfile
+{
+    std::array<ProfileStats, ProfileCategoryCount> stats;
+
+    ProfileStats const &operator[](ProfileCategory category) const
+    {
+        return stats[static_cast<int>(category)];
+    }
+};
+
+/// Collects the per-node timings of the computations and of the scene reactions.
+/**
+ * The profiler is owned by `DataFlowGraphModel` and is disabled by default;
+ * while disabled every measured spot costs a single flag check. All the
+ * measurements are expected to happen on the GUI thread.
+ */
+class NODE_EDITOR_PUBLIC GraphProfiler : public QObject
+{
+    Q_OBJECT
+
+public:
+    GraphProfiler(QObject *parent = nullptr);
+
+    void setEnabled(bool enabled);
+
+    bool isEnabled() const { return _enabled; }
+
+    /// Drops all the collected statistics.
+    void reset();
+
+    /// Nanoseconds since the profiler was created.
+    qint64 now() const { return _clock.nsecsElapsed(); }
+
+public:
+    ProfileStats stats(NodeId const nodeId, ProfileCategory const category) const;
+
+    /// Aggregated over all the nodes (and the connections).
+    ProfileStats const &totals(ProfileCategory const category) const
+    {
+        return _totals[static_cast<int>(category)];
+    }
+
+    std::unordered_map<NodeId, NodeProfile> const &nodeProfiles() const { return _nodes; }
+
+    /// Forgets the statistics of a deleted node.
+    void removeNode(NodeId const nodeId);
+
+public:
+    /// Starts a measurement, must be paired with `end`. See `ScopedProfile`.
+    void begin(NodeId const nodeId, ProfileCategory const category);
+
+    void end();
+
+    /// Reports a point event to the listeners, does nothing while disabled.
+    void mark(ProfileMark const mark,
+              NodeId const nodeId,
+              PortIndex const portIndex = InvalidPortIndex);
+
+public:
+    /// The listener is not owned and must be removed before it is destroyed.
+    void addListener(AbstractProfileListener *listener);
+
+    void removeListener(AbstractProfileListener *listener);
+
+Q_SIGNALS:
+    /// Emitted at most once per event loop iteration after new computations
+    /// (`SetInData` or `Propagation`) were recorded.
+    void profileUpdated();
+
+private:
+    struct Frame
+    {
+        NodeId nodeId;
+        ProfileCategory category;
+        qint64 startNs;
+        qint64 childrenNs;
+    };
+
+    void scheduleUpdateSignal();
+
+private:
+    bool _enabled;
+
+    bool _updateScheduled;
+
+    QElapsedTimer _clock;
+
+    std::vector<Frame> _frames;
+
+    std::unordered_map<NodeId, NodeProfile> _nodes;
+
+    std::array<ProfileStats, ProfileCategoryCount> _totals;
+
+    std::vector<AbstractProfileListener *> _listeners;
+};
+
+/// Measures the enclosing scope when the profiler is present and enabled.
+class ScopedProfile
+{
+public:
+    ScopedProfile(GraphProfiler *profiler, NodeId const nodeId, ProfileCategory const category)
+        : _profiler((profiler && profiler->isEnabled()) ? profiler : nullptr)
+    {
+        if (_profiler)
+            _profiler->begin(nodeId, category);
+    }
+
+    ~ScopedProfile()
+    {
+        if (_profiler)
+            _profiler->end();
+    }
+
+    ScopedProfile(ScopedProfile const &) = delete;
+
+    ScopedProfile &operator=(ScopedProfile const &) = delete;
+
+private:
+    GraphProfiler *_profiler;
+};
+
+} // namespace QtNodes
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Definitions.hpp"
+#include "Export.hpp"
+
+#include <QtCore/QPointF>
+#include <QtCore/QSize>
+#include <QtCore/QString>
+
+#include <memory>
+#include <vector>
+
+namespace QtNodes {
+
+class DataFlowGraphModel;
+
+/// A node as it was when the snapshot was published.
+struct NODE_EDITOR_PUBLIC SnapshotNode
+{
+    NodeId id = InvalidNodeId;
+
+    QString type;
+
+    QString caption;
+
+    QPointF position;
+
+    QSize size;
+
+    PortCount inPortCount = 0;
+
+    PortCount outPortCount = 0;
+
+    /// Input and output connections of the node.
+    std::vector<ConnectionId> connections;
+};
+
+/// Immutable view of the nodes, their geometry and the connectivity.
+/**
+ * Published by `DataFlowGraphModel::publishSnapshot`. A snapshot never
+ * changes once published, any number of threads may read it without locks
+ * while the model keeps being edited.
+ *
+ * The nodes are grouped into chunks by their slot (see `SlotAllocator`). A new
+ * snapshot shares all the unchanged chunks with the previous one, so
+ * publishing after a small edit costs only the few rebuilt chunks.
+ */
+class NODE_EDITOR_PUBLIC GraphSnapshot
+{
+public:
+    static constexpr std::size_t ChunkSize = 256;
+
+    /// Grows by one with every published snapshot of a model.
+    quint64 version() const { return _version; }
+
+    std::size_t nodeCount() const { return _nodeCount; }
+
+    std::size_t connectionCount() const { return _connectionCount; }
+
+    bool contains(NodeId const nodeId) const { return node(nodeId) != nullptr; }
+
+    /// `nullptr` for the nodes absent from the snapshot.
+    SnapshotNode const *node(NodeId const nodeId) const;
+
+    /// Connections of the node, empty for unknown ids.
+    std::vector<ConnectionId> const &connections(NodeId const nodeId) const;
+
+    std::vector<NodeId> nodeIds() const;
+
+    /// Every connection once.
+    std::vector<ConnectionId> allConnections() const;
+
+    /// Calls `f(SnapshotNode const &)` for every node.
+    template<typename F>
+    void forEachNode(F &&f) const
+    {
+        for (auto const &chunk : _chunks) {
+            if (!chunk)
+                continue;
+
+            for (SnapshotNode const &n : chunk->nodes) {
+                if (n.id != InvalidNodeId)
+                    f(n);
+            }
+        }
+    }
+
+private:
+    friend class DataFlowGraphModel;
+
+    struct Chunk
+    {
+        /// `ChunkSize` entries indexed by the slot, free slots have `InvalidNodeId`.
+        std::vector<SnapshotNode> nodes;
+
+        std::size_t nodeCount = 0;
+
+        /// Connections leaving the nodes of this chunk.
+        std::size_t connectionCount = 0;
+    };
+
+    using ChunkPtr = std::shared_ptr<Chunk const>;
+
+    /// Recomputes the totals from the chunks.
+    void updateCounts();
+
+private:
+    quint64 _version = 0;
+
+    std::size_t _nodeCount = 0;
+
+    std::size_t _connectionCount = 0;
+
+    std::vector<ChunkPtr> _chunks;
+};
+
+} // namespace QtNodes
@@ -0,0 +1,214 @@
+#pragma once
+
+#include "ConnectionIdHash.hpp"
+#include "Definitions.hpp"
+#include "Export.hpp"
+#include "FlatHash.hpp"
+#include "SlotAllocator.hpp"
+
+#include <QtCore/QPointF>
+#include <QtCore/QSize>
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace QtNodes {
+
+/// Nodes, geometry and connectivity shared by all the `GraphStore` instances.
+/**
+ * The nodes live in slots addressed by the generational ids of a
+ * `SlotAllocator`, the layout `DataFlowGraphModel` uses: the id of a deleted
+ * node never refers to a node created later and a saved node comes back in
+ * its original slot. Every node lists its attached connections, so the
+ * connections of a node or of a single port are found in O(degree); the
+ * existence of a connection is checked in O(1).
+ *
+ * Use `GraphStore`, the class only keeps the non-template part out of the
+ * headers.
+ */
+class NODE_EDITOR_PUBLIC GraphStoreBase
+{
+public:
+    /// Reserves a free slot and returns its id, see `GraphStore::insertNode`.
+    /**
+   * Throws `std::logic_error` when all the slots are taken.
+   */
+    NodeId reserve();
+
+    /// Frees a slot reserved and never inserted, see `SlotAllocator::unreserve`.
+    bool unreserve(NodeId const nodeId) { return _slots.unreserve(nodeId); }
+
+    bool contains(NodeId const nodeId) const { return _slots.contains(nodeId); }
+
+    std::size_t nodeCount() const { return _slots.count(); }
+
+    /// Ids of all the nodes in the slot order.
+    std::vector<NodeId> nodeIds() const { return _slots.nodeIds(); }
+
+    /// Calls `f(NodeId)` for every node in the slot order.
+    template<typename F>
+    void forEachNode(F &&f) const
+    {
+        _slots.forEach([&f](NodeId const nodeId, std::size_t) { f(nodeId); });
+    }
+
+    /// Default constructed values for unknown ids.
+    QPointF position(NodeId const nodeId) const;
+
+    QSize size(NodeId const nodeId) const;
+
+    PortCount portCount(NodeId const nodeId, PortType const portType) const;
+
+    /// The setters return false for unknown ids.
+    bool setPosition(NodeId const nodeId, QPointF const &position);
+
+    bool setSize(NodeId const nodeId, QSize const &size);
+
+    bool setPortCount(NodeId const nodeId, PortType const portType, PortCount const count);
+
+public:
+    /// Returns false when the connection exists or one of its nodes does not.
+    bool addConnection(ConnectionId const &connectionId);
+
+    bool removeConnection(ConnectionId const &connectionId);
+
+    bool containsConnection(ConnectionId const &connectionId) const
+    {
+        return _connectivity.contains(connectionId);
+    }
+
+    std::size_t connectionCount() const { return _connectivity.size(); }
+
+    /// Input and output connections of the node.
+    std::vector<ConnectionId> const &connections(NodeId const nodeId) const;
+
+    /// Connections attached to one port of the node.
+    std::vector<ConnectionId> connections(NodeId const nodeId,
+                                          PortType const portType,
+                                          PortIndex const portIndex) const;
+
+    /// Calls `f(ConnectionId const &)` for every connection once.
+    template<typename F>
+    void forEachConnection(F &&f) const
+    {
+        for (ConnectionId const &connectionId : _connectivity)
+            f(connectionId);
+    }
+
+protected:
+    GraphStoreBase() = default;
+
+    ~GraphStoreBase() = default;
+
+    /// Takes the free or reserved slot of `nodeId` and returns its index.
+    /**
+   * Throws `std::logic_error` when the slot is in use.
+   */
+    std::size_t occupy(NodeId const nodeId);
+
+    /// Frees the slot together with the connections still attached to it.
+    bool release(NodeId const nodeId);
+
+    void releaseAll();
+
+    std::size_t slotCount() const { return _slots.slotCount(); }
+
+private:
+    struct Node
+    {
+        QPointF position;
+
+        QSize size;
+
+        PortCount inPortCount = 0;
+
+        PortCount outPortCount = 0;
+
+        std::vector<ConnectionId> connections;
+    };
+
+    void detach(NodeId const nodeId, ConnectionId const &connectionId);
+
+private:
+    SlotAllocator _slots;
+
+    /// Sized to the allocator's slots.
+    std::vector<Node> _nodes;
+
+    FlatHashSet<ConnectionId> _connectivity;
+};
+
+/// Placeholder for the stores without per-node data.
+struct NoPayload
+{};
+
+/// Graph storage for the custom `AbstractGraphModel` implementations.
+/**
+ * Keeps a user defined `Payload` next to the geometry and the port counts of
+ * every node, see `GraphStoreBase` for the complexity guarantees. The payload
+ * must be default constructible and movable. `StoredGraphModel` implements
+ * the model plumbing on top of the store.
+ */
+template<typename Payload = NoPayload>
+class GraphStore : public GraphStoreBase
+{
+public:
+    NodeId addNode(Payload payload = Payload())
+    {
+        NodeId const nodeId = reserve();
+        insertNode(nodeId, std::move(payload));
+        return nodeId;
+    }
+
+    /// Places a node under a reserved or a previously saved id.
+    /**
+   * Throws `std::logic_error` when the id is in use.
+   */
+    void insertNode(NodeId const nodeId, Payload payload = Payload())
+    {
+        std::size_t const index = occupy(nodeId);
+
+        if (_payloads.size() < slotCount())
+            _payloads.resize(slotCount());
+
+        _payloads[index] = std::move(payload);
+    }
+
+    /// Deletes the node together with its connections.
+    bool eraseNode(NodeId const nodeId)
+    {
+        if (!contains(nodeId))
+            return false;
+
+        _payloads[SlotAllocator::slotIndex(nodeId)] = Payload();
+
+        return release(nodeId);
+    }
+
+    void clear()
+    {
+        releaseAll();
+        _payloads.clear();
+    }
+
+    /// Throws `std::logic_error` for unknown ids.
+    Payload &payload(NodeId const nodeId)
+    {
+        if (!contains(nodeId))
+            throw std::logic_error("Unknown node id " + std::to_string(nodeId));
+
+        return _payloads[SlotAllocator::slotIndex(nodeId)];
+    }
+
+    Payload const &payload(NodeId const nodeId) const
+    {
+        return const_cast<GraphStore *>(this)->payload(nodeId);
+    }
+
+private:
+    std::vector<Payload> _payloads;
+};
+
+} // namespace QtNodes
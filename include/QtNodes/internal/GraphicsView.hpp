@@ -1,13 +1,57 @@
 #pragma once
 
+#include <QtCore/QElapsedTimer>
 #include <QtWidgets/QGraphicsView>
 
+#include "AbstractOverlayPainter.hpp"
 #include "Export.hpp"
 
+#include <deque>
+#include <memory>
+#include <vector>
+
 namespace QtNodes {
 
 class BasicGraphicsScene;
 
+/// Rendering statistics of a `GraphicsView`, see `GraphicsView::statistics()`.
+struct ViewStatistics
+{
+    /// Frames painted during the last second.
+    double framesPerSecond = 0.0;
+
+    /// Duration of the latest `paintEvent`.
+    double lastFrameMs = 0.0;
+
+    /// The slowest frame since `GraphicsView::resetStatistics()`.
+    double maxFrameMs = 0.0;
+
+    quint64 frameCount = 0;
+
+    /// Items intersecting the viewport after the latest frame.
+    int visibleNodes = 0;
+    int visibleConnections = 0;
+
+    int totalNodes = 0;
+    int totalConnections = 0;
+
+    /**
+   * The values below are taken from the scene's `GraphProfiler` and stay zero
+   * while it is absent or disabled.
+   */
+    /// `NodeGraphicsObject::paint` calls during the latest frame.
+    int nodesPainted = 0;
+
+    int connectionsPainted = 0;
+
+    double nodePaintMs = 0.0;
+
+    double connectionPaintMs = 0.0;
+
+    /// Share of the visible nodes taken from the item cache in the latest frame.
+    double nodeCacheHitRate = 0.0;
+};
+
 /**
  * @brief A central view able to render objects from `BasicGraphicsScene`.
  */
@@ -43,6 +87,35 @@ public:
 
     double getScale() const;
 
+    /// Paints `overlay` on top of the scene, the view takes the ownership.
+    /**
+   * The overlays are painted in the order of addition. While there is at
+   * least one overlay the viewport is always updated as a whole; the
+   * previous update mode comes back with the removal of the last one.
+   */
+    AbstractOverlayPainter *addOverlayPainter(std::unique_ptr<AbstractOverlayPainter> overlay);
+
+    /// Deletes the previously added `overlay`.
+    void removeOverlayPainter(AbstractOverlayPainter *overlay);
+
+    /// Starts collecting `ViewStatistics` in every `paintEvent`.
+    /**
+   * Counting the visible and the total items is linear in the number of the
+   * scene items, the collection is disabled by default.
+   */
+    void setStatisticsEnabled(bool enabled);
+
+    bool statisticsEnabled() const { return _statisticsEnabled; }
+
+    ViewStatistics const &statistics() const { return _statistics; }
+
+    void resetStatistics();
+
+    /// Shows the statistics in the top left corner, enables their collection.
+    void setStatisticsVisible(bool visible);
+
+    bool statisticsVisible() const { return _statisticsOverlay != nullptr; }
+
 public Q_SLOTS:
     void scaleUp();
 
@@ -76,6 +149,10 @@ protected:
 
     void drawBackground(QPainter *painter, const QRectF &r) override;
 
+    void drawForeground(QPainter *painter, const QRectF &r) override;
+
+    void paintEvent(QPaintEvent *event) override;
+
     void showEvent(QShowEvent *event) override;
 
 protected:
@@ -93,5 +170,17 @@ private:
 
     QPointF _clickPos;
     ScaleRange _scaleRange;
+
+    std::vector<std::unique_ptr<AbstractOverlayPainter>> _overlayPainters;
+
+    /// The update mode set before the first overlay, restored after the last.
+    ViewportUpdateMode _overlaylessUpdateMode = QGraphicsView::BoundingRectViewportUpdate;
+
+    bool _statisticsEnabled = false;
+    ViewStatistics _statistics;
+    QElapsedTimer _statisticsClock;
+    /// End times of the frames painted during the last second, ns.
+    std::deque<qint64> _recentFrames;
+    AbstractOverlayPainter *_statisticsOverlay = nullptr;
 };
 } // namespace QtNodes
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "AbstractConnectionPainter.hpp"
+#include "AbstractNodePainter.hpp"
+#include "AbstractOverlayPainter.hpp"
+#include "Definitions.hpp"
+#include "Export.hpp"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+#include <QtGui/QColor>
+
+#include <memory>
+#include <unordered_map>
+
+namespace QtNodes {
+
+class BasicGraphicsScene;
+class GraphicsView;
+class GraphProfiler;
+
+/// Turns the profiler's cumulative timings into recent per-node "heat".
+/**
+ * Two values are tracked for every node: the compute time per second spent
+ * in its `setInData` (self time) and the number of propagations out of the
+ * node per second. Both are smoothed exponentially and fade out when the
+ * node becomes idle. The profiler must be enabled for the map to change.
+ */
+class NODE_EDITOR_PUBLIC HeatMap : public QObject
+{
+    Q_OBJECT
+
+public:
+    HeatMap(GraphProfiler &profiler, QObject *parent = nullptr);
+
+    /// Time after which the heat of an idle node halves. 1000 ms by default.
+    void setHalfLife(int milliseconds);
+
+    int halfLife() const { return _halfLifeMs; }
+
+    /// Recent compute time of the node relative to the hottest one, [0, 1].
+    double heat(NodeId const nodeId) const;
+
+    /// Recent propagation rate of the node relative to the busiest one, [0, 1].
+    double frequency(NodeId const nodeId) const;
+
+    /// Compute milliseconds per second corresponding to `heat() == 1`.
+    double peakComputeRate() const { return _peakComputeRate; }
+
+    /// Propagations per second corresponding to `frequency() == 1`.
+    double peakPropagationRate() const { return _peakPropagationRate; }
+
+    /// Gradient used by the painters, from transparent blue to red.
+    static QColor color(double heat);
+
+    /// Decorates the scene's painters with the default heat map painters.
+    /**
+   * The scene gets `HeatMapNodePainter` and `HeatMapConnectionPainter`
+   * around the default painters and is repainted when the heat changes.
+   * When `view` is given a `HeatMapLegendPainter` is added to it.
+   */
+    void install(BasicGraphicsScene &scene, GraphicsView *view = nullptr);
+
+Q_SIGNALS:
+    void heatChanged();
+
+private:
+    void refresh();
+
+private:
+    struct Entry
+    {
+        qint64 lastSelfNs = 0;
+        quint64 lastPropagations = 0;
+        double computeRate = 0.0;
+        double propagationRate = 0.0;
+    };
+
+    GraphProfiler &_profiler;
+
+    int _halfLifeMs;
+
+    QTimer _decayTimer;
+
+    QElapsedTimer _sinceRefresh;
+
+    std::unordered_map<NodeId, Entry> _entries;
+
+    double _peakComputeRate;
+
+    double _peakPropagationRate;
+};
+
+/// Tints the nodes painted by the decorated painter according to their heat.
+class NODE_EDITOR_PUBLIC HeatMapNodePainter : public AbstractNodePainter
+{
+public:
+    /// `nullptr` base stands for `DefaultNodePainter`.
+    HeatMapNodePainter(HeatMap const &heatMap, std::unique_ptr<AbstractNodePainter> base = nullptr);
+
+    void paint(QPainter *painter, NodeGraphicsObject &ngo) const override;
+
+private:
+    HeatMap const &_heatMap;
+
+    std::unique_ptr<AbstractNodePainter> _base;
+};
+
+/// Draws the connections thicker and warmer after busy upstream nodes.
+class NODE_EDITOR_PUBLIC HeatMapConnectionPainter : public AbstractConnectionPainter
+{
+public:
+    /// `nullptr` base stands for `DefaultConnectionPainter`.
+    HeatMapConnectionPainter(HeatMap const &heatMap,
+                             std::unique_ptr<AbstractConnectionPainter> base = nullptr);
+
+    void paint(QPainter *painter, ConnectionGraphicsObject const &cgo) const override;
+
+    QPainterPath getPainterStroke(ConnectionGraphicsObject const &cgo) const override;
+
+private:
+    HeatMap const &_heatMap;
+
+    std::unique_ptr<AbstractConnectionPainter> _base;
+};
+
+/// Gradient bar with the current peak values in the bottom left corner.
+class NODE_EDITOR_PUBLIC HeatMapLegendPainter : public AbstractOverlayPainter
+{
+public:
+    HeatMapLegendPainter(HeatMap const &heatMap);
+
+    void paint(QPainter *painter, GraphicsView const &view) const override;
+
+private:
+    HeatMap const &_heatMap;
+};
+
+} // namespace QtNodes
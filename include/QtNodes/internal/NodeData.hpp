@@ -1,5 +1,6 @@
 #pragma once
 
+#include <limits>
 #include <memory>
 
 #include <QtCore/QObject>
@@ -19,6 +20,21 @@ struct NODE_EDITOR_PUBLIC NodeDataType
     QString name;
 };
 
+/// Interned `NodeDataType::id`, the same string always gives the same value.
+/**
+ * The values are assigned in the order of interning and are only valid
+ * within the running process, serialization keeps using the strings.
+ */
+using NodeDataTypeId = unsigned int;
+
+static constexpr NodeDataTypeId InvalidNodeDataTypeId = std::numeric_limits<NodeDataTypeId>::max();
+
+/// Returns the id of `typeId`, registers it on the first call. Thread-safe.
+NODE_EDITOR_PUBLIC NodeDataTypeId internNodeDataType(QString const &typeId);
+
+/// The string interned as `id`, empty for an unknown id.
+NODE_EDITOR_PUBLIC QString nodeDataTypeString(NodeDataTypeId const id);
+
 /**
  * Class represents data transferred between nodes.
  * @param type is used for comparing the types
@@ -49,11 +49,49 @@ public:
 
     void load(QJsonObject const &) override;
 
+    /// Decodes the model-specific `internal-data` on a worker thread.
+    /**
+   * The function is called by `DataFlowGraphModel::load` when the parallel
+   * loading is enabled, right after the model is created and before `load()`
+   * is invoked on the owning thread. It must not touch widgets, emit signals
+   * or access other nodes.
+   *
+   * Heavy decoding (images, large tables) is supposed to happen here. The
+   * result should be kept inside the model so that the subsequent `load()`
+   * only installs the ready state.
+   */
+    virtual void preload(QJsonObject const &) {}
+
+    /// Restores the state of a freshly constructed model for reuse.
+    /**
+   * Called by `NodeDelegateModelRegistry` when the model of a deleted node is
+   * kept in the pool of its type (see `NodeDelegateModelRegistry::setPoolCapacity`).
+   * By then all the connections of the model's signals are removed.
+   *
+   * The embedded widget belongs to the deleted node's graphics object and is
+   * destroyed together with it: the implementation must forget the pointer
+   * and create a new widget in the next `embeddedWidget()` call.
+   *
+   * Returns `false` when the model cannot be reused, it is deleted then. The
+   * default implementation does so.
+   */
+    virtual bool reset() { return false; }
+
+    /// Id of the model type in the registry which created the model.
+    ModelTypeId modelTypeId() const { return _modelTypeId; }
+
 public:
     virtual unsigned int nPorts(PortType portType) const = 0;
 
     virtual NodeDataType dataType(PortType portType, PortIndex portIndex) const = 0;
 
+    /// Interned id of `dataType(portType, portIndex).id`.
+    /**
+   * The default implementation interns the string on every call. Models can
+   * return ids obtained once from `internNodeDataType`.
+   */
+    virtual NodeDataTypeId portDataTypeId(PortType portType, PortIndex portIndex) const;
+
 public:
     virtual ConnectionPolicy portConnectionPolicy(PortType, PortIndex) const;
 
@@ -127,7 +165,11 @@ Q_SIGNALS:
     void portsInserted();
 
 private:
+    friend class NodeDelegateModelRegistry;
+
     NodeStyle _nodeStyle;
+
+    ModelTypeId _modelTypeId;
 };
 
 } // namespace QtNodes
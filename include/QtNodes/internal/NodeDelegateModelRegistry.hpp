@@ -17,7 +17,36 @@
 
 namespace QtNodes {
 
+/// Metadata of a registered model, available without instantiating it.
+struct ModelDescriptor
+{
+    /// Filled by the registry.
+    ModelTypeId id = InvalidModelTypeId;
+
+    /// Unique key, the same as `NodeDelegateModel::name()`.
+    QString name;
+
+    QString category = "Nodes";
+
+    /// Empty when not provided, the menus fall back to `name`.
+    QString caption;
+
+    /// Data types of the ports, empty when not provided.
+    std::vector<NodeDataType> inPortTypes;
+
+    std::vector<NodeDataType> outPortTypes;
+};
+
 /// Class uses map for storing models (name, model)
+/**
+ * Every registered model gets an interned `ModelTypeId`, the index of its
+ * registration. Creating a model by id is a vector lookup.
+ *
+ * A model is instantiated during the registration only when its name cannot
+ * be obtained otherwise: neither a `ModelDescriptor` nor a static
+ * `static QString Name()` is given. The optional `static QString Caption()`
+ * is recorded in the descriptor too.
+ */
 class NODE_EDITOR_PUBLIC NodeDelegateModelRegistry
 {
 public:
@@ -41,23 +70,29 @@ public:
 
 public:
     template<typename ModelType>
-    void registerModel(RegistryItemCreator creator, QString const &category = "Nodes")
+    ModelTypeId registerModel(RegistryItemCreator creator, QString const &category = "Nodes")
     {
-        QString const name = computeName<ModelType>(HasStaticMethodName<ModelType>{}, creator);
-        if (!_registeredItemCreators.count(name)) {
-            _registeredItemCreators[name] = std::move(creator);
-            _categories.insert(category);
-            _registeredModelsCategory[name] = category;
-        }
+        ModelDescriptor descriptor = describe<ModelType>(HasStaticMethodName<ModelType>{},
+                                                         creator);
+        descriptor.category = category;
+
+        return registerModel(std::move(descriptor), std::move(creator));
     }
 
     template<typename ModelType>
-    void registerModel(QString const &category = "Nodes")
+    ModelTypeId registerModel(QString const &category = "Nodes")
     {
         RegistryItemCreator creator = []() { return std::make_unique<ModelType>(); };
-        registerModel<ModelType>(std::move(creator), category);
+        return registerModel<ModelType>(std::move(creator), category);
     }
 
+    /// Registers a model described by `descriptor`, never instantiates it.
+    /**
+   * Returns the id of the already registered model with the same name, the
+   * earlier registration wins.
+   */
+    ModelTypeId registerModel(ModelDescriptor descriptor, RegistryItemCreator creator);
+
 #if 0
   template<typename ModelType>
   void
@@ -96,6 +131,40 @@ public:
 
     std::unique_ptr<NodeDelegateModel> create(QString const &modelName);
 
+    /// `nullptr` for an unknown id. Takes a pooled instance when there is one.
+    std::unique_ptr<NodeDelegateModel> create(ModelTypeId const modelTypeId);
+
+    /// Keeps up to `capacity` released models of every type for reuse.
+    /**
+   * 0 (the default) disables the pooling. Only the models implementing
+   * `NodeDelegateModel::reset()` are pooled.
+   */
+    void setPoolCapacity(std::size_t capacity);
+
+    std::size_t poolCapacity() const { return _poolCapacity; }
+
+    /// Hands over a model which is not used anymore, it is pooled or deleted.
+    /**
+   * The connections from the model's signals to `owner`, the graph model
+   * that used it, are cut; the ones the model made itself are kept.
+   */
+    void release(std::unique_ptr<NodeDelegateModel> model, QObject const *owner);
+
+    /// Deletes all the pooled models.
+    void clearPools();
+
+    /// Number of the pooled models of all types.
+    std::size_t pooledModelCount() const;
+
+    /// `InvalidModelTypeId` for an unknown name.
+    ModelTypeId modelTypeId(QString const &modelName) const;
+
+    /// `nullptr` for an unknown id.
+    ModelDescriptor const *descriptor(ModelTypeId const modelTypeId) const;
+
+    /// All the registered models in the order of registration, indexed by id.
+    std::vector<ModelDescriptor> const &descriptors() const { return _descriptors; }
+
     RegisteredModelCreatorsMap const &registeredModelCreators() const;
 
     RegisteredModelsCategoryMap const &registeredModelsCategoryAssociation() const;
@@ -115,6 +184,18 @@ private:
 
     RegisteredModelCreatorsMap _registeredItemCreators;
 
+    std::unordered_map<QString, ModelTypeId> _modelTypeIds;
+
+    std::vector<ModelDescriptor> _descriptors;
+
+    /// Indexed by `ModelTypeId`.
+    std::vector<RegistryItemCreator> _creators;
+
+    std::size_t _poolCapacity = 0;
+
+    /// Released models, indexed by `ModelTypeId`.
+    std::vector<std::vector<std::unique_ptr<NodeDelegateModel>>> _pools;
+
 #if 0
   RegisteredTypeConvertersMap _registeredTypeConverters;
 #endif
@@ -134,18 +215,47 @@ private:
         : std::true_type
     {};
 
+    template<typename T, typename = void>
+    struct HasStaticMethodCaption : std::false_type
+    {};
+
+    template<typename T>
+    struct HasStaticMethodCaption<
+        T,
+        typename std::enable_if<std::is_same<decltype(T::Caption()), QString>::value>::type>
+        : std::true_type
+    {};
+
+    template<typename ModelType>
+    static QString computeCaption(std::true_type)
+    {
+        return ModelType::Caption();
+    }
+
     template<typename ModelType>
-    static QString computeName(std::true_type, RegistryItemCreator const &)
+    static QString computeCaption(std::false_type)
     {
-        return ModelType::Name();
+        return QString();
     }
 
     template<typename ModelType>
-    static QString computeName(std::false_type, RegistryItemCreator const &creator)
+    static ModelDescriptor describe(std::true_type, RegistryItemCreator const &)
     {
-        return creator()->name();
+        ModelDescriptor descriptor;
+        descriptor.name = ModelType::Name();
+        descriptor.caption = computeCaption<ModelType>(HasStaticMethodCaption<ModelType>{});
+        return descriptor;
     }
 
+    /// The model is instantiated anyway, all the metadata is taken from it.
+    template<typename ModelType>
+    static ModelDescriptor describe(std::false_type, RegistryItemCreator const &creator)
+    {
+        return describeInstance(*creator());
+    }
+
+    static ModelDescriptor describeInstance(NodeDelegateModel const &model);
+
     template<typename T>
     struct UnwrapUniquePtr
     {
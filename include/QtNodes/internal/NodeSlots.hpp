@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Definitions.hpp"
+#include "Export.hpp"
+#include "NodeDelegateModel.hpp"
+#include "SlotAllocator.hpp"
+
+#include <QtCore/QPointF>
+#include <QtCore/QSize>
+
+#include <memory>
+#include <vector>
+
+namespace QtNodes {
+
+/// Dense storage of the `DataFlowGraphModel` nodes addressed by generational ids.
+/**
+ * The ids are handed out by a `SlotAllocator`, see there for their layout.
+ * The per-node values live in parallel arrays indexed by the slot, the
+ * iteration walks them in the slot order and freed slots are reused. The
+ * attached connections are listed per node as well, so that the connections
+ * of a node are found without scanning the whole graph.
+ */
+class NODE_EDITOR_PUBLIC NodeSlots
+{
+public:
+    /// Reserves a free slot and returns its id, see `insert`.
+    /**
+   * Throws `std::logic_error` when all the slots are taken.
+   */
+    NodeId reserve();
+
+    /// Frees a slot reserved and never inserted, see `SlotAllocator::unreserve`.
+    bool unreserve(NodeId const nodeId) { return _slots.unreserve(nodeId); }
+
+    /// Places the model into the slot addressed by `nodeId`.
+    /**
+   * The slot must be free or reserved for this very id, see
+   * `SlotAllocator::occupy`. Throws `std::logic_error` otherwise.
+   */
+    void insert(NodeId const nodeId, std::unique_ptr<NodeDelegateModel> model);
+
+    /// Whether `insert` would accept the id.
+    bool canInsert(NodeId const nodeId) const { return _slots.canOccupy(nodeId); }
+
+    /// Frees the slot and returns its model, `nullptr` for unknown ids.
+    std::unique_ptr<NodeDelegateModel> erase(NodeId const nodeId);
+
+    void clear();
+
+    bool contains(NodeId const nodeId) const { return _slots.contains(nodeId); }
+
+    /// `nullptr` for unknown or stale ids.
+    NodeDelegateModel *model(NodeId const nodeId) const
+    {
+        return contains(nodeId) ? _models[SlotAllocator::slotIndex(nodeId)].get() : nullptr;
+    }
+
+    QPointF position(NodeId const nodeId) const
+    {
+        return contains(nodeId) ? _positions[SlotAllocator::slotIndex(nodeId)] : QPointF();
+    }
+
+    QSize size(NodeId const nodeId) const
+    {
+        return contains(nodeId) ? _sizes[SlotAllocator::slotIndex(nodeId)] : QSize();
+    }
+
+    /// Returns false for unknown ids, nothing is allocated for them.
+    bool setPosition(NodeId const nodeId, QPointF const &position);
+
+    bool setSize(NodeId const nodeId, QSize const &size);
+
+    /// Connections attached to the node, in both directions.
+    std::vector<ConnectionId> const &connections(NodeId const nodeId) const;
+
+    /// Lists the connection at both its nodes, unknown nodes are skipped.
+    void attach(ConnectionId const &connectionId);
+
+    void detach(ConnectionId const &connectionId);
+
+    std::size_t count() const { return _slots.count(); }
+
+    /// Number of the allocated slots, free ones included.
+    std::size_t slotCount() const { return _slots.slotCount(); }
+
+    /// Id of the node in the slot, `InvalidNodeId` for a free or reserved slot.
+    NodeId nodeIdAt(std::size_t const index) const { return _slots.nodeIdAt(index); }
+
+    /// Calls `f(NodeId, NodeDelegateModel &)` for every node in the slot order.
+    template<typename F>
+    void forEach(F &&f) const
+    {
+        _slots.forEach(
+            [this, &f](NodeId const nodeId, std::size_t const index) { f(nodeId, *_models[index]); });
+    }
+
+    /// Ids of all the nodes in the slot order.
+    std::vector<NodeId> nodeIds() const { return _slots.nodeIds(); }
+
+private:
+    /// Sizes the per-slot arrays after the allocator grew.
+    void fitSlots();
+
+private:
+    SlotAllocator _slots;
+
+    std::vector<std::unique_ptr<NodeDelegateModel>> _models;
+
+    std::vector<QPointF> _positions;
+
+    std::vector<QSize> _sizes;
+
+    std::vector<std::vector<ConnectionId>> _connections;
+};
+
+} // namespace QtNodes
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Definitions.hpp"
+#include "Export.hpp"
+#include "FlatHash.hpp"
+
+#include <QtCore/QPointF>
+
+#include <cstdint>
+#include <vector>
+
+namespace QtNodes {
+
+/// A port and its position in the scene.
+struct PortLocation
+{
+    NodeId nodeId;
+
+    PortType portType;
+
+    PortIndex portIndex;
+
+    QPointF scenePos;
+};
+
+/// Uniform grid over the scene positions of a set of ports.
+/**
+ * The ports are bucketed into square cells of the search radius, so the
+ * nearest port within the radius is found by looking at the 3x3 cells around
+ * the point: O(1) on average, independent of the number of ports. The ports
+ * are grouped by node, replacing the ports of one node costs O(its ports).
+ */
+class NODE_EDITOR_PUBLIC PortGrid
+{
+public:
+    /// The radius may not exceed the cell size, see `nearest`.
+    explicit PortGrid(double const cellSize = 40.0);
+
+    void setCellSize(double const cellSize);
+
+    double cellSize() const { return _cellSize; }
+
+    void insert(PortLocation const &port);
+
+    /// Removes all the ports of the node.
+    void removeNode(NodeId const nodeId);
+
+    bool contains(NodeId const nodeId) const { return _nodes.count(nodeId) != 0; }
+
+    void clear();
+
+    bool empty() const { return _nodes.empty(); }
+
+    std::size_t size() const { return _size; }
+
+    /// Nodes having at least one port in the grid.
+    std::vector<NodeId> nodeIds() const;
+
+    /// Calls `f(PortLocation const &)` for every port.
+    template<typename F>
+    void forEachPort(F &&f) const
+    {
+        for (auto const &entry : _nodes) {
+            for (PortLocation const &port : entry.second)
+                f(port);
+        }
+    }
+
+    /// The port closest to `scenePos` not farther than `radius`.
+    /**
+   * `nullptr` when there is none. The radius is clamped to the cell size.
+   * The pointer is valid until the grid changes.
+   */
+    PortLocation const *nearest(QPointF const &scenePos, double radius) const;
+
+private:
+    /// A port of `_nodes`.
+    struct CellEntry
+    {
+        NodeId nodeId;
+
+        std::size_t index;
+    };
+
+    std::int64_t cellCoordinate(double const value) const;
+
+    static std::uint64_t cellKey(std::int64_t const x, std::int64_t const y);
+
+    std::uint64_t cellKey(QPointF const &scenePos) const;
+
+    void rebuildCells();
+
+private:
+    double _cellSize;
+
+    std::size_t _size;
+
+    FlatHashMap<NodeId, std::vector<PortLocation>> _nodes;
+
+    FlatHashMap<std::uint64_t, std::vector<CellEntry>> _cells;
+};
+
+} // namespace QtNodes
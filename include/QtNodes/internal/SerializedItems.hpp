@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Definitions.hpp"
+#include "Export.hpp"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QJsonObject>
+#include <QtCore/QPointF>
+
+#include <vector>
+
+namespace QtNodes {
+
+/// A node taken out of the graph model by `AbstractGraphModel::saveNode`.
+/**
+ * The id and the position are kept outside of the json object so that they
+ * could be remapped or offset without touching (and detaching) the json.
+ * They are written back into the object right before
+ * `AbstractGraphModel::loadNode` is invoked.
+ */
+struct NODE_EDITOR_PUBLIC SerializedNode
+{
+    NodeId id;
+
+    QPointF position;
+
+    /// Whatever `saveNode` produced, including the model's internal data.
+    QJsonObject json;
+
+    /// Json with the current `id` and `position` ready for `loadNode`.
+    QJsonObject toLoadableJson() const;
+};
+
+/// A group of nodes with the connections among them.
+struct NODE_EDITOR_PUBLIC SerializedItems
+{
+    std::vector<SerializedNode> nodes;
+
+    std::vector<ConnectionId> connections;
+
+    bool empty() const { return nodes.empty(); }
+
+    /// Compact binary form used for the `application/qt-nodes-graph` mime type.
+    QByteArray toBinary() const;
+
+    /// Returns false if `data` was not produced by `toBinary`.
+    static bool fromBinary(QByteArray const &data, SerializedItems &items);
+
+    /// The format used by `AbstractGraphModel::save`: "nodes" and "connections" arrays.
+    QJsonObject toJson() const;
+
+    static SerializedItems fromJson(QJsonObject const &sceneJson);
+
+    /// Average position of all the nodes.
+    QPointF averagePosition() const;
+
+    /// Shifts all the nodes by `diff`.
+    void offset(QPointF const &diff);
+};
+
+} // namespace QtNodes
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "Definitions.hpp"
+#include "Export.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace QtNodes {
+
+/// Hands out the generational node ids of `NodeSlots` and `GraphStore`.
+/**
+ * A `NodeId` packs the slot index (low 24 bits) and the generation of the
+ * slot (next 7 bits). The generation is bumped whenever a slot is freed, so
+ * the id of a deleted node never refers to a node created later in the same
+ * slot. The highest bit stays clear: no id collides with `InvalidNodeId` and
+ * every id fits a JSON integer.
+ *
+ * The allocator only tracks the state of the slots; the owner keeps the
+ * per-node values in arrays indexed by the slot and resizes them to
+ * `slotCount()` after `reserve` or `occupy`. Freed slots are reused, lower
+ * ones first.
+ */
+class NODE_EDITOR_PUBLIC SlotAllocator
+{
+public:
+    static constexpr unsigned int IndexBits = 24;
+    static constexpr unsigned int GenerationBits = 7;
+
+    static constexpr NodeId IndexMask = (NodeId(1) << IndexBits) - 1;
+    static constexpr NodeId GenerationMask = (NodeId(1) << GenerationBits) - 1;
+
+    static constexpr std::size_t MaxSlotCount = std::size_t(1) << IndexBits;
+
+    static std::size_t slotIndex(NodeId const nodeId) { return nodeId & IndexMask; }
+
+    static unsigned int generation(NodeId const nodeId)
+    {
+        return (nodeId >> IndexBits) & GenerationMask;
+    }
+
+    static NodeId makeNodeId(std::size_t const index, unsigned int const generation)
+    {
+        return static_cast<NodeId>(index) | ((generation & GenerationMask) << IndexBits);
+    }
+
+    /// Whether the id follows the index/generation layout.
+    static bool isWellFormed(NodeId const nodeId)
+    {
+        return (nodeId >> (IndexBits + GenerationBits)) == 0;
+    }
+
+public:
+    /// Reserves a free slot and returns its id, see `occupy`.
+    /**
+   * Throws `std::logic_error` when all the slots are taken.
+   */
+    NodeId reserve();
+
+    /// Takes the slot addressed by `nodeId` and returns its index.
+    /**
+   * The slot must be free or reserved for this very id. A free slot adopts
+   * the generation of `nodeId`, which lets the saved or undone nodes come
+   * back under their original ids. Throws `std::logic_error` otherwise.
+   */
+    std::size_t occupy(NodeId const nodeId);
+
+    /// Whether `occupy` would accept the id.
+    bool canOccupy(NodeId const nodeId) const
+    {
+        if (!isWellFormed(nodeId))
+            return false;
+
+        std::size_t const index = slotIndex(nodeId);
+
+        return index >= _states.size() || _states[index] == Free
+               || (_states[index] == Reserved && _generations[index] == generation(nodeId));
+    }
+
+    /// Frees the slot of a contained id and bumps its generation.
+    bool release(NodeId const nodeId);
+
+    /// Frees a slot reserved for `nodeId` and never occupied.
+    /**
+   * The generation is bumped as by `release`, the handed out id does not
+   * come back with the next `reserve`.
+   */
+    bool unreserve(NodeId const nodeId);
+
+    /// Frees all the slots, the allocated ones stay allocated.
+    void releaseAll();
+
+    bool contains(NodeId const nodeId) const
+    {
+        std::size_t const index = slotIndex(nodeId);
+
+        return isWellFormed(nodeId) && index < _states.size() && _states[index] == Occupied
+               && _generations[index] == generation(nodeId);
+    }
+
+    std::size_t count() const { return _count; }
+
+    /// Number of the allocated slots, free ones included.
+    std::size_t slotCount() const { return _states.size(); }
+
+    /// Id of the node in the slot, `InvalidNodeId` for a free or reserved slot.
+    NodeId nodeIdAt(std::size_t const index) const
+    {
+        return index < _states.size() && _states[index] == Occupied
+                   ? makeNodeId(index, _generations[index])
+                   : InvalidNodeId;
+    }
+
+    /// Calls `f(NodeId, std::size_t index)` for every occupied slot in order.
+    template<typename F>
+    void forEach(F &&f) const
+    {
+        for (std::size_t i = 0; i < _states.size(); ++i) {
+            if (_states[i] == Occupied)
+                f(makeNodeId(i, _generations[i]), i);
+        }
+    }
+
+    /// Ids of all the occupied slots in order.
+    std::vector<NodeId> nodeIds() const;
+
+private:
+    enum SlotState : std::uint8_t { Free, Reserved, Occupied };
+
+    /// Appends free slots up to and including `index`.
+    void grow(std::size_t const index);
+
+    /// Marks the slot free, bumps its generation and lists it for `reserve`.
+    void freeSlot(std::size_t const index);
+
+private:
+    std::vector<std::uint8_t> _generations;
+
+    std::vector<std::uint8_t> _states;
+
+    /// May hold slots taken by `occupy` meanwhile, those are skipped lazily.
+    std::vector<std::size_t> _freeSlots;
+
+    std::size_t _count = 0;
+};
+
+} // namespace QtNodes
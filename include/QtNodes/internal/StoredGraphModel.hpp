@@ -0,0 +1,365 @@
+#pragma once
+
+#include "AbstractGraphModel.hpp"
+#include "ConnectionIdUtils.hpp"
+#include "GraphStore.hpp"
+#include "StyleCollection.hpp"
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
+
+#include <algorithm>
+
+namespace QtNodes {
+
+/// `AbstractGraphModel` plumbing on top of a `GraphStore`.
+/**
+ * Implements the node and connection bookkeeping, the geometry and the port
+ * counts; the connection queries cost O(degree) of the node. A derived model
+ * supplies the port data and overrides `nodeData` for the roles it cares
+ * about, delegating the rest to this class:
+ *
+ * ```
+ * QVariant MyModel::nodeData(NodeId nodeId, NodeRole role) const
+ * {
+ *     if (role == NodeRole::Caption)
+ *         return store().payload(nodeId).name;
+ *
+ *     return StoredGraphModel::nodeData(nodeId, role);
+ * }
+ * ```
+ *
+ * The typed accessors `nodePosition`, `nodeSize` and `portCount` read the
+ * store directly; override them too when `nodeData` answers these roles
+ * differently.
+ *
+ * A class template cannot declare `Q_OBJECT`, the derived model declares it
+ * instead.
+ */
+template<typename Payload = NoPayload>
+class StoredGraphModel : public AbstractGraphModel
+{
+public:
+    using Store = GraphStore<Payload>;
+
+    Store &store() { return _store; }
+
+    Store const &store() const { return _store; }
+
+    NodeId newNodeId() override { return _store.reserve(); }
+
+    void releaseNodeId(NodeId const nodeId) override { _store.unreserve(nodeId); }
+
+    std::unordered_set<NodeId> allNodeIds() const override
+    {
+        std::unordered_set<NodeId> result;
+        result.reserve(_store.nodeCount());
+
+        _store.forEachNode([&result](NodeId const nodeId) { result.insert(nodeId); });
+
+        return result;
+    }
+
+    std::unordered_set<ConnectionId> allConnectionIds(NodeId const nodeId) const override
+    {
+        auto const &attached = _store.connections(nodeId);
+        return std::unordered_set<ConnectionId>(attached.begin(), attached.end());
+    }
+
+    std::unordered_set<ConnectionId> connections(NodeId nodeId,
+                                                 PortType portType,
+                                                 PortIndex portIndex) const override
+    {
+        auto const attached = _store.connections(nodeId, portType, portIndex);
+        return std::unordered_set<ConnectionId>(attached.begin(), attached.end());
+    }
+
+    bool connectionExists(ConnectionId const connectionId) const override
+    {
+        return _store.containsConnection(connectionId);
+    }
+
+    /// Creates a node with a default constructed payload, see `initializeNode`.
+    NodeId addNode(QString const nodeType = QString()) override
+    {
+        NodeId const nodeId = newNodeId();
+
+        _store.insertNode(nodeId);
+
+        initializeNode(nodeId, nodeType);
+
+        Q_EMIT nodeCreated(nodeId);
+
+        return nodeId;
+    }
+
+    /// Both nodes exist, the ports are in range and the connection is new.
+    bool connectionPossible(ConnectionId const connectionId) const override
+    {
+        return _store.contains(connectionId.outNodeId) && _store.contains(connectionId.inNodeId)
+               && connectionId.outPortIndex
+                      < _store.portCount(connectionId.outNodeId, PortType::Out)
+               && connectionId.inPortIndex < _store.portCount(connectionId.inNodeId, PortType::In)
+               && !_store.containsConnection(connectionId);
+    }
+
+    void addConnection(ConnectionId const connectionId) override
+    {
+        if (_store.addConnection(connectionId))
+            Q_EMIT connectionCreated(connectionId);
+    }
+
+    bool nodeExists(NodeId const nodeId) const override { return _store.contains(nodeId); }
+
+    /// Answers the geometry and the port count roles from the store.
+    QVariant nodeData(NodeId nodeId, NodeRole role) const override
+    {
+        QVariant result;
+
+        if (!_store.contains(nodeId))
+            return result;
+
+        switch (role) {
+        case NodeRole::Position:
+            result = _store.position(nodeId);
+            break;
+
+        case NodeRole::Size:
+            result = _store.size(nodeId);
+            break;
+
+        case NodeRole::CaptionVisible:
+            result = false;
+            break;
+
+        case NodeRole::Style: {
+            auto style = StyleCollection::nodeStyle();
+            result = style.toJson().toVariantMap();
+        } break;
+
+        case NodeRole::InPortCount:
+            result = _store.portCount(nodeId, PortType::In);
+            break;
+
+        case NodeRole::OutPortCount:
+            result = _store.portCount(nodeId, PortType::Out);
+            break;
+
+        default:
+            break;
+        }
+
+        return result;
+    }
+
+    bool setNodeData(NodeId nodeId, NodeRole role, QVariant value) override
+    {
+        bool result = false;
+
+        switch (role) {
+        case NodeRole::Position:
+            result = _store.setPosition(nodeId, value.value<QPointF>());
+
+            if (result)
+                Q_EMIT nodePositionUpdated(nodeId);
+            break;
+
+        case NodeRole::Size:
+            result = _store.setSize(nodeId, value.value<QSize>());
+            break;
+
+        case NodeRole::InPortCount:
+            result = _store.setPortCount(nodeId, PortType::In, value.toUInt());
+            break;
+
+        case NodeRole::OutPortCount:
+            result = _store.setPortCount(nodeId, PortType::Out, value.toUInt());
+            break;
+
+        default:
+            break;
+        }
+
+        return result;
+    }
+
+    QPointF nodePosition(NodeId nodeId) const override { return _store.position(nodeId); }
+
+    QSize nodeSize(NodeId nodeId) const override { return _store.size(nodeId); }
+
+    PortCount portCount(NodeId nodeId, PortType portType) const override
+    {
+        return _store.portCount(nodeId, portType);
+    }
+
+    bool deleteConnection(ConnectionId const connectionId) override
+    {
+        if (!_store.removeConnection(connectionId))
+            return false;
+
+        Q_EMIT connectionDeleted(connectionId);
+
+        return true;
+    }
+
+    bool deleteNode(NodeId const nodeId) override
+    {
+        if (!_store.contains(nodeId))
+            return false;
+
+        // A copy, the deletion edits the node's list.
+        std::vector<ConnectionId> const attached = _store.connections(nodeId);
+
+        for (ConnectionId const &connectionId : attached)
+            deleteConnection(connectionId);
+
+        _store.eraseNode(nodeId);
+
+        Q_EMIT nodeDeleted(nodeId);
+
+        return true;
+    }
+
+    void clear() override
+    {
+        _store.clear();
+
+        Q_EMIT modelReset();
+    }
+
+    /// Id, position and port counts; extend the object in the derived model.
+    QJsonObject saveNode(NodeId const nodeId) const override
+    {
+        QJsonObject nodeJson;
+
+        nodeJson["id"] = static_cast<qint64>(nodeId);
+
+        QPointF const pos = _store.position(nodeId);
+
+        QJsonObject posJson;
+        posJson["x"] = pos.x();
+        posJson["y"] = pos.y();
+        nodeJson["position"] = posJson;
+
+        nodeJson["inPortCount"] = static_cast<qint64>(_store.portCount(nodeId, PortType::In));
+        nodeJson["outPortCount"] = static_cast<qint64>(_store.portCount(nodeId, PortType::Out));
+
+        return nodeJson;
+    }
+
+    /// Restores the node under its saved id.
+    /**
+   * The port counts go through `setNodeData`, so the derived model sees
+   * them; `initializeNode` is called before with an empty node type.
+   */
+    void loadNode(QJsonObject const &nodeJson) override
+    {
+        NodeId const nodeId = nodeIdFromJson(nodeJson["id"]);
+
+        _store.insertNode(nodeId);
+
+        initializeNode(nodeId, QString());
+
+        QJsonObject const posJson = nodeJson["position"].toObject();
+        _store.setPosition(nodeId, QPointF(posJson["x"].toDouble(), posJson["y"].toDouble()));
+
+        // The counts used to be saved as strings.
+        if (nodeJson.contains("inPortCount"))
+            setNodeData(nodeId, NodeRole::InPortCount, nodeJson["inPortCount"].toVariant().toUInt());
+
+        if (nodeJson.contains("outPortCount"))
+            setNodeData(nodeId,
+                        NodeRole::OutPortCount,
+                        nodeJson["outPortCount"].toVariant().toUInt());
+
+        Q_EMIT nodeCreated(nodeId);
+    }
+
+    /// All the nodes and connections in the format of `DataFlowGraphModel::save`.
+    QJsonObject save() const
+    {
+        QJsonArray nodesJsonArray;
+        _store.forEachNode(
+            [this, &nodesJsonArray](NodeId const nodeId) { nodesJsonArray.append(saveNode(nodeId)); });
+
+        QJsonArray connJsonArray;
+        _store.forEachConnection([&connJsonArray](ConnectionId const &connectionId) {
+            connJsonArray.append(toJson(connectionId));
+        });
+
+        QJsonObject sceneJson;
+        sceneJson["nodes"] = nodesJsonArray;
+        sceneJson["connections"] = connJsonArray;
+
+        return sceneJson;
+    }
+
+    void load(QJsonObject const &jsonDocument)
+    {
+        for (QJsonValue const nodeJson : jsonDocument["nodes"].toArray())
+            loadNode(nodeJson.toObject());
+
+        for (QJsonValue const connection : jsonDocument["connections"].toArray())
+            addConnection(fromJson(connection.toObject()));
+    }
+
+    /// Adds `count` ports before `first`, the following connections move along.
+    /**
+   * The port count changes in the store directly, not through `setNodeData`,
+   * and `nodeUpdated` is emitted at the end.
+   */
+    void insertPorts(NodeId const nodeId,
+                     PortType const portType,
+                     PortIndex const first,
+                     PortCount const count = 1)
+    {
+        if (count == 0 || !_store.contains(nodeId))
+            return;
+
+        portsAboutToBeInserted(nodeId, portType, first, first + count - 1);
+
+        _store.setPortCount(nodeId, portType, _store.portCount(nodeId, portType) + count);
+
+        portsInserted();
+
+        Q_EMIT nodeUpdated(nodeId);
+    }
+
+    /// Removes `count` ports starting at `first` together with their connections.
+    void removePorts(NodeId const nodeId,
+                     PortType const portType,
+                     PortIndex const first,
+                     PortCount const count = 1)
+    {
+        PortCount const portCount = _store.portCount(nodeId, portType);
+
+        if (count == 0 || first >= portCount)
+            return;
+
+        PortCount const removed = std::min(count, portCount - first);
+
+        portsAboutToBeDeleted(nodeId, portType, first, first + removed - 1);
+
+        _store.setPortCount(nodeId, portType, portCount - removed);
+
+        portsDeleted();
+
+        Q_EMIT nodeUpdated(nodeId);
+    }
+
+protected:
+    /// Called for every new or loaded node before `nodeCreated` is emitted.
+    /**
+   * Set the initial port counts or fill the payload here.
+   */
+    virtual void initializeNode(NodeId const nodeId, QString const &nodeType)
+    {
+        Q_UNUSED(nodeId);
+        Q_UNUSED(nodeType);
+    }
+
+private:
+    Store _store;
+};
+
+} // namespace QtNodes
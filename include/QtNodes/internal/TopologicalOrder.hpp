@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Definitions.hpp"
+#include "Export.hpp"
+#include "FlatHash.hpp"
+
+#include <vector>
+
+namespace QtNodes {
+
+/// Topological order of the nodes maintained while the edges change.
+/**
+ * Implements the dynamic algorithm of Pearce and Kelly: inserting an edge
+ * that already agrees with the order costs O(1), otherwise only the nodes
+ * placed between the edge's ends are visited and reordered. An edge closing
+ * a cycle is detected by the same bounded search and rejected. Removing
+ * edges never invalidates the order.
+ *
+ * Several edges between the same pair of nodes are allowed, they model the
+ * connections between different ports.
+ */
+class NODE_EDITOR_PUBLIC TopologicalOrder
+{
+public:
+    /// Places the node after all the existing ones.
+    void addNode(NodeId const nodeId);
+
+    /// Removes the node together with all its remaining edges.
+    void removeNode(NodeId const nodeId);
+
+    bool contains(NodeId const nodeId) const { return _vertices.count(nodeId) != 0; }
+
+    /// Whether the edge `from -> to` would close a cycle.
+    /**
+   * Unknown nodes never form a cycle.
+   */
+    bool createsCycle(NodeId const from, NodeId const to) const;
+
+    /// Returns false and leaves the graph unchanged when the edge closes a cycle.
+    bool addEdge(NodeId const from, NodeId const to);
+
+    /// Removes one of the edges `from -> to`, if any.
+    void removeEdge(NodeId const from, NodeId const to);
+
+    void clear();
+
+    /// Every node goes after all its upstream nodes.
+    std::vector<NodeId> order() const;
+
+    /// Rank in the order, smaller for the upstream nodes. Not contiguous.
+    std::size_t position(NodeId const nodeId) const;
+
+private:
+    struct Vertex
+    {
+        std::size_t position;
+
+        std::vector<NodeId> successors;
+
+        std::vector<NodeId> predecessors;
+    };
+
+    /// Nodes reachable from `start` placed at or before `upperBound`.
+    /**
+   * Returns false as soon as `target` is reached.
+   */
+    bool collectForward(NodeId const start,
+                        NodeId const target,
+                        std::size_t const upperBound,
+                        std::vector<NodeId> &visited) const;
+
+    /// Nodes reaching `start` placed after `lowerBound`.
+    void collectBackward(NodeId const start,
+                         std::size_t const lowerBound,
+                         std::vector<NodeId> &visited) const;
+
+    /// Drops the holes left by the removed nodes.
+    void compact();
+
+private:
+    /// Lookups do not insert, the references to the vertices stay valid
+    /// while the edges change.
+    FlatHashMap<NodeId, Vertex> _vertices;
+
+    /// Node at every position, `InvalidNodeId` for the removed ones.
+    std::vector<NodeId> _nodeAt;
+
+    std::size_t _holes = 0;
+};
+
+} // namespace QtNodes
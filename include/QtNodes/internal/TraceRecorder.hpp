@@ -0,0 +1,125 @@
+#pragma once
+
+#include "Definitions.hpp"
+#include "Export.hpp"
+#include "GraphProfiler.hpp"
+
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtCore/QString>
+#include <QtWidgets/QGraphicsScene>
+
+#include <unordered_map>
+#include <vector>
+
+class QIODevice;
+
+namespace QtNodes {
+
+class AbstractGraphModel;
+
+/// Records the profiler's events and writes them in the Chrome Trace Event format.
+/**
+ * The measurements (`setInData`, propagation, node updates, painting) become
+ * complete ("X") events, port data deliveries and scene update flushes become
+ * instant ("i") events. The output can be opened in `chrome://tracing` or in
+ * Perfetto.
+ *
+ * Recording enables the profiler; the events are kept in memory until
+ * `clear()` and at most `maxEvents()` of them are stored.
+ */
+class NODE_EDITOR_PUBLIC TraceRecorder
+    : public QObject
+    , public AbstractProfileListener
+{
+    Q_OBJECT
+
+public:
+    /// The node captions are taken from `model` when it is given.
+    TraceRecorder(GraphProfiler &profiler,
+                  AbstractGraphModel const *model = nullptr,
+                  QObject *parent = nullptr);
+
+    ~TraceRecorder() override;
+
+    void start();
+
+    void stop();
+
+    bool isRecording() const { return _recording; }
+
+    /// Reports the update flushes of the scene while recording.
+    void watchScene(QGraphicsScene *scene);
+
+    void clear();
+
+    /// 1'000'000 by default. The events after the limit are counted as dropped.
+    void setMaxEvents(std::size_t maxEvents) { _maxEvents = maxEvents; }
+
+    std::size_t maxEvents() const { return _maxEvents; }
+
+    std::size_t eventCount() const { return _events.size(); }
+
+    std::size_t droppedEventCount() const { return _dropped; }
+
+public:
+    /// Writes `{"traceEvents": [...]}`, returns false on a device error.
+    bool write(QIODevice &device) const;
+
+    bool save(QString const &fileName) const;
+
+public:
+    void measured(NodeId const nodeId,
+                  ProfileCategory const category,
+                  qint64 startNs,
+                  qint64 endNs) override;
+
+    void marked(ProfileMark const mark,
+                NodeId const nodeId,
+                PortIndex const portIndex,
+                qint64 timeNs) override;
+
+private:
+    struct Event
+    {
+        qint64 startNs;
+        qint64 durationNs; ///< -1 for the instant events.
+        NodeId nodeId;
+        PortIndex portIndex;
+        int kind; ///< `ProfileCategory` or `ProfileMark` depending on the duration.
+        int thread;
+    };
+
+    bool reserveEvent();
+
+    int currentThread();
+
+    void rememberNode(NodeId const nodeId);
+
+    void connectScene(QGraphicsScene *scene);
+
+private:
+    GraphProfiler &_profiler;
+
+    AbstractGraphModel const *_model;
+
+    bool _recording;
+
+    std::size_t _maxEvents;
+
+    std::size_t _dropped;
+
+    std::vector<Event> _events;
+
+    /// Native thread handles to the small numbers shown by the viewers.
+    std::unordered_map<Qt::HANDLE, int> _threads;
+
+    std::unordered_map<NodeId, QString> _nodeNames;
+
+    std::vector<QPointer<QGraphicsScene>> _scenes;
+
+    /// Active only while recording.
+    std::vector<QMetaObject::Connection> _sceneConnections;
+};
+
+} // namespace QtNodes
@@ -1,18 +1,136 @@
 #pragma once
 
 #include "Definitions.hpp"
+#include "SerializedItems.hpp"
 
 #include <QUndoCommand>
+#include <QtCore/QByteArray>
 #include <QtCore/QJsonObject>
 #include <QtCore/QPointF>
+#include <QtCore/QString>
 
+#include <cstddef>
+#include <memory>
 #include <unordered_set>
+#include <vector>
+
+class QTemporaryFile;
 
 namespace QtNodes {
 
 class BasicGraphicsScene;
 
-class CreateCommand : public QUndoCommand
+/// Where the payload of a `SnapshotCommand` is kept at the moment.
+enum class SnapshotStorage {
+    Live,       ///< Parsed items in memory.
+    Compressed, ///< `qCompress`-ed binary form in memory.
+    Spilled,    ///< Compressed form in a temporary file.
+    Evicted     ///< Dropped to fit the memory budget, the command is obsolete.
+};
+
+/// Limits for the memory held by the commands in the scene's undo stack.
+struct UndoMemoryBudget
+{
+    /// Payload bytes allowed in memory; 0 disables the limit.
+    std::size_t maxBytes = 0;
+
+    /// Compress the payloads of the commands further than `hotCommands` from the current index.
+    bool compressColdCommands = false;
+
+    /// Number of commands on each side of the current index kept uncompressed.
+    int hotCommands = 4;
+
+    /// Compressed payloads go to temporary files here when `maxBytes` is exceeded.
+    /**
+   * Empty string disables spilling; the oldest commands are then evicted.
+   */
+    QString spillDirectory;
+};
+
+struct UndoCommandMemory
+{
+    int index;
+
+    QString text;
+
+    SnapshotStorage storage;
+
+    std::size_t memoryBytes;
+
+    std::size_t diskBytes;
+};
+
+struct UndoMemoryStats
+{
+    std::size_t memoryBytes = 0;
+
+    std::size_t diskBytes = 0;
+
+    /// Commands holding snapshots, in the stack order.
+    std::vector<UndoCommandMemory> commands;
+};
+
+/**
+ * Base for the commands holding serialized nodes and connections.
+ * While the command is far from the current undo stack index its payload
+ * could be compressed or spilled to disk; it is restored transparently
+ * before the next undo or redo.
+ */
+class SnapshotCommand : public QUndoCommand
+{
+public:
+    ~SnapshotCommand() override;
+
+    SnapshotStorage storage() const { return _storage; }
+
+    /// Approximate number of bytes the payload occupies in memory.
+    std::size_t memoryUsage() const;
+
+    /// Number of bytes the payload occupies on disk.
+    std::size_t diskUsage() const;
+
+    /// Replaces the live items with their compressed binary form.
+    /**
+   * @returns false if there was nothing to compress.
+   */
+    bool compress();
+
+    /// Moves the compressed payload to a temporary file in `directory`.
+    bool spill(QString const &directory);
+
+    /// Drops the payload and marks the command obsolete.
+    /**
+   * `QUndoStack` skips and deletes obsolete commands once they are reached,
+   * so all the commands older than an evicted one must be evicted as well.
+   */
+    void evict();
+
+protected:
+    SnapshotCommand(BasicGraphicsScene *scene);
+
+    /// Live items, decompressed or read back from disk when necessary.
+    SerializedItems &items();
+
+protected:
+    BasicGraphicsScene *_scene;
+
+private:
+    void restore();
+
+private:
+    SnapshotStorage _storage;
+
+    SerializedItems _items;
+
+    QByteArray _compressed;
+
+    std::unique_ptr<QTemporaryFile> _spillFile;
+
+    /// Cached estimate for the live items, 0 when unknown.
+    mutable std::size_t _liveBytes;
+};
+
+class CreateCommand : public SnapshotCommand
 {
 public:
     CreateCommand(BasicGraphicsScene *scene, QString const name, QPointF const &mouseScenePos);
@@ -21,26 +139,20 @@ public:
     void redo() override;
 
 private:
-    BasicGraphicsScene *_scene;
     NodeId _nodeId;
-    QJsonObject _sceneJson;
 };
 
 /**
  * Selected scene objects are serialized and then removed from the scene.
  * The deleted elements could be restored in `undo`.
  */
-class DeleteCommand : public QUndoCommand
+class DeleteCommand : public SnapshotCommand
 {
 public:
     DeleteCommand(BasicGraphicsScene *scene);
 
     void undo() override;
     void redo() override;
-
-private:
-    BasicGraphicsScene *_scene;
-    QJsonObject _sceneJson;
 };
 
 class CopyCommand : public QUndoCommand
@@ -49,7 +161,7 @@ public:
     CopyCommand(BasicGraphicsScene *scene);
 };
 
-class PasteCommand : public QUndoCommand
+class PasteCommand : public SnapshotCommand
 {
 public:
     PasteCommand(BasicGraphicsScene *scene, QPointF const &mouseScenePos);
@@ -58,13 +170,13 @@ public:
     void redo() override;
 
 private:
-    QJsonObject takeSceneJsonFromClipboard();
-    QJsonObject makeNewNodeIdsInScene(QJsonObject const &sceneJson);
+    SerializedItems takeItemsFromClipboard();
+
+    /// Replaces the node ids in `items` with the fresh ones, in place.
+    void makeNewNodeIdsInScene(SerializedItems &items);
 
 private:
-    BasicGraphicsScene *_scene;
     QPointF const &_mouseScenePos;
-    QJsonObject _newSceneJson;
 };
 
 class DisconnectCommand : public QUndoCommand
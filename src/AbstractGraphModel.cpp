@@ -4,6 +4,91 @@
 
 namespace QtNodes {
 
+QPointF AbstractGraphModel::nodePosition(NodeId nodeId) const
+{
+    return nodeData<QPointF>(nodeId, NodeRole::Position);
+}
+
+QSize AbstractGraphModel::nodeSize(NodeId nodeId) const
+{
+    return nodeData<QSize>(nodeId, NodeRole::Size);
+}
+
+PortCount AbstractGraphModel::portCount(NodeId nodeId, PortType portType) const
+{
+    return nodeData<PortCount>(nodeId,
+                               portType == PortType::In ? NodeRole::InPortCount
+                                                        : NodeRole::OutPortCount);
+}
+
+NodeDataType AbstractGraphModel::portDataType(NodeId nodeId,
+                                              PortType portType,
+                                              PortIndex index) const
+{
+    return portData<NodeDataType>(nodeId, portType, index, PortRole::DataType);
+}
+
+NodeDataTypeId AbstractGraphModel::portDataTypeId(NodeId nodeId,
+                                                  PortType portType,
+                                                  PortIndex index) const
+{
+    QVariant const typeId = portData(nodeId, portType, index, PortRole::DataTypeId);
+
+    if (typeId.isValid())
+        return typeId.toUInt();
+
+    QVariant const type = portData(nodeId, portType, index, PortRole::DataType);
+
+    if (!type.isValid())
+        return InvalidNodeDataTypeId;
+
+    return internNodeDataType(type.value<NodeDataType>().id);
+}
+
+std::shared_ptr<NodeData> AbstractGraphModel::outPortData(NodeId nodeId, PortIndex index) const
+{
+    return portData<std::shared_ptr<NodeData>>(nodeId, PortType::Out, index, PortRole::Data);
+}
+
+void AbstractGraphModel::deleteNodes(std::vector<NodeId> const &nodeIds)
+{
+    std::unordered_set<NodeId> seen;
+    std::vector<NodeId> existing;
+    existing.reserve(nodeIds.size());
+
+    for (NodeId const nodeId : nodeIds) {
+        if (nodeExists(nodeId) && seen.insert(nodeId).second)
+            existing.push_back(nodeId);
+    }
+
+    Q_EMIT nodesAboutToBeDeleted(existing);
+
+    for (NodeId const nodeId : existing) {
+        deleteNode(nodeId);
+    }
+
+    Q_EMIT nodesDeleted(existing);
+}
+
+void AbstractGraphModel::addSubgraph(std::vector<QJsonObject> const &nodesJson,
+                                     std::vector<ConnectionId> const &connectionIds)
+{
+    for (QJsonObject const &nodeJson : nodesJson) {
+        loadNode(nodeJson);
+    }
+
+    for (ConnectionId const &connId : connectionIds) {
+        addConnection(connId);
+    }
+}
+
+void AbstractGraphModel::clear()
+{
+    std::unordered_set<NodeId> const nodeIds = allNodeIds();
+
+    deleteNodes(std::vector<NodeId>(nodeIds.begin(), nodeIds.end()));
+}
+
 void AbstractGraphModel::portsAboutToBeDeleted(NodeId const nodeId,
                                                PortType const portType,
                                                PortIndex const first,
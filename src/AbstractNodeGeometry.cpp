@@ -54,10 +54,7 @@ PortIndex AbstractNodeGeometry::checkPortHit(NodeId const nodeId,
 
     double const tolerance = 2.0 * nodeStyle.ConnectionPointDiameter;
 
-    size_t const n = _graphModel.nodeData<unsigned int>(nodeId,
-                                                        (portType == PortType::Out)
-                                                            ? NodeRole::OutPortCount
-                                                            : NodeRole::InPortCount);
+    size_t const n = _graphModel.portCount(nodeId, portType);
 
     for (unsigned int portIndex = 0; portIndex < n; ++portIndex) {
         auto pp = portPosition(nodeId, portType, portIndex);
@@ -7,6 +7,7 @@
 #include "DefaultHorizontalNodeGeometry.hpp"
 #include "DefaultNodePainter.hpp"
 #include "DefaultVerticalNodeGeometry.hpp"
+#include "GraphProfiler.hpp"
 #include "GraphicsView.hpp"
 #include "NodeGraphicsObject.hpp"
 
@@ -24,6 +25,7 @@
 #include <QtCore/QJsonObject>
 #include <QtCore/QtGlobal>
 
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 #include <unordered_set>
@@ -40,6 +42,8 @@ BasicGraphicsScene::BasicGraphicsScene(AbstractGraphModel &graphModel, QObject *
     , _connectionPainter(std::make_unique<DefaultConnectionPainter>())
     , _nodeDrag(false)
     , _undoStack(new QUndoStack(this))
+    , _droppingEvictedCommands(false)
+    , _profiler(nullptr)
     , _orientation(Qt::Horizontal)
 {
     setItemIndexMethod(QGraphicsScene::NoIndex);
@@ -64,6 +68,16 @@ BasicGraphicsScene::BasicGraphicsScene(AbstractGraphModel &graphModel, QObject *
             this,
             &BasicGraphicsScene::onNodeDeleted);
 
+    connect(&_graphModel,
+            &AbstractGraphModel::nodesAboutToBeDeleted,
+            this,
+            &BasicGraphicsScene::onNodesAboutToBeDeleted);
+
+    connect(&_graphModel,
+            &AbstractGraphModel::nodesDeleted,
+            this,
+            &BasicGraphicsScene::onNodesDeleted);
+
     connect(&_graphModel,
             &AbstractGraphModel::nodePositionUpdated,
             this,
@@ -78,6 +92,10 @@ BasicGraphicsScene::BasicGraphicsScene(AbstractGraphModel &graphModel, QObject *
 
     connect(&_graphModel, &AbstractGraphModel::modelReset, this, &BasicGraphicsScene::onModelReset);
 
+    connect(_undoStack, &QUndoStack::indexChanged, this, [this](int) {
+        enforceUndoMemoryBudget();
+    });
+
     traverseGraphAndPopulateGraphicsObjects();
 }
 
@@ -123,6 +141,136 @@ QUndoStack &BasicGraphicsScene::undoStack()
     return *_undoStack;
 }
 
+void BasicGraphicsScene::setUndoMemoryBudget(UndoMemoryBudget const &budget)
+{
+    _undoMemoryBudget = budget;
+
+    enforceUndoMemoryBudget();
+}
+
+UndoMemoryStats BasicGraphicsScene::undoMemoryStats() const
+{
+    UndoMemoryStats stats;
+
+    for (int i = 0; i < _undoStack->count(); ++i) {
+        auto snapshot = dynamic_cast<SnapshotCommand const *>(_undoStack->command(i));
+        if (!snapshot)
+            continue;
+
+        UndoCommandMemory const memory{i,
+                                       snapshot->text(),
+                                       snapshot->storage(),
+                                       snapshot->memoryUsage(),
+                                       snapshot->diskUsage()};
+
+        stats.memoryBytes += memory.memoryBytes;
+        stats.diskBytes += memory.diskBytes;
+
+        stats.commands.push_back(memory);
+    }
+
+    return stats;
+}
+
+void BasicGraphicsScene::enforceUndoMemoryBudget()
+{
+    // Called back through `indexChanged` while the evicted commands are dropped.
+    if (_droppingEvictedCommands)
+        return;
+
+    dropEvictedCommands();
+
+    UndoMemoryBudget const &budget = _undoMemoryBudget;
+
+    if (budget.maxBytes == 0 && !budget.compressColdCommands)
+        return;
+
+    int const count = _undoStack->count();
+    int const index = _undoStack->index();
+    int const hot = std::max(budget.hotCommands, 0);
+
+    // The command `i` is undone when the index is `i + 1` and redone when it is `i`.
+    auto distance = [index](int i) { return i < index ? index - 1 - i : i - index; };
+
+    // The stack owns the commands, `command()` merely hands out const pointers.
+    auto snapshotAt = [this](int i) {
+        return dynamic_cast<SnapshotCommand *>(const_cast<QUndoCommand *>(_undoStack->command(i)));
+    };
+
+    std::vector<int> cold;
+    for (int i = 0; i < count; ++i) {
+        if (distance(i) >= hot && snapshotAt(i))
+            cold.push_back(i);
+    }
+
+    // Farthest first.
+    std::sort(cold.begin(), cold.end(), [&distance](int a, int b) {
+        return distance(a) > distance(b);
+    });
+
+    if (budget.compressColdCommands) {
+        for (int i : cold) {
+            snapshotAt(i)->compress();
+        }
+    }
+
+    if (budget.maxBytes == 0)
+        return;
+
+    std::size_t total = 0;
+    for (int i = 0; i < count; ++i) {
+        if (auto snapshot = snapshotAt(i))
+            total += snapshot->memoryUsage();
+    }
+
+    if (total <= budget.maxBytes)
+        return;
+
+    if (!budget.spillDirectory.isEmpty()) {
+        for (int i : cold) {
+            if (total <= budget.maxBytes)
+                break;
+
+            SnapshotCommand *snapshot = snapshotAt(i);
+
+            std::size_t const before = snapshot->memoryUsage();
+
+            if (snapshot->spill(budget.spillDirectory))
+                total -= before;
+        }
+    }
+
+    // Evicting starts from the oldest command: an obsolete command is skipped
+    // by `QUndoStack::undo`, so nothing older than it could be undone anymore.
+    for (int i = 0; i < index - hot && total > budget.maxBytes; ++i) {
+        QUndoCommand *command = const_cast<QUndoCommand *>(_undoStack->command(i));
+
+        if (auto snapshot = dynamic_cast<SnapshotCommand *>(command)) {
+            total -= snapshot->memoryUsage();
+            snapshot->evict();
+        } else {
+            command->setObsolete(true);
+        }
+    }
+
+    dropEvictedCommands();
+}
+
+void BasicGraphicsScene::dropEvictedCommands()
+{
+    // `QUndoStack` offers no way to remove a command other than undoing it.
+    // Undoing an obsolete command deletes it without touching the model, and
+    // all the commands older than an evicted one are evicted too: once they
+    // are next in line the whole rest of the history goes at once, so
+    // `canUndo` turns false exactly where the budget cut the history.
+    _droppingEvictedCommands = true;
+
+    while (_undoStack->index() > 0 && _undoStack->command(_undoStack->index() - 1)->isObsolete())
+        _undoStack->undo();
+
+    _droppingEvictedCommands = false;
+}
+
 std::unique_ptr<ConnectionGraphicsObject> const &BasicGraphicsScene::makeDraftConnection(
     ConnectionId const incompleteConnectionId)
 {
@@ -130,21 +278,168 @@ std::unique_ptr<ConnectionGraphicsObject> const &BasicGraphicsScene::makeDraftCo
 
     _draftConnection->grabMouse();
 
+    updateDraftTargets();
+
     return _draftConnection;
 }
 
 void BasicGraphicsScene::resetDraftConnection()
 {
     _draftConnection.reset();
+
+    updateDraftTargets();
+}
+
+bool BasicGraphicsScene::connectionPossible(ConnectionId const connectionId)
+{
+    if (!_draftConnection)
+        return _graphModel.connectionPossible(connectionId);
+
+    auto it = _connectionPossibleCache.find(connectionId);
+    if (it != _connectionPossibleCache.end())
+        return it->second;
+
+    bool const possible = _graphModel.connectionPossible(connectionId);
+
+    _connectionPossibleCache[connectionId] = possible;
+
+    return possible;
+}
+
+bool BasicGraphicsScene::isDraftTarget(NodeId const nodeId,
+                                       PortType const portType,
+                                       PortIndex const portIndex) const
+{
+    if (!_draftConnection || portType != _draftConnection->connectionState().requiredPort())
+        return false;
+
+    ConnectionId const draftId = _draftConnection->connectionId();
+
+    // The draft's own node is never indexed.
+    if (nodeId == getNodeId(oppositePort(portType), draftId))
+        return false;
+
+    auto it = _connectionPossibleCache.find(makeCompleteConnectionId(draftId, nodeId, portIndex));
+
+    return it != _connectionPossibleCache.end() && it->second;
+}
+
+PortLocation const *BasicGraphicsScene::snapTarget(QPointF const &scenePos) const
+{
+    return _draftTargets.nearest(scenePos, _draftTargets.cellSize());
+}
+
+void BasicGraphicsScene::setSnapRadius(double const radius)
+{
+    _draftTargets.setCellSize(radius);
+}
+
+void BasicGraphicsScene::updateDraftTargets()
+{
+    _connectionPossibleCache.clear();
+
+    // Repaints the ports highlighted so far.
+    for (NodeId const nodeId : _draftTargets.nodeIds()) {
+        if (auto ngo = nodeGraphicsObject(nodeId))
+            ngo->update();
+    }
+
+    _draftTargets.clear();
+
+    if (!_draftConnection)
+        return;
+
+    for (auto const &entry : _nodeGraphicsObjects) {
+        if (indexDraftTargets(entry.first))
+            entry.second->update();
+    }
+}
+
+void BasicGraphicsScene::updateDraftTargets(NodeId const nodeId, bool const portsChanged)
+{
+    if (!_draftConnection)
+        return;
+
+    PortType const requiredPort = _draftConnection->connectionState().requiredPort();
+
+    if (requiredPort == PortType::None)
+        return;
+
+    ConnectionId const draftId = _draftConnection->connectionId();
+
+    if (portsChanged) {
+        // The draft's own ports decide what every other port accepts.
+        if (nodeId == getNodeId(oppositePort(requiredPort), draftId)) {
+            updateDraftTargets();
+            return;
+        }
+
+        // Stale answers past a shrunk port count are never asked for.
+        PortCount const n = _graphModel.portCount(nodeId, requiredPort);
+
+        for (PortIndex portIndex = 0; portIndex < n; ++portIndex)
+            _connectionPossibleCache.erase(makeCompleteConnectionId(draftId, nodeId, portIndex));
+    }
+
+    bool const wasTarget = _draftTargets.contains(nodeId);
+
+    _draftTargets.removeNode(nodeId);
+
+    bool const isTarget = indexDraftTargets(nodeId);
+
+    if (wasTarget || isTarget) {
+        if (auto ngo = nodeGraphicsObject(nodeId))
+            ngo->update();
+    }
+}
+
+bool BasicGraphicsScene::indexDraftTargets(NodeId const nodeId)
+{
+    PortType const requiredPort = _draftConnection->connectionState().requiredPort();
+
+    if (requiredPort == PortType::None)
+        return false;
+
+    ConnectionId const draftId = _draftConnection->connectionId();
+
+    // `NodeConnectionInteraction::canConnect` forbids connecting a node to itself.
+    if (nodeId == getNodeId(oppositePort(requiredPort), draftId))
+        return false;
+
+    NodeGraphicsObject *ngo = nodeGraphicsObject(nodeId);
+
+    if (!ngo)
+        return false;
+
+    QTransform const sceneTransform = ngo->sceneTransform();
+
+    bool indexed = false;
+
+    PortCount const n = _graphModel.portCount(nodeId, requiredPort);
+
+    for (PortIndex portIndex = 0; portIndex < n; ++portIndex) {
+        if (!connectionPossible(makeCompleteConnectionId(draftId, nodeId, portIndex)))
+            continue;
+
+        QPointF const scenePos = _nodeGeometry->portScenePosition(nodeId,
+                                                                  requiredPort,
+                                                                  portIndex,
+                                                                  sceneTransform);
+
+        _draftTargets.insert(PortLocation{nodeId, requiredPort, portIndex, scenePos});
+
+        indexed = true;
+    }
+
+    return indexed;
 }
 
 void BasicGraphicsScene::clearScene()
 {
+    // Not `clear()`: the scene keeps its other items.
     auto const &allNodeIds = graphModel().allNodeIds();
 
-    for (auto nodeId : allNodeIds) {
-        graphModel().deleteNode(nodeId);
-    }
+    graphModel().deleteNodes(std::vector<NodeId>(allNodeIds.begin(), allNodeIds.end()));
 }
 
 NodeGraphicsObject *BasicGraphicsScene::nodeGraphicsObject(NodeId nodeId)
@@ -199,8 +494,11 @@ void BasicGraphicsScene::traverseGraphAndPopulateGraphicsObjects()
     auto allNodeIds = _graphModel.allNodeIds();
 
     // First create all the nodes.
+    _nodeGraphicsObjects.reserve(allNodeIds.size());
+
     for (NodeId const nodeId : allNodeIds) {
-        _nodeGraphicsObjects[nodeId] = std::make_unique<NodeGraphicsObject>(*this, nodeId);
+        auto ngo = std::make_unique<NodeGraphicsObject>(*this, nodeId);
+        _nodeGraphicsObjects[nodeId] = std::move(ngo);
     }
 
     // Then for each node check output connections and insert them.
@@ -211,8 +509,8 @@ void BasicGraphicsScene::traverseGraphAndPopulateGraphicsObjects()
             auto const &outConnectionIds = _graphModel.connections(nodeId, PortType::Out, index);
 
             for (auto cid : outConnectionIds) {
-                _connectionGraphicsObjects[cid] = std::make_unique<ConnectionGraphicsObject>(*this,
-                                                                                             cid);
+                auto cgo = std::make_unique<ConnectionGraphicsObject>(*this, cid);
+                _connectionGraphicsObjects[cid] = std::move(cgo);
             }
         }
     }
@@ -230,30 +528,41 @@ void BasicGraphicsScene::updateAttachedNodes(ConnectionId const connectionId,
 
 void BasicGraphicsScene::onConnectionDeleted(ConnectionId const connectionId)
 {
-    auto it = _connectionGraphicsObjects.find(connectionId);
-    if (it != _connectionGraphicsObjects.end()) {
-        _connectionGraphicsObjects.erase(it);
-    }
-
     // TODO: do we need it?
     if (_draftConnection && _draftConnection->connectionId() == connectionId) {
         _draftConnection.reset();
     }
 
+    auto it = _connectionGraphicsObjects.find(connectionId);
+
+    // Already removed by `onNodesAboutToBeDeleted`.
+    if (it == _connectionGraphicsObjects.end())
+        return;
+
+    _connectionGraphicsObjects.erase(it);
+
     updateAttachedNodes(connectionId, PortType::Out);
     updateAttachedNodes(connectionId, PortType::In);
 
+    // The occupancy of the two ends' ports has changed.
+    updateDraftTargets(connectionId.outNodeId, true);
+    updateDraftTargets(connectionId.inNodeId, true);
+
     Q_EMIT modified(this);
 }
 
 void BasicGraphicsScene::onConnectionCreated(ConnectionId const connectionId)
 {
-    _connectionGraphicsObjects[connectionId]
-        = std::make_unique<ConnectionGraphicsObject>(*this, connectionId);
+    auto cgo = std::make_unique<ConnectionGraphicsObject>(*this, connectionId);
+    _connectionGraphicsObjects[connectionId] = std::move(cgo);
 
     updateAttachedNodes(connectionId, PortType::Out);
     updateAttachedNodes(connectionId, PortType::In);
 
+    // The occupancy of the two ends' ports has changed.
+    updateDraftTargets(connectionId.outNodeId, true);
+    updateDraftTargets(connectionId.inNodeId, true);
+
     Q_EMIT modified(this);
 }
 
@@ -263,13 +572,59 @@ void BasicGraphicsScene::onNodeDeleted(NodeId const nodeId)
     if (it != _nodeGraphicsObjects.end()) {
         _nodeGraphicsObjects.erase(it);
 
+        // Without the graphics object the node's entries are only removed,
+        // the model is not asked about the gone node.
+        updateDraftTargets(nodeId, false);
+
         Q_EMIT modified(this);
     }
 }
 
+void BasicGraphicsScene::onNodesAboutToBeDeleted(std::vector<NodeId> const &nodeIds)
+{
+    FlatHashSet<NodeId> deleted;
+    deleted.reserve(nodeIds.size());
+
+    for (NodeId const nodeId : nodeIds) {
+        deleted.insert(nodeId);
+    }
+
+    for (NodeId const nodeId : nodeIds) {
+        for (ConnectionId const &connectionId : _graphModel.allConnectionIds(nodeId)) {
+            // Connections inside the set are listed at both their nodes.
+            if (_connectionGraphicsObjects.erase(connectionId) == 0)
+                continue;
+
+            // Only the surviving ends are redrawn.
+            if (deleted.count(connectionId.outNodeId) == 0)
+                updateAttachedNodes(connectionId, PortType::Out);
+
+            if (deleted.count(connectionId.inNodeId) == 0)
+                updateAttachedNodes(connectionId, PortType::In);
+        }
+
+        _nodeGraphicsObjects.erase(nodeId);
+    }
+}
+
+void BasicGraphicsScene::onNodesDeleted(std::vector<NodeId> const &nodeIds)
+{
+    if (nodeIds.empty())
+        return;
+
+    // One rebuild per batch, the surviving ends of the deleted connections
+    // are not tracked.
+    updateDraftTargets();
+
+    Q_EMIT modified(this);
+}
+
 void BasicGraphicsScene::onNodeCreated(NodeId const nodeId)
 {
-    _nodeGraphicsObjects[nodeId] = std::make_unique<NodeGraphicsObject>(*this, nodeId);
+    auto ngo = std::make_unique<NodeGraphicsObject>(*this, nodeId);
+    _nodeGraphicsObjects[nodeId] = std::move(ngo);
+
+    updateDraftTargets(nodeId, true);
 
     Q_EMIT modified(this);
 }
@@ -282,10 +637,15 @@ void BasicGraphicsScene::onNodePositionUpdated(NodeId const nodeId)
         node->update();
         _nodeDrag = true;
     }
+
+    // The answers stay, only the positions move.
+    updateDraftTargets(nodeId, false);
 }
 
 void BasicGraphicsScene::onNodeUpdated(NodeId const nodeId)
 {
+    ScopedProfile profile(_profiler, nodeId, ProfileCategory::NodeUpdate);
+
     auto node = nodeGraphicsObject(nodeId);
 
     if (node) {
@@ -297,6 +657,9 @@ void BasicGraphicsScene::onNodeUpdated(NodeId const nodeId)
         node->update();
         node->moveConnections();
     }
+
+    // The port counts or types may have changed.
+    updateDraftTargets(nodeId, true);
 }
 
 void BasicGraphicsScene::onNodeClicked(NodeId const nodeId)
@@ -310,12 +673,18 @@ void BasicGraphicsScene::onNodeClicked(NodeId const nodeId)
 
 void BasicGraphicsScene::onModelReset()
 {
+    // The draft is an item of the scene, `clear()` would delete it under the
+    // owning pointer.
+    _draftConnection.reset();
+
     _connectionGraphicsObjects.clear();
     _nodeGraphicsObjects.clear();
 
     clear();
 
     traverseGraphAndPopulateGraphicsObjects();
+
+    updateDraftTargets();
 }
 
 } // namespace QtNodes
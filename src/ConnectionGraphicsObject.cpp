@@ -7,6 +7,7 @@
 #include "ConnectionIdUtils.hpp"
 #include "ConnectionState.hpp"
 #include "ConnectionStyle.hpp"
+#include "GraphProfiler.hpp"
 #include "NodeConnectionInteraction.hpp"
 #include "NodeGraphicsObject.hpp"
 #include "StyleCollection.hpp"
@@ -196,6 +197,8 @@ void ConnectionGraphicsObject::paint(QPainter *painter,
     if (!scene())
         return;
 
+    ScopedProfile profile(nodeScene()->profiler(), InvalidNodeId, ProfileCategory::PaintConnection);
+
     painter->setClipRect(option->exposedRect);
 
     nodeScene()->connectionPainter().paint(painter, *this);
@@ -210,8 +213,23 @@ void ConnectionGraphicsObject::mouseMoveEvent(QGraphicsSceneMouseEvent *event)
 {
     prepareGeometryChange();
 
-    auto view = static_cast<QGraphicsView *>(event->widget());
-    auto ngo = locateNodeAt(event->scenePos(), *nodeScene(), view->transform());
+    // The accepting ports were indexed when the draft was made, the item
+    // lookup is only needed away from them.
+    QPointF endPoint = event->pos();
+
+    PortLocation const *target = nodeScene()->snapTarget(event->scenePos());
+
+    NodeGraphicsObject *ngo = nullptr;
+
+    if (target) {
+        ngo = nodeScene()->nodeGraphicsObject(target->nodeId);
+        endPoint = mapFromScene(target->scenePos);
+    } else {
+        // A node without accepting ports still reacts to the hovering draft.
+        auto view = static_cast<QGraphicsView *>(event->widget());
+        ngo = locateNodeAt(event->scenePos(), *nodeScene(), view->transform());
+    }
+
     if (ngo) {
         ngo->reactToConnection(this);
 
@@ -225,7 +243,7 @@ void ConnectionGraphicsObject::mouseMoveEvent(QGraphicsSceneMouseEvent *event)
     auto requiredPort = _connectionState.requiredPort();
 
     if (requiredPort != PortType::None) {
-        setEndPoint(requiredPort, event->pos());
+        setEndPoint(requiredPort, endPoint);
     }
 
     //-------------------
@@ -246,7 +264,12 @@ void ConnectionGraphicsObject::mouseReleaseEvent(QGraphicsSceneMouseEvent *event
 
     Q_ASSERT(view);
 
-    auto ngo = locateNodeAt(event->scenePos(), *nodeScene(), view->transform());
+    // The loose end sits on the snapped port, which may lie outside the node.
+    PortLocation const *target = nodeScene()->snapTarget(event->scenePos());
+
+    NodeGraphicsObject *ngo = target
+                                  ? nodeScene()->nodeGraphicsObject(target->nodeId)
+                                  : locateNodeAt(event->scenePos(), *nodeScene(), view->transform());
 
     bool wasConnected = false;
 
@@ -8,6 +8,7 @@
 
 #include <QDebug>
 
+#include <cmath>
 #include <random>
 
 using QtNodes::ConnectionStyle;
@@ -103,6 +104,25 @@ void ConnectionStyle::setConnectionStyle(QString jsonText)
         values[#variable] = variable; \
     }
 
+namespace {
+
+/// Same format as `CONNECTION_STYLE_READ_COLOR`: a name or an RGB array.
+QColor readColor(QJsonValue const &value)
+{
+    if (value.isArray()) {
+        QJsonArray const colorArray = value.toArray();
+
+        if (colorArray.size() < 3)
+            return QColor();
+
+        return QColor(colorArray[0].toInt(), colorArray[1].toInt(), colorArray[2].toInt());
+    }
+
+    return QColor(value.toString());
+}
+
+} // namespace
+
 void ConnectionStyle::loadJson(QJsonObject const &json)
 {
     QJsonValue nodeStyleValues = json["ConnectionStyle"];
@@ -120,6 +140,17 @@ void ConnectionStyle::loadJson(QJsonObject const &json)
     CONNECTION_STYLE_READ_FLOAT(obj, PointDiameter);
 
     CONNECTION_STYLE_READ_BOOL(obj, UseDataDefinedColors);
+
+    QJsonObject const dataTypeColors = obj["DataTypeColors"].toObject();
+
+    for (auto it = dataTypeColors.begin(); it != dataTypeColors.end(); ++it) {
+        QColor const color = readColor(it.value());
+
+        if (color.isValid())
+            _registeredDataTypeColors[it.key()] = color;
+    }
+
+    _dataTypeColors.clear();
 }
 
 QJsonObject ConnectionStyle::toJson() const
@@ -138,6 +169,15 @@ QJsonObject ConnectionStyle::toJson() const
 
     CONNECTION_STYLE_WRITE_BOOL(obj, UseDataDefinedColors);
 
+    if (!_registeredDataTypeColors.empty()) {
+        QJsonObject dataTypeColors;
+
+        for (auto const &p : _registeredDataTypeColors)
+            dataTypeColors[p.first] = p.second.name();
+
+        obj["DataTypeColors"] = dataTypeColors;
+    }
+
     QJsonObject root;
     root["ConnectionStyle"] = obj;
 
@@ -154,7 +194,65 @@ QColor ConnectionStyle::normalColor() const
     return NormalColor;
 }
 
+QColor ConnectionStyle::normalColor(NodeDataTypeId typeId) const
+{
+    if (typeId == InvalidNodeDataTypeId)
+        return NormalColor;
+
+    if (typeId >= _dataTypeColors.size())
+        _dataTypeColors.resize(typeId + 1);
+
+    QColor &color = _dataTypeColors[typeId];
+
+    if (!color.isValid()) {
+        QString const typeString = nodeDataTypeString(typeId);
+
+        auto it = _registeredDataTypeColors.find(typeString);
+        if (it != _registeredDataTypeColors.end()) {
+            color = it->second;
+        } else {
+            it = _paletteDataTypeColors.find(typeString);
+
+            color = (it != _paletteDataTypeColors.end()) ? it->second
+                                                         : generatedColor(typeString);
+        }
+    }
+
+    return color;
+}
+
 QColor ConnectionStyle::normalColor(QString typeId) const
+{
+    return normalColor(internNodeDataType(typeId));
+}
+
+void ConnectionStyle::setDataTypeColor(QString const &typeId, QColor const &color)
+{
+    _registeredDataTypeColors[typeId] = color;
+
+    _dataTypeColors.clear();
+}
+
+void ConnectionStyle::setDataTypePalette(QStringList const &typeIds)
+{
+    _paletteDataTypeColors.clear();
+
+    // Steps by the golden angle keep the neighbouring hues apart for any
+    // number of the types.
+    double const goldenAngle = 137.50776405;
+
+    double hue = 0.0;
+
+    for (QString const &typeId : typeIds) {
+        _paletteDataTypeColors[typeId] = QColor::fromHsl(static_cast<int>(hue), 160, 160);
+
+        hue = std::fmod(hue + goldenAngle, 360.0);
+    }
+
+    _dataTypeColors.clear();
+}
+
+QColor ConnectionStyle::generatedColor(QString const &typeId)
 {
     std::size_t hash = qHash(typeId);
 
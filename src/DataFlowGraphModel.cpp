@@ -1,47 +1,110 @@
 #include "DataFlowGraphModel.hpp"
 #include "ConnectionIdHash.hpp"
 
-#include <QJsonArray>
-
+#include <QtCore/QDebug>
+#include <QtCore/QJsonArray>
+#include <QtCore/QRunnable>
+#include <QtCore/QScopedValueRollback>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+#include <QtCore/QTimer>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
 #include <stdexcept>
+#include <string>
+#include <utility>
 
 namespace QtNodes {
 
+namespace {
+
+/// A node read from json but not yet installed into the graph model.
+struct PendingNode
+{
+    NodeId nodeId;
+    QPointF pos;
+    QJsonObject internalDataJson;
+    std::unique_ptr<NodeDelegateModel> model;
+};
+
+/// Each task keeps taking the next unprocessed node until none is left.
+class PreloadTask : public QRunnable
+{
+public:
+    PreloadTask(std::vector<PendingNode> &nodes,
+                std::atomic<std::size_t> &next,
+                std::exception_ptr &error,
+                std::mutex &errorMutex)
+        : _nodes(nodes)
+        , _next(next)
+        , _error(error)
+        , _errorMutex(errorMutex)
+    {}
+
+    void run() override
+    {
+        try {
+            for (std::size_t i = _next++; i < _nodes.size(); i = _next++) {
+                _nodes[i].model->preload(_nodes[i].internalDataJson);
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(_errorMutex);
+            if (!_error)
+                _error = std::current_exception();
+
+            // Makes other tasks stop as well.
+            _next = _nodes.size();
+        }
+    }
+
+private:
+    std::vector<PendingNode> &_nodes;
+    std::atomic<std::size_t> &_next;
+    std::exception_ptr &_error;
+    std::mutex &_errorMutex;
+};
+
+} // namespace
+
 DataFlowGraphModel::DataFlowGraphModel(std::shared_ptr<NodeDelegateModelRegistry> registry)
     : _registry(std::move(registry))
-    , _nextNodeId{0}
+    , _parallelLoadEnabled{false}
+    , _propagationSuppressed{false}
+    , _snapshotsEnabled{false}
+    , _snapshotScheduled{false}
+    , _snapshotAllDirty{true}
 {}
 
 std::unordered_set<NodeId> DataFlowGraphModel::allNodeIds() const
 {
     std::unordered_set<NodeId> nodeIds;
-    for_each(_models.begin(), _models.end(), [&nodeIds](auto const &p) { nodeIds.insert(p.first); });
+    nodeIds.reserve(_nodes.count());
+
+    _nodes.forEach([&nodeIds](NodeId const nodeId, NodeDelegateModel &) { nodeIds.insert(nodeId); });
 
     return nodeIds;
 }
 
 std::unordered_set<ConnectionId> DataFlowGraphModel::allConnectionIds(NodeId const nodeId) const
 {
-    std::unordered_set<ConnectionId> result;
-
-    std::copy_if(_connectivity.begin(),
-                 _connectivity.end(),
-                 std::inserter(result, std::end(result)),
-                 [&nodeId](ConnectionId const &cid) {
-                     return cid.inNodeId == nodeId || cid.outNodeId == nodeId;
-                 });
+    std::vector<ConnectionId> const &attached = _nodes.connections(nodeId);
 
-    return result;
+    return std::unordered_set<ConnectionId>(attached.begin(), attached.end());
 }
 
 std::unordered_set<ConnectionId> DataFlowGraphModel::connections(NodeId nodeId,
                                                                  PortType portType,
                                                                  PortIndex portIndex) const
 {
+    std::vector<ConnectionId> const &attached = _nodes.connections(nodeId);
+
     std::unordered_set<ConnectionId> result;
 
-    std::copy_if(_connectivity.begin(),
-                 _connectivity.end(),
+    std::copy_if(attached.begin(),
+                 attached.end(),
                  std::inserter(result, std::end(result)),
                  [&portType, &portIndex, &nodeId](ConnectionId const &cid) {
                      return (getNodeId(portType, cid) == nodeId
@@ -58,59 +121,77 @@ bool DataFlowGraphModel::connectionExists(ConnectionId const connectionId) const
 
 NodeId DataFlowGraphModel::addNode(QString const nodeType)
 {
-    std::unique_ptr<NodeDelegateModel> model = _registry->create(nodeType);
+    return addNode(_registry->modelTypeId(nodeType));
+}
+
+NodeId DataFlowGraphModel::addNode(ModelTypeId const modelTypeId)
+{
+    std::unique_ptr<NodeDelegateModel> model = _registry->create(modelTypeId);
 
     if (model) {
         NodeId newId = newNodeId();
 
-        connect(model.get(),
-                &NodeDelegateModel::dataUpdated,
-                [newId, this](PortIndex const portIndex) {
-                    onOutPortDataUpdated(newId, portIndex);
-                });
-
-        connect(model.get(),
-                &NodeDelegateModel::portsAboutToBeDeleted,
-                this,
-                [newId, this](PortType const portType, PortIndex const first, PortIndex const last) {
-                    portsAboutToBeDeleted(newId, portType, first, last);
-                });
+        installModel(newId, std::move(model));
 
-        connect(model.get(),
-                &NodeDelegateModel::portsDeleted,
-                this,
-                &DataFlowGraphModel::portsDeleted);
+        return newId;
+    }
 
-        connect(model.get(),
-                &NodeDelegateModel::portsAboutToBeInserted,
-                this,
-                [newId, this](PortType const portType, PortIndex const first, PortIndex const last) {
-                    portsAboutToBeInserted(newId, portType, first, last);
-                });
+    return InvalidNodeId;
+}
 
-        connect(model.get(),
-                &NodeDelegateModel::portsInserted,
-                this,
-                &DataFlowGraphModel::portsInserted);
+void DataFlowGraphModel::installModel(NodeId const nodeId, std::unique_ptr<NodeDelegateModel> model)
+{
+    // Every connection has `this` as the context, `NodeDelegateModelRegistry::release`
+    // cuts exactly these before pooling the model.
+    connect(model.get(),
+            &NodeDelegateModel::dataUpdated,
+            this,
+            [nodeId, this](PortIndex const portIndex) { onOutPortDataUpdated(nodeId, portIndex); });
+
+    connect(model.get(),
+            &NodeDelegateModel::portsAboutToBeDeleted,
+            this,
+            [nodeId, this](PortType const portType, PortIndex const first, PortIndex const last) {
+                portsAboutToBeDeleted(nodeId, portType, first, last);
+            });
+
+    connect(model.get(),
+            &NodeDelegateModel::portsDeleted,
+            this,
+            &DataFlowGraphModel::portsDeleted);
+
+    connect(model.get(),
+            &NodeDelegateModel::portsAboutToBeInserted,
+            this,
+            [nodeId, this](PortType const portType, PortIndex const first, PortIndex const last) {
+                portsAboutToBeInserted(nodeId, portType, first, last);
+            });
+
+    connect(model.get(),
+            &NodeDelegateModel::portsInserted,
+            this,
+            &DataFlowGraphModel::portsInserted);
+
+    // The port counts are part of the snapshots.
+    for (auto signal : {&NodeDelegateModel::portsDeleted, &NodeDelegateModel::portsInserted}) {
+        connect(model.get(), signal, this, [nodeId, this]() { markSnapshotDirty(nodeId); });
+    }
 
-        _models[newId] = std::move(model);
+    _nodes.insert(nodeId, std::move(model));
 
-        Q_EMIT nodeCreated(newId);
+    _topology.addNode(nodeId);
 
-        return newId;
-    }
+    markSnapshotDirty(nodeId);
 
-    return InvalidNodeId;
+    Q_EMIT nodeCreated(nodeId);
 }
 
 bool DataFlowGraphModel::connectionPossible(ConnectionId const connectionId) const
 {
-    auto getDataType = [&](PortType const portType) {
-        return portData(getNodeId(portType, connectionId),
-                        portType,
-                        getPortIndex(portType, connectionId),
-                        PortRole::DataType)
-            .value<NodeDataType>();
+    auto getDataTypeId = [&](PortType const portType) {
+        return portDataTypeId(getNodeId(portType, connectionId),
+                              portType,
+                              getPortIndex(portType, connectionId));
     };
 
     auto portVacant = [&](PortType const portType) {
@@ -124,37 +205,31 @@ bool DataFlowGraphModel::connectionPossible(ConnectionId const connectionId) con
         return connected.empty() || (policy == ConnectionPolicy::Many);
     };
 
-    return getDataType(PortType::Out).id == getDataType(PortType::In).id
-           && portVacant(PortType::Out) && portVacant(PortType::In);
+    NodeDataTypeId const outTypeId = getDataTypeId(PortType::Out);
+
+    return outTypeId != InvalidNodeDataTypeId && outTypeId == getDataTypeId(PortType::In)
+           && portVacant(PortType::Out) && portVacant(PortType::In)
+           && !_topology.createsCycle(connectionId.outNodeId, connectionId.inNodeId);
 }
 
 void DataFlowGraphModel::addConnection(ConnectionId const connectionId)
 {
-    _connectivity.insert(connectionId);
+    insertConnection(connectionId);
 
     sendConnectionCreation(connectionId);
 
-    QVariant const portDataToPropagate = portData(connectionId.outNodeId,
-                                                  PortType::Out,
-                                                  connectionId.outPortIndex,
-                                                  PortRole::Data);
-
-    setPortData(connectionId.inNodeId,
-                PortType::In,
-                connectionId.inPortIndex,
-                portDataToPropagate,
-                PortRole::Data);
+    setInPortData(connectionId.inNodeId,
+                  connectionId.inPortIndex,
+                  outPortData(connectionId.outNodeId, connectionId.outPortIndex));
 }
 
 void DataFlowGraphModel::sendConnectionCreation(ConnectionId const connectionId)
 {
     Q_EMIT connectionCreated(connectionId);
 
-    auto iti = _models.find(connectionId.inNodeId);
-    auto ito = _models.find(connectionId.outNodeId);
-    if (iti != _models.end() && ito != _models.end()) {
-        auto &modeli = iti->second;
-        auto &modelo = ito->second;
+    NodeDelegateModel *modeli = _nodes.model(connectionId.inNodeId);
+    NodeDelegateModel *modelo = _nodes.model(connectionId.outNodeId);
+    if (modeli && modelo) {
         modeli->inputConnectionCreated(connectionId);
         modelo->outputConnectionCreated(connectionId);
     }
@@ -164,11 +239,9 @@ void DataFlowGraphModel::sendConnectionDeletion(ConnectionId const connectionId)
 {
     Q_EMIT connectionDeleted(connectionId);
 
-    auto iti = _models.find(connectionId.inNodeId);
-    auto ito = _models.find(connectionId.outNodeId);
-    if (iti != _models.end() && ito != _models.end()) {
-        auto &modeli = iti->second;
-        auto &modelo = ito->second;
+    NodeDelegateModel *modeli = _nodes.model(connectionId.inNodeId);
+    NodeDelegateModel *modelo = _nodes.model(connectionId.outNodeId);
+    if (modeli && modelo) {
         modeli->inputConnectionDeleted(connectionId);
         modelo->outputConnectionDeleted(connectionId);
     }
@@ -176,30 +249,28 @@ void DataFlowGraphModel::sendConnectionDeletion(ConnectionId const connectionId)
 
 bool DataFlowGraphModel::nodeExists(NodeId const nodeId) const
 {
-    return (_models.find(nodeId) != _models.end());
+    return _nodes.contains(nodeId);
 }
 
 QVariant DataFlowGraphModel::nodeData(NodeId nodeId, NodeRole role) const
 {
     QVariant result;
 
-    auto it = _models.find(nodeId);
-    if (it == _models.end())
+    NodeDelegateModel *model = _nodes.model(nodeId);
+    if (!model)
         return result;
 
-    auto &model = it->second;
-
     switch (role) {
     case NodeRole::Type:
         result = model->name();
         break;
 
     case NodeRole::Position:
-        result = _nodeGeometryData[nodeId].pos;
+        result = _nodes.position(nodeId);
         break;
 
     case NodeRole::Size:
-        result = _nodeGeometryData[nodeId].size;
+        result = _nodes.size(nodeId);
         break;
 
     case NodeRole::CaptionVisible:
@@ -218,7 +289,7 @@ QVariant DataFlowGraphModel::nodeData(NodeId nodeId, NodeRole role) const
     case NodeRole::InternalData: {
         QJsonObject nodeJson;
 
-        nodeJson["internal-data"] = _models.at(nodeId)->save();
+        nodeJson["internal-data"] = model->save();
 
         result = nodeJson.toVariantMap();
         break;
@@ -243,9 +314,9 @@ QVariant DataFlowGraphModel::nodeData(NodeId nodeId, NodeRole role) const
 
 NodeFlags DataFlowGraphModel::nodeFlags(NodeId nodeId) const
 {
-    auto it = _models.find(nodeId);
+    NodeDelegateModel const *model = _nodes.model(nodeId);
 
-    if (it != _models.end() && it->second->resizable())
+    if (model && model->resizable())
         return NodeFlag::Resizable;
 
     return NodeFlag::NoFlags;
@@ -263,16 +334,21 @@ bool DataFlowGraphModel::setNodeData(NodeId nodeId, NodeRole role, QVariant valu
     case NodeRole::Type:
         break;
     case NodeRole::Position: {
-        _nodeGeometryData[nodeId].pos = value.value<QPointF>();
+        // Unknown ids are ignored instead of allocating an entry for them.
+        if (_nodes.setPosition(nodeId, value.value<QPointF>())) {
+            markSnapshotDirty(nodeId);
 
-        Q_EMIT nodePositionUpdated(nodeId);
+            Q_EMIT nodePositionUpdated(nodeId);
 
-        result = true;
+            result = true;
+        }
     } break;
 
     case NodeRole::Size: {
-        _nodeGeometryData[nodeId].size = value.value<QSize>();
-        result = true;
+        result = _nodes.setSize(nodeId, value.value<QSize>());
+
+        if (result)
+            markSnapshotDirty(nodeId);
     } break;
 
     case NodeRole::CaptionVisible:
@@ -307,12 +383,10 @@ QVariant DataFlowGraphModel::portData(NodeId nodeId,
 {
     QVariant result;
 
-    auto it = _models.find(nodeId);
-    if (it == _models.end())
+    NodeDelegateModel *model = _nodes.model(nodeId);
+    if (!model)
         return result;
 
-    auto &model = it->second;
-
     switch (role) {
     case PortRole::Data:
         if (portType == PortType::Out)
@@ -323,6 +397,10 @@ QVariant DataFlowGraphModel::portData(NodeId nodeId,
         result = QVariant::fromValue(model->dataType(portType, portIndex));
         break;
 
+    case PortRole::DataTypeId:
+        result = model->portDataTypeId(portType, portIndex);
+        break;
+
     case PortRole::ConnectionPolicyRole:
         result = QVariant::fromValue(model->portConnectionPolicy(portType, portIndex));
         break;
@@ -343,24 +421,10 @@ QVariant DataFlowGraphModel::portData(NodeId nodeId,
 bool DataFlowGraphModel::setPortData(
     NodeId nodeId, PortType portType, PortIndex portIndex, QVariant const &value, PortRole role)
 {
-    Q_UNUSED(nodeId);
-
-    QVariant result;
-
-    auto it = _models.find(nodeId);
-    if (it == _models.end())
-        return false;
-
-    auto &model = it->second;
-
     switch (role) {
     case PortRole::Data:
-        if (portType == PortType::In) {
-            model->setInData(value.value<std::shared_ptr<NodeData>>(), portIndex);
-
-            // Triggers repainting on the scene.
-            Q_EMIT inPortDataWasSet(nodeId, portType, portIndex);
-        }
+        if (portType == PortType::In)
+            setInPortData(nodeId, portIndex, value.value<std::shared_ptr<NodeData>>());
         break;
 
     default:
@@ -370,18 +434,109 @@ bool DataFlowGraphModel::setPortData(
     return false;
 }
 
-bool DataFlowGraphModel::deleteConnection(ConnectionId const connectionId)
+void DataFlowGraphModel::setInPortData(NodeId const nodeId,
+                                       PortIndex const portIndex,
+                                       std::shared_ptr<NodeData> const &data)
 {
-    bool disconnected = false;
+    NodeDelegateModel *model = _nodes.model(nodeId);
+    if (!model)
+        return;
 
-    auto it = _connectivity.find(connectionId);
+    _profiler.mark(ProfileMark::PortDataSet, nodeId, portIndex);
+
+    {
+        ScopedProfile profile(&_profiler, nodeId, ProfileCategory::SetInData);
+
+        model->setInData(data, portIndex);
+    }
+
+    // Triggers repainting on the scene.
+    Q_EMIT inPortDataWasSet(nodeId, PortType::In, portIndex);
+}
+
+QPointF DataFlowGraphModel::nodePosition(NodeId nodeId) const
+{
+    return _nodes.position(nodeId);
+}
+
+QSize DataFlowGraphModel::nodeSize(NodeId nodeId) const
+{
+    return _nodes.size(nodeId);
+}
+
+PortCount DataFlowGraphModel::portCount(NodeId nodeId, PortType portType) const
+{
+    NodeDelegateModel const *model = _nodes.model(nodeId);
+    return model ? model->nPorts(portType) : 0u;
+}
+
+NodeDataType DataFlowGraphModel::portDataType(NodeId nodeId,
+                                              PortType portType,
+                                              PortIndex index) const
+{
+    NodeDelegateModel const *model = _nodes.model(nodeId);
+    return model ? model->dataType(portType, index) : NodeDataType();
+}
 
-    if (it != _connectivity.end()) {
-        disconnected = true;
+NodeDataTypeId DataFlowGraphModel::portDataTypeId(NodeId nodeId,
+                                                  PortType portType,
+                                                  PortIndex index) const
+{
+    NodeDelegateModel const *model = _nodes.model(nodeId);
+    return model ? model->portDataTypeId(portType, index) : InvalidNodeDataTypeId;
+}
 
-        _connectivity.erase(it);
+std::shared_ptr<NodeData> DataFlowGraphModel::outPortData(NodeId nodeId, PortIndex index) const
+{
+    NodeDelegateModel *model = _nodes.model(nodeId);
+    return model ? model->outData(index) : nullptr;
+}
+
+void DataFlowGraphModel::insertConnection(ConnectionId const connectionId)
+{
+    // `TopologicalOrder::addEdge` would add the missing node for good.
+    if (!_nodes.contains(connectionId.outNodeId) || !_nodes.contains(connectionId.inNodeId))
+        throw std::logic_error("Connection refers to a missing node");
+
+    // A duplicate must not add a second edge, `eraseConnection` removes one.
+    if (!_connectivity.insert(connectionId).second)
+        return;
+
+    // The data would circulate through a cycle forever.
+    if (!_topology.addEdge(connectionId.outNodeId, connectionId.inNodeId)) {
+        _connectivity.erase(connectionId);
+        throw std::logic_error("Connection would create a cycle");
     }
 
+    _nodes.attach(connectionId);
+
+    markSnapshotDirty(connectionId.outNodeId);
+    markSnapshotDirty(connectionId.inNodeId);
+}
+
+bool DataFlowGraphModel::eraseConnection(ConnectionId const connectionId)
+{
+    auto it = _connectivity.find(connectionId);
+
+    if (it == _connectivity.end())
+        return false;
+
+    _connectivity.erase(it);
+
+    _nodes.detach(connectionId);
+
+    markSnapshotDirty(connectionId.outNodeId);
+    markSnapshotDirty(connectionId.inNodeId);
+
+    _topology.removeEdge(connectionId.outNodeId, connectionId.inNodeId);
+
+    return true;
+}
+
+bool DataFlowGraphModel::deleteConnection(ConnectionId const connectionId)
+{
+    bool const disconnected = eraseConnection(connectionId);
+
     if (disconnected) {
         sendConnectionDeletion(connectionId);
 
@@ -395,26 +550,136 @@ bool DataFlowGraphModel::deleteConnection(ConnectionId const connectionId)
 bool DataFlowGraphModel::deleteNode(NodeId const nodeId)
 {
     // Delete connections to this node first.
-    auto connectionIds = allConnectionIds(nodeId);
+    std::vector<ConnectionId> const connectionIds = _nodes.connections(nodeId);
     for (auto &cId : connectionIds) {
         deleteConnection(cId);
     }
 
-    _nodeGeometryData.erase(nodeId);
-    _models.erase(nodeId);
-
-    Q_EMIT nodeDeleted(nodeId);
+    removeNode(nodeId);
 
     return true;
 }
 
+void DataFlowGraphModel::deleteNodes(std::vector<NodeId> const &nodeIds)
+{
+    FlatHashSet<NodeId> deleted;
+    deleted.reserve(nodeIds.size());
+
+    std::vector<NodeId> existing;
+    existing.reserve(nodeIds.size());
+
+    for (NodeId const nodeId : nodeIds) {
+        if (_nodes.contains(nodeId) && deleted.insert(nodeId).second)
+            existing.push_back(nodeId);
+    }
+
+    Q_EMIT nodesAboutToBeDeleted(existing);
+
+    // In-ports left without data outside of the deleted set.
+    std::vector<std::pair<NodeId, PortIndex>> emptied;
+
+    for (NodeId const nodeId : existing) {
+        std::vector<ConnectionId> const connectionIds = _nodes.connections(nodeId);
+
+        for (ConnectionId const &cId : connectionIds) {
+            // Connections inside the set are listed at both their nodes.
+            if (!eraseConnection(cId))
+                continue;
+
+            sendConnectionDeletion(cId);
+
+            if (deleted.count(cId.inNodeId) == 0)
+                emptied.emplace_back(cId.inNodeId, cId.inPortIndex);
+        }
+    }
+
+    for (NodeId const nodeId : existing) {
+        removeNode(nodeId);
+    }
+
+    Q_EMIT nodesDeleted(existing);
+
+    // The deleted nodes receive nothing, the others are updated only now.
+    for (auto const &port : emptied) {
+        propagateEmptyDataTo(port.first, port.second);
+    }
+}
+
+void DataFlowGraphModel::addSubgraph(std::vector<QJsonObject> const &nodesJson,
+                                     std::vector<ConnectionId> const &connectionIds)
+{
+    FlatHashSet<NodeId> added;
+    added.reserve(nodesJson.size());
+
+    for (QJsonObject const &nodeJson : nodesJson) {
+        loadNode(nodeJson);
+
+        added.insert(nodeIdFromJson(nodeJson["id"]));
+    }
+
+    for (ConnectionId const &connId : connectionIds) {
+        insertConnection(connId);
+
+        sendConnectionCreation(connId);
+    }
+
+    std::vector<NodeId> const updated = propagateInTopologicalOrder(connectionIds);
+
+    // Only the downstream nodes of the pre-existing receivers still hold stale data.
+    for (NodeId const nodeId : updated) {
+        if (added.count(nodeId))
+            continue;
+
+        PortCount const nOutPorts = portCount(nodeId, PortType::Out);
+        for (PortIndex portIndex = 0; portIndex < nOutPorts; ++portIndex) {
+            onOutPortDataUpdated(nodeId, portIndex);
+        }
+    }
+}
+
+void DataFlowGraphModel::clear()
+{
+    _connectivity.clear();
+    _topology.clear();
+
+    for (NodeId const nodeId : _nodes.nodeIds()) {
+        if (std::unique_ptr<NodeDelegateModel> model = _nodes.erase(nodeId))
+            _registry->release(std::move(model), this);
+
+        _profiler.removeNode(nodeId);
+    }
+
+    markSnapshotDirty(InvalidNodeId);
+
+    Q_EMIT modelReset();
+}
+
+void DataFlowGraphModel::removeNode(NodeId const nodeId)
+{
+    // The slot's generation is bumped, the stale id no longer resolves.
+    if (std::unique_ptr<NodeDelegateModel> model = _nodes.erase(nodeId))
+        _registry->release(std::move(model), this);
+
+    _topology.removeNode(nodeId);
+
+    _profiler.removeNode(nodeId);
+
+    markSnapshotDirty(nodeId);
+
+    Q_EMIT nodeDeleted(nodeId);
+}
+
 QJsonObject DataFlowGraphModel::saveNode(NodeId const nodeId) const
 {
     QJsonObject nodeJson;
 
     nodeJson["id"] = static_cast<qint64>(nodeId);
 
-    nodeJson["internal-data"] = _models.at(nodeId)->save();
+    NodeDelegateModel const *model = _nodes.model(nodeId);
+    if (!model)
+        throw std::logic_error("Node " + std::to_string(nodeId) + " does not exist");
+
+    nodeJson["internal-data"] = model->save();
 
     {
         QPointF const pos = nodeData(nodeId, NodeRole::Position).value<QPointF>();
@@ -433,7 +698,7 @@ QJsonObject DataFlowGraphModel::save() const
     QJsonObject sceneJson;
 
     QJsonArray nodesJsonArray;
-    for (auto const nodeId : allNodeIds()) {
+    for (NodeId const nodeId : _nodes.nodeIds()) {
         nodesJsonArray.append(saveNode(nodeId));
     }
     sceneJson["nodes"] = nodesJsonArray;
@@ -455,10 +720,9 @@ void DataFlowGraphModel::loadNode(QJsonObject const &nodeJson)
     // Conflict is not possible because the scene must be cleared by the time of
     // loading.
     // 2. When undoing the deletion command.  Conflict is not possible
-    // because all the new ids were created past the removed nodes.
-    NodeId restoredNodeId = nodeJson["id"].toInt();
-
-    _nextNodeId = std::max(_nextNodeId, restoredNodeId + 1);
+    // because the freed slot either stays free or is handed out with a newer
+    // generation, see `NodeSlots::insert`.
+    NodeId const restoredNodeId = nodeIdFromJson(nodeJson["id"]);
 
     QJsonObject const internalDataJson = nodeJson["internal-data"].toObject();
 
@@ -467,66 +731,382 @@ void DataFlowGraphModel::loadNode(QJsonObject const &nodeJson)
     std::unique_ptr<NodeDelegateModel> model = _registry->create(delegateModelName);
 
     if (model) {
-        connect(model.get(),
-                &NodeDelegateModel::dataUpdated,
-                [restoredNodeId, this](PortIndex const portIndex) {
-                    onOutPortDataUpdated(restoredNodeId, portIndex);
-                });
-
-        _models[restoredNodeId] = std::move(model);
+        NodeDelegateModel *nodeModel = model.get();
 
-        Q_EMIT nodeCreated(restoredNodeId);
+        installModel(restoredNodeId, std::move(model));
 
         QJsonObject posJson = nodeJson["position"].toObject();
         QPointF const pos(posJson["x"].toDouble(), posJson["y"].toDouble());
 
         setNodeData(restoredNodeId, NodeRole::Position, pos);
 
-        _models[restoredNodeId]->load(internalDataJson);
+        nodeModel->load(internalDataJson);
     } else {
         throw std::logic_error(std::string("No registered model with name ")
                                + delegateModelName.toLocal8Bit().data());
     }
 }
 
+void DataFlowGraphModel::loadNodesInParallel(QJsonArray const &nodesJsonArray)
+{
+    std::vector<PendingNode> pendingNodes;
+    pendingNodes.reserve(nodesJsonArray.size());
+
+    // Delegate models are QObjects and could create widgets in their
+    // constructors, therefore they are instantiated on the owning thread.
+    for (QJsonValue const nodeValue : nodesJsonArray) {
+        QJsonObject const nodeJson = nodeValue.toObject();
+
+        PendingNode pending;
+        pending.nodeId = nodeIdFromJson(nodeJson["id"]);
+        pending.internalDataJson = nodeJson["internal-data"].toObject();
+
+        QJsonObject posJson = nodeJson["position"].toObject();
+        pending.pos = QPointF(posJson["x"].toDouble(), posJson["y"].toDouble());
+
+        QString delegateModelName = pending.internalDataJson["model-name"].toString();
+
+        pending.model = _registry->create(delegateModelName);
+
+        if (!pending.model) {
+            throw std::logic_error(std::string("No registered model with name ")
+                                   + delegateModelName.toLocal8Bit().data());
+        }
+
+        pendingNodes.push_back(std::move(pending));
+    }
+
+    // Model-specific decoding on the worker threads.
+    {
+        std::atomic<std::size_t> next{0};
+        std::exception_ptr error;
+        std::mutex errorMutex;
+
+        int const nTasks = std::min(std::max(QThread::idealThreadCount(), 1),
+                                    static_cast<int>(pendingNodes.size()));
+
+        QThreadPool pool;
+        pool.setMaxThreadCount(std::max(nTasks, 1));
+
+        for (int i = 0; i < nTasks; ++i) {
+            pool.start(new PreloadTask(pendingNodes, next, error, errorMutex));
+        }
+
+        pool.waitForDone();
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    // Installation on the owning thread in one pass.
+    for (PendingNode &pending : pendingNodes) {
+        NodeDelegateModel *model = pending.model.get();
+
+        installModel(pending.nodeId, std::move(pending.model));
+
+        setNodeData(pending.nodeId, NodeRole::Position, pending.pos);
+
+        model->load(pending.internalDataJson);
+    }
+}
+
 void DataFlowGraphModel::load(QJsonObject const &jsonDocument)
 {
-    QJsonArray nodesJsonArray = jsonDocument["nodes"].toArray();
+    QJsonArray const nodesJsonArray = jsonDocument["nodes"].toArray();
+
+    // Earlier versions numbered the nodes with a plain counter. The ids the
+    // slots cannot take, or only by growing far beyond the size of the graph,
+    // are replaced like the ids of pasted nodes. The kept nodes go first so
+    // that the new ids do not take their slots.
+    std::size_t const slotLimit = std::max<std::size_t>(_nodes.slotCount(),
+                                                        2 * (_nodes.count()
+                                                             + nodesJsonArray.size()));
+
+    FlatHashSet<std::size_t> keptSlots;
+    QJsonArray keptNodes;
+    QJsonArray remappedNodes;
+
+    for (QJsonValue const nodeValue : nodesJsonArray) {
+        QJsonObject const nodeJson = nodeValue.toObject();
+        NodeId const nodeId = nodeIdFromJson(nodeJson["id"]);
+
+        if (_nodes.canInsert(nodeId) && SlotAllocator::slotIndex(nodeId) < slotLimit
+            && keptSlots.insert(SlotAllocator::slotIndex(nodeId)).second) {
+            keptNodes.append(nodeJson);
+        } else {
+            remappedNodes.append(nodeJson);
+        }
+    }
+
+    auto loadNodes = [this](QJsonArray const &nodes) {
+        if (_parallelLoadEnabled) {
+            loadNodesInParallel(nodes);
+        } else {
+            for (QJsonValue const nodeJson : nodes) {
+                loadNode(nodeJson.toObject());
+            }
+        }
+    };
+
+    loadNodes(keptNodes);
+
+    FlatHashMap<NodeId, NodeId> mapNodeIds;
+    mapNodeIds.reserve(remappedNodes.size());
+
+    for (QJsonValueRef nodeValue : remappedNodes) {
+        QJsonObject nodeJson = nodeValue.toObject();
+
+        NodeId const restoredNodeId = newNodeId();
+
+        mapNodeIds[nodeIdFromJson(nodeJson["id"])] = restoredNodeId;
 
-    for (QJsonValueRef nodeJson : nodesJsonArray) {
-        loadNode(nodeJson.toObject());
+        nodeJson["id"] = static_cast<qint64>(restoredNodeId);
+        nodeValue = nodeJson;
     }
 
+    try {
+        loadNodes(remappedNodes);
+    } catch (...) {
+        // Unreserves the new ids no node was installed under.
+        for (auto const &entry : mapNodeIds)
+            releaseNodeId(entry.second);
+
+        throw;
+    }
+
+    auto restoredId = [&mapNodeIds](NodeId const nodeId) {
+        auto it = mapNodeIds.find(nodeId);
+        return it != mapNodeIds.end() ? it->second : nodeId;
+    };
+
     QJsonArray connectionJsonArray = jsonDocument["connections"].toArray();
 
+    std::vector<ConnectionId> connectionIds;
+    connectionIds.reserve(connectionJsonArray.size());
+
+    // All the connections are wired first without pushing any data through
+    // them: most of the nodes are not completely connected yet.
     for (QJsonValueRef connection : connectionJsonArray) {
         QJsonObject connJson = connection.toObject();
 
         ConnectionId connId = fromJson(connJson);
+        connId.outNodeId = restoredId(connId.outNodeId);
+        connId.inNodeId = restoredId(connId.inNodeId);
+
+        // The nodes are already installed, a broken connection must not stop
+        // the rest of the scene from loading.
+        try {
+            insertConnection(connId);
+        } catch (std::logic_error const &error) {
+            qWarning() << "Skipping connection" << connId.outNodeId << connId.outPortIndex
+                       << connId.inNodeId << connId.inPortIndex << "-" << error.what();
+            continue;
+        }
+
+        sendConnectionCreation(connId);
 
-        // Restore the connection
-        addConnection(connId);
+        connectionIds.push_back(connId);
     }
+
+    propagateInTopologicalOrder(connectionIds);
+}
+
+void DataFlowGraphModel::setSnapshotsEnabled(bool enabled)
+{
+    if (_snapshotsEnabled == enabled)
+        return;
+
+    _snapshotsEnabled = enabled;
+
+    // Changes are not tracked while disabled.
+    _snapshotAllDirty = true;
+    _dirtySnapshotChunks.clear();
+
+    if (enabled)
+        publishSnapshot();
+}
+
+std::shared_ptr<GraphSnapshot const> DataFlowGraphModel::snapshot() const
+{
+    std::shared_ptr<GraphSnapshot const> result = std::atomic_load(&_snapshot);
+
+    if (!result) {
+        static std::shared_ptr<GraphSnapshot const> const empty
+            = std::make_shared<GraphSnapshot const>();
+        return empty;
+    }
+
+    return result;
+}
+
+void DataFlowGraphModel::publishSnapshot()
+{
+    std::size_t const chunkSize = GraphSnapshot::ChunkSize;
+    std::size_t const chunkCount = (_nodes.slotCount() + chunkSize - 1) / chunkSize;
+
+    // Only this thread replaces the pointer, no atomic access is needed here.
+    std::shared_ptr<GraphSnapshot const> const previous = _snapshot;
+
+    auto next = previous ? std::make_shared<GraphSnapshot>(*previous)
+                         : std::make_shared<GraphSnapshot>();
+
+    next->_chunks.resize(chunkCount);
+
+    if (_snapshotAllDirty || !_snapshotsEnabled || !previous) {
+        for (std::size_t chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex) {
+            next->_chunks[chunkIndex] = buildSnapshotChunk(chunkIndex);
+        }
+    } else {
+        for (std::size_t const chunkIndex : _dirtySnapshotChunks) {
+            if (chunkIndex < chunkCount)
+                next->_chunks[chunkIndex] = buildSnapshotChunk(chunkIndex);
+        }
+    }
+
+    _dirtySnapshotChunks.clear();
+    _snapshotAllDirty = false;
+
+    next->_version = previous ? previous->_version + 1 : 1;
+    next->updateCounts();
+
+    quint64 const version = next->_version;
+
+    std::atomic_store(&_snapshot, std::shared_ptr<GraphSnapshot const>(std::move(next)));
+
+    Q_EMIT snapshotPublished(version);
+}
+
+void DataFlowGraphModel::markSnapshotDirty(NodeId const nodeId)
+{
+    if (!_snapshotsEnabled)
+        return;
+
+    if (nodeId == InvalidNodeId)
+        _snapshotAllDirty = true;
+    else
+        _dirtySnapshotChunks.insert(SlotAllocator::slotIndex(nodeId) / GraphSnapshot::ChunkSize);
+
+    if (_snapshotScheduled)
+        return;
+
+    _snapshotScheduled = true;
+
+    // One snapshot per batch of edits, published when the control returns
+    // to the event loop.
+    QTimer::singleShot(0, this, [this]() {
+        _snapshotScheduled = false;
+
+        if (_snapshotsEnabled)
+            publishSnapshot();
+    });
+}
+
+std::shared_ptr<GraphSnapshot::Chunk const> DataFlowGraphModel::buildSnapshotChunk(
+    std::size_t const chunkIndex) const
+{
+    std::size_t const chunkSize = GraphSnapshot::ChunkSize;
+    std::size_t const first = chunkIndex * chunkSize;
+    std::size_t const last = std::min(first + chunkSize, _nodes.slotCount());
+
+    auto chunk = std::make_shared<GraphSnapshot::Chunk>();
+    chunk->nodes.resize(chunkSize);
+
+    for (std::size_t slot = first; slot < last; ++slot) {
+        NodeId const nodeId = _nodes.nodeIdAt(slot);
+        if (nodeId == InvalidNodeId)
+            continue;
+
+        NodeDelegateModel const *model = _nodes.model(nodeId);
+
+        SnapshotNode &n = chunk->nodes[slot - first];
+
+        n.id = nodeId;
+        n.type = model->name();
+        n.caption = model->caption();
+        n.position = _nodes.position(nodeId);
+        n.size = _nodes.size(nodeId);
+        n.inPortCount = model->nPorts(PortType::In);
+        n.outPortCount = model->nPorts(PortType::Out);
+        n.connections = _nodes.connections(nodeId);
+
+        ++chunk->nodeCount;
+
+        for (ConnectionId const &cid : n.connections) {
+            if (cid.outNodeId == nodeId)
+                ++chunk->connectionCount;
+        }
+    }
+
+    return chunk;
+}
+
+std::vector<NodeId> DataFlowGraphModel::topologicalOrder() const
+{
+    return _topology.order();
+}
+
+std::vector<NodeId> DataFlowGraphModel::propagateInTopologicalOrder(
+    std::vector<ConnectionId> const &connectionIds)
+{
+    FlatHashMap<NodeId, std::vector<ConnectionId>> inConnections;
+
+    for (auto const &cid : connectionIds) {
+        inConnections[cid.inNodeId].push_back(cid);
+    }
+
+    // Only the receiving nodes are ordered, the maintained positions are compared.
+    std::vector<NodeId> receivers;
+    receivers.reserve(inConnections.size());
+
+    for (auto const &p : inConnections) {
+        receivers.push_back(p.first);
+    }
+
+    std::sort(receivers.begin(), receivers.end(), [this](NodeId const a, NodeId const b) {
+        return _topology.position(a) < _topology.position(b);
+    });
+
+    QScopedValueRollback<bool> suppressed(_propagationSuppressed, true);
+
+    for (NodeId const nodeId : receivers) {
+        std::vector<ConnectionId> &connected = inConnections[nodeId];
+
+        std::sort(connected.begin(),
+                  connected.end(),
+                  [](ConnectionId const &a, ConnectionId const &b) {
+                      return a.inPortIndex < b.inPortIndex;
+                  });
+
+        for (auto const &cn : connected) {
+            setInPortData(nodeId, cn.inPortIndex, outPortData(cn.outNodeId, cn.outPortIndex));
+        }
+    }
+
+    return receivers;
 }
 
 void DataFlowGraphModel::onOutPortDataUpdated(NodeId const nodeId, PortIndex const portIndex)
 {
+    // The downstream nodes will be visited by the ongoing ordered pass.
+    if (_propagationSuppressed)
+        return;
+
+    ScopedProfile profile(&_profiler, nodeId, ProfileCategory::Propagation);
+
     std::unordered_set<ConnectionId> const &connected = connections(nodeId,
                                                                     PortType::Out,
                                                                     portIndex);
 
-    QVariant const portDataToPropagate = portData(nodeId, PortType::Out, portIndex, PortRole::Data);
+    std::shared_ptr<NodeData> const portDataToPropagate = outPortData(nodeId, portIndex);
 
     for (auto const &cn : connected) {
-        setPortData(cn.inNodeId, PortType::In, cn.inPortIndex, portDataToPropagate, PortRole::Data);
+        setInPortData(cn.inNodeId, cn.inPortIndex, portDataToPropagate);
     }
 }
 
 void DataFlowGraphModel::propagateEmptyDataTo(NodeId const nodeId, PortIndex const portIndex)
 {
-    QVariant emptyData{};
-
-    setPortData(nodeId, PortType::In, portIndex, emptyData, PortRole::Data);
+    setInPortData(nodeId, portIndex, nullptr);
 }
 
 } // namespace QtNodes
@@ -32,6 +32,8 @@ DataFlowGraphicsScene::DataFlowGraphicsScene(DataFlowGraphModel &graphModel, QOb
     : BasicGraphicsScene(graphModel, parent)
     , _graphModel(graphModel)
 {
+    setProfiler(&_graphModel.profiler());
+
     connect(&_graphModel,
             &DataFlowGraphModel::inPortDataWasSet,
             [this](NodeId const nodeId, PortType const, PortIndex const) { onNodeUpdated(nodeId); });
@@ -97,21 +97,18 @@ void DefaultConnectionPainter::drawNormalLine(QPainter *painter, ConnectionGraph
 
         auto const cId = cgo.connectionId();
 
-        auto dataTypeOut = graphModel
-                               .portData(cId.outNodeId,
-                                         PortType::Out,
-                                         cId.outPortIndex,
-                                         PortRole::DataType)
-                               .value<NodeDataType>();
+        NodeDataTypeId const dataTypeOut = graphModel.portDataTypeId(cId.outNodeId,
+                                                                     PortType::Out,
+                                                                     cId.outPortIndex);
 
-        auto dataTypeIn
-            = graphModel.portData(cId.inNodeId, PortType::In, cId.inPortIndex, PortRole::DataType)
-                  .value<NodeDataType>();
+        NodeDataTypeId const dataTypeIn = graphModel.portDataTypeId(cId.inNodeId,
+                                                                    PortType::In,
+                                                                    cId.inPortIndex);
 
-        useGradientColor = (dataTypeOut.id != dataTypeIn.id);
+        useGradientColor = (dataTypeOut != dataTypeIn);
 
-        normalColorOut = connectionStyle.normalColor(dataTypeOut.id);
-        normalColorIn = connectionStyle.normalColor(dataTypeIn.id);
+        normalColorOut = connectionStyle.normalColor(dataTypeOut);
+        normalColorIn = connectionStyle.normalColor(dataTypeIn);
         selectedColor = normalColorOut.darker(200);
     }
 
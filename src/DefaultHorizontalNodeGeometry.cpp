@@ -25,7 +25,7 @@ DefaultHorizontalNodeGeometry::DefaultHorizontalNodeGeometry(AbstractGraphModel
 
 QSize DefaultHorizontalNodeGeometry::size(NodeId const nodeId) const
 {
-    return _graphModel.nodeData<QSize>(nodeId, NodeRole::Size);
+    return _graphModel.nodeSize(nodeId);
 }
 
 void DefaultHorizontalNodeGeometry::recomputeSize(NodeId const nodeId) const
@@ -75,7 +75,7 @@ QPointF DefaultHorizontalNodeGeometry::portPosition(NodeId const nodeId,
     totalHeight += step * portIndex;
     totalHeight += step / 2.0;
 
-    QSize size = _graphModel.nodeData<QSize>(nodeId, NodeRole::Size);
+    QSize size = _graphModel.nodeSize(nodeId);
 
     switch (portType) {
     case PortType::In: {
@@ -109,7 +109,7 @@ QPointF DefaultHorizontalNodeGeometry::portTextPosition(NodeId const nodeId,
 
     p.setY(p.y() + rect.height() / 4.0);
 
-    QSize size = _graphModel.nodeData<QSize>(nodeId, NodeRole::Size);
+    QSize size = _graphModel.nodeSize(nodeId);
 
     switch (portType) {
     case PortType::In:
@@ -139,14 +139,14 @@ QRectF DefaultHorizontalNodeGeometry::captionRect(NodeId const nodeId) const
 
 QPointF DefaultHorizontalNodeGeometry::captionPosition(NodeId const nodeId) const
 {
-    QSize size = _graphModel.nodeData<QSize>(nodeId, NodeRole::Size);
+    QSize size = _graphModel.nodeSize(nodeId);
     return QPointF(0.5 * (size.width() - captionRect(nodeId).width()),
                    0.5 * _portSpasing + captionRect(nodeId).height());
 }
 
 QPointF DefaultHorizontalNodeGeometry::widgetPosition(NodeId const nodeId) const
 {
-    QSize size = _graphModel.nodeData<QSize>(nodeId, NodeRole::Size);
+    QSize size = _graphModel.nodeSize(nodeId);
 
     unsigned int captionHeight = captionRect(nodeId).height();
 
@@ -166,7 +166,7 @@ QPointF DefaultHorizontalNodeGeometry::widgetPosition(NodeId const nodeId) const
 
 QRect DefaultHorizontalNodeGeometry::resizeHandleRect(NodeId const nodeId) const
 {
-    QSize size = _graphModel.nodeData<QSize>(nodeId, NodeRole::Size);
+    QSize size = _graphModel.nodeSize(nodeId);
 
     unsigned int rectSize = 7;
 
@@ -181,9 +181,7 @@ QRectF DefaultHorizontalNodeGeometry::portTextRect(NodeId const nodeId,
     if (_graphModel.portData<bool>(nodeId, portType, portIndex, PortRole::CaptionVisible)) {
         s = _graphModel.portData<QString>(nodeId, portType, portIndex, PortRole::Caption);
     } else {
-        auto portData = _graphModel.portData(nodeId, portType, portIndex, PortRole::DataType);
-
-        s = portData.value<NodeDataType>().name;
+        s = _graphModel.portDataType(nodeId, portType, portIndex).name;
     }
 
     return _fontMetrics.boundingRect(s);
@@ -191,9 +189,9 @@ QRectF DefaultHorizontalNodeGeometry::portTextRect(NodeId const nodeId,
 
 unsigned int DefaultHorizontalNodeGeometry::maxVerticalPortsExtent(NodeId const nodeId) const
 {
-    PortCount nInPorts = _graphModel.nodeData<PortCount>(nodeId, NodeRole::InPortCount);
+    PortCount nInPorts = _graphModel.portCount(nodeId, PortType::In);
 
-    PortCount nOutPorts = _graphModel.nodeData<PortCount>(nodeId, NodeRole::OutPortCount);
+    PortCount nOutPorts = _graphModel.portCount(nodeId, PortType::Out);
 
     unsigned int maxNumOfEntries = std::max(nInPorts, nOutPorts);
     unsigned int step = _portSize + _portSpasing;
@@ -206,11 +204,7 @@ unsigned int DefaultHorizontalNodeGeometry::maxPortsTextAdvance(NodeId const nod
 {
     unsigned int width = 0;
 
-    size_t const n = _graphModel
-                         .nodeData(nodeId,
-                                   (portType == PortType::Out) ? NodeRole::OutPortCount
-                                                               : NodeRole::InPortCount)
-                         .toUInt();
+    size_t const n = _graphModel.portCount(nodeId, portType);
 
     for (PortIndex portIndex = 0ul; portIndex < n; ++portIndex) {
         QString name;
@@ -218,12 +212,7 @@ unsigned int DefaultHorizontalNodeGeometry::maxPortsTextAdvance(NodeId const nod
         if (_graphModel.portData<bool>(nodeId, portType, portIndex, PortRole::CaptionVisible)) {
             name = _graphModel.portData<QString>(nodeId, portType, portIndex, PortRole::Caption);
         } else {
-            NodeDataType portData = _graphModel.portData<NodeDataType>(nodeId,
-                                                                       portType,
-                                                                       portIndex,
-                                                                       PortRole::DataType);
-
-            name = portData.name;
+            name = _graphModel.portDataType(nodeId, portType, portIndex).name;
         }
 
 #if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
@@ -89,18 +89,11 @@ void DefaultNodePainter::drawConnectionPoints(QPainter *painter, NodeGraphicsObj
     auto reducedDiameter = diameter * 0.6;
 
     for (PortType portType : {PortType::Out, PortType::In}) {
-        size_t const n = model
-                             .nodeData(nodeId,
-                                       (portType == PortType::Out) ? NodeRole::OutPortCount
-                                                                   : NodeRole::InPortCount)
-                             .toUInt();
+        size_t const n = model.portCount(nodeId, portType);
 
         for (PortIndex portIndex = 0; portIndex < n; ++portIndex) {
             QPointF p = geometry.portPosition(nodeId, portType, portIndex);
 
-            auto const &dataType = model.portData(nodeId, portType, portIndex, PortRole::DataType)
-                                       .value<NodeDataType>();
-
             double r = 1.0;
 
             NodeState const &state = ngo.nodeState();
@@ -113,7 +106,8 @@ void DefaultNodePainter::drawConnectionPoints(QPainter *painter, NodeGraphicsObj
                                                                                  nodeId,
                                                                                  portIndex);
 
-                    bool const possible = model.connectionPossible(possibleConnectionId);
+                    bool const possible = ngo.nodeScene()->connectionPossible(
+                        possibleConnectionId);
 
                     auto cp = cgo->sceneTransform().map(cgo->endPoint(requiredPort));
                     cp = ngo.sceneTransform().inverted().map(cp);
@@ -129,10 +123,14 @@ void DefaultNodePainter::drawConnectionPoints(QPainter *painter, NodeGraphicsObj
                         r = (dist < thres) ? (dist / thres) : 1.0;
                     }
                 }
+            } else if (ngo.nodeScene()->isDraftTarget(nodeId, portType, portIndex)) {
+                // All the ports accepting the dragged connection stand out.
+                r = 1.4;
             }
 
             if (connectionStyle.useDataDefinedColors()) {
-                painter->setBrush(connectionStyle.normalColor(dataType.id));
+                NodeDataTypeId const dataType = model.portDataTypeId(nodeId, portType, portIndex);
+                painter->setBrush(connectionStyle.normalColor(dataType));
             } else {
                 painter->setBrush(nodeStyle.ConnectionPointColor);
             }
@@ -158,11 +156,7 @@ void DefaultNodePainter::drawFilledConnectionPoints(QPainter *painter, NodeGraph
     auto diameter = nodeStyle.ConnectionPointDiameter;
 
     for (PortType portType : {PortType::Out, PortType::In}) {
-        size_t const n = model
-                             .nodeData(nodeId,
-                                       (portType == PortType::Out) ? NodeRole::OutPortCount
-                                                                   : NodeRole::InPortCount)
-                             .toUInt();
+        size_t const n = model.portCount(nodeId, portType);
 
         for (PortIndex portIndex = 0; portIndex < n; ++portIndex) {
             QPointF p = geometry.portPosition(nodeId, portType, portIndex);
@@ -170,13 +164,12 @@ void DefaultNodePainter::drawFilledConnectionPoints(QPainter *painter, NodeGraph
             auto const &connected = model.connections(nodeId, portType, portIndex);
 
             if (!connected.empty()) {
-                auto const &dataType = model
-                                           .portData(nodeId, portType, portIndex, PortRole::DataType)
-                                           .value<NodeDataType>();
-
                 auto const &connectionStyle = StyleCollection::connectionStyle();
                 if (connectionStyle.useDataDefinedColors()) {
-                    QColor const c = connectionStyle.normalColor(dataType.id);
+                    NodeDataTypeId const dataType = model.portDataTypeId(nodeId,
+                                                                         portType,
+                                                                         portIndex);
+                    QColor const c = connectionStyle.normalColor(dataType);
                     painter->setPen(c);
                     painter->setBrush(c);
                 } else {
@@ -227,10 +220,7 @@ void DefaultNodePainter::drawEntryLabels(QPainter *painter, NodeGraphicsObject &
     NodeStyle nodeStyle(json.object());
 
     for (PortType portType : {PortType::Out, PortType::In}) {
-        unsigned int n = model.nodeData<unsigned int>(nodeId,
-                                                      (portType == PortType::Out)
-                                                          ? NodeRole::OutPortCount
-                                                          : NodeRole::InPortCount);
+        unsigned int n = model.portCount(nodeId, portType);
 
         for (PortIndex portIndex = 0; portIndex < n; ++portIndex) {
             auto const &connected = model.connections(nodeId, portType, portIndex);
@@ -247,9 +237,7 @@ void DefaultNodePainter::drawEntryLabels(QPainter *painter, NodeGraphicsObject &
             if (model.portData<bool>(nodeId, portType, portIndex, PortRole::CaptionVisible)) {
                 s = model.portData<QString>(nodeId, portType, portIndex, PortRole::Caption);
             } else {
-                auto portData = model.portData(nodeId, portType, portIndex, PortRole::DataType);
-
-                s = portData.value<NodeDataType>().name;
+                s = model.portDataType(nodeId, portType, portIndex).name;
             }
 
             painter->drawText(p, s);
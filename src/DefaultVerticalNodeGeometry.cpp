@@ -25,7 +25,7 @@ DefaultVerticalNodeGeometry::DefaultVerticalNodeGeometry(AbstractGraphModel &gra
 
 QSize DefaultVerticalNodeGeometry::size(NodeId const nodeId) const
 {
-    return _graphModel.nodeData<QSize>(nodeId, NodeRole::Size);
+    return _graphModel.nodeSize(nodeId);
 }
 
 void DefaultVerticalNodeGeometry::recomputeSize(NodeId const nodeId) const
@@ -43,8 +43,8 @@ void DefaultVerticalNodeGeometry::recomputeSize(NodeId const nodeId) const
     height += _portSpasing;
     height += _portSpasing;
 
-    PortCount nInPorts = _graphModel.nodeData<PortCount>(nodeId, NodeRole::InPortCount);
-    PortCount nOutPorts = _graphModel.nodeData<PortCount>(nodeId, NodeRole::OutPortCount);
+    PortCount nInPorts = _graphModel.portCount(nodeId, PortType::In);
+    PortCount nOutPorts = _graphModel.portCount(nodeId, PortType::Out);
 
     // Adding double step (top and bottom) to reserve space for port captions.
 
@@ -84,13 +84,13 @@ QPointF DefaultVerticalNodeGeometry::portPosition(NodeId const nodeId,
 {
     QPointF result;
 
-    QSize size = _graphModel.nodeData<QSize>(nodeId, NodeRole::Size);
+    QSize size = _graphModel.nodeSize(nodeId);
 
     switch (portType) {
     case PortType::In: {
         unsigned int inPortWidth = maxPortsTextAdvance(nodeId, PortType::In) + _portSpasing;
 
-        PortCount nInPorts = _graphModel.nodeData<PortCount>(nodeId, NodeRole::InPortCount);
+        PortCount nInPorts = _graphModel.portCount(nodeId, PortType::In);
 
         double x = (size.width() - (nInPorts - 1) * inPortWidth) / 2.0 + portIndex * inPortWidth;
 
@@ -103,7 +103,7 @@ QPointF DefaultVerticalNodeGeometry::portPosition(NodeId const nodeId,
 
     case PortType::Out: {
         unsigned int outPortWidth = maxPortsTextAdvance(nodeId, PortType::Out) + _portSpasing;
-        PortCount nOutPorts = _graphModel.nodeData<PortCount>(nodeId, NodeRole::OutPortCount);
+        PortCount nOutPorts = _graphModel.portCount(nodeId, PortType::Out);
 
         double x = (size.width() - (nOutPorts - 1) * outPortWidth) / 2.0 + portIndex * outPortWidth;
 
@@ -131,7 +131,7 @@ QPointF DefaultVerticalNodeGeometry::portTextPosition(NodeId const nodeId,
 
     p.setX(p.x() - rect.width() / 2.0);
 
-    QSize size = _graphModel.nodeData<QSize>(nodeId, NodeRole::Size);
+    QSize size = _graphModel.nodeSize(nodeId);
 
     switch (portType) {
     case PortType::In:
@@ -161,7 +161,7 @@ QRectF DefaultVerticalNodeGeometry::captionRect(NodeId const nodeId) const
 
 QPointF DefaultVerticalNodeGeometry::captionPosition(NodeId const nodeId) const
 {
-    QSize size = _graphModel.nodeData<QSize>(nodeId, NodeRole::Size);
+    QSize size = _graphModel.nodeSize(nodeId);
 
     unsigned int step = portCaptionsHeight(nodeId, PortType::In);
     step += _portSpasing;
@@ -173,7 +173,7 @@ QPointF DefaultVerticalNodeGeometry::captionPosition(NodeId const nodeId) const
 
 QPointF DefaultVerticalNodeGeometry::widgetPosition(NodeId const nodeId) const
 {
-    QSize size = _graphModel.nodeData<QSize>(nodeId, NodeRole::Size);
+    QSize size = _graphModel.nodeSize(nodeId);
 
     unsigned int captionHeight = captionRect(nodeId).height();
 
@@ -192,7 +192,7 @@ QPointF DefaultVerticalNodeGeometry::widgetPosition(NodeId const nodeId) const
 
 QRect DefaultVerticalNodeGeometry::resizeHandleRect(NodeId const nodeId) const
 {
-    QSize size = _graphModel.nodeData<QSize>(nodeId, NodeRole::Size);
+    QSize size = _graphModel.nodeSize(nodeId);
 
     unsigned int rectSize = 7;
 
@@ -207,9 +207,7 @@ QRectF DefaultVerticalNodeGeometry::portTextRect(NodeId const nodeId,
     if (_graphModel.portData<bool>(nodeId, portType, portIndex, PortRole::CaptionVisible)) {
         s = _graphModel.portData<QString>(nodeId, portType, portIndex, PortRole::Caption);
     } else {
-        auto portData = _graphModel.portData(nodeId, portType, portIndex, PortRole::DataType);
-
-        s = portData.value<NodeDataType>().name;
+        s = _graphModel.portDataType(nodeId, portType, portIndex).name;
     }
 
     return _fontMetrics.boundingRect(s);
@@ -217,9 +215,9 @@ QRectF DefaultVerticalNodeGeometry::portTextRect(NodeId const nodeId,
 
 unsigned int DefaultVerticalNodeGeometry::maxHorizontalPortsExtent(NodeId const nodeId) const
 {
-    PortCount nInPorts = _graphModel.nodeData<PortCount>(nodeId, NodeRole::InPortCount);
+    PortCount nInPorts = _graphModel.portCount(nodeId, PortType::In);
 
-    PortCount nOutPorts = _graphModel.nodeData<PortCount>(nodeId, NodeRole::OutPortCount);
+    PortCount nOutPorts = _graphModel.portCount(nodeId, PortType::Out);
 
     unsigned int maxNumOfEntries = std::max(nInPorts, nOutPorts);
     unsigned int step = _portSize + _portSpasing;
@@ -232,11 +230,7 @@ unsigned int DefaultVerticalNodeGeometry::maxPortsTextAdvance(NodeId const nodeI
 {
     unsigned int width = 0;
 
-    size_t const n = _graphModel
-                         .nodeData(nodeId,
-                                   (portType == PortType::Out) ? NodeRole::OutPortCount
-                                                               : NodeRole::InPortCount)
-                         .toUInt();
+    size_t const n = _graphModel.portCount(nodeId, portType);
 
     for (PortIndex portIndex = 0ul; portIndex < n; ++portIndex) {
         QString name;
@@ -244,12 +238,7 @@ unsigned int DefaultVerticalNodeGeometry::maxPortsTextAdvance(NodeId const nodeI
         if (_graphModel.portData<bool>(nodeId, portType, portIndex, PortRole::CaptionVisible)) {
             name = _graphModel.portData<QString>(nodeId, portType, portIndex, PortRole::Caption);
         } else {
-            NodeDataType portData = _graphModel.portData<NodeDataType>(nodeId,
-                                                                       portType,
-                                                                       portIndex,
-                                                                       PortRole::DataType);
-
-            name = portData.name;
+            name = _graphModel.portDataType(nodeId, portType, portIndex).name;
         }
 
 #if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
@@ -269,7 +258,7 @@ unsigned int DefaultVerticalNodeGeometry::portCaptionsHeight(NodeId const nodeId
 
     switch (portType) {
     case PortType::In: {
-        PortCount nInPorts = _graphModel.nodeData<PortCount>(nodeId, NodeRole::InPortCount);
+        PortCount nInPorts = _graphModel.portCount(nodeId, PortType::In);
         for (PortIndex i = 0; i < nInPorts; ++i) {
             if (_graphModel.portData<bool>(nodeId, PortType::In, i, PortRole::CaptionVisible)) {
                 h += _portSpasing;
@@ -280,7 +269,7 @@ unsigned int DefaultVerticalNodeGeometry::portCaptionsHeight(NodeId const nodeId
     }
 
     case PortType::Out: {
-        PortCount nOutPorts = _graphModel.nodeData<PortCount>(nodeId, NodeRole::OutPortCount);
+        PortCount nOutPorts = _graphModel.portCount(nodeId, PortType::Out);
         for (PortIndex i = 0; i < nOutPorts; ++i) {
             if (_graphModel.portData<bool>(nodeId, PortType::Out, i, PortRole::CaptionVisible)) {
                 h += _portSpasing;
@@ -0,0 +1,714 @@
+#include "GraphAnalysis.hpp"
+
+#include "AbstractGraphModel.hpp"
+#include "ConnectionIdHash.hpp"
+
+#include <algorithm>
+
+namespace QtNodes {
+
+namespace {
+
+bool eraseOne(std::vector<NodeId> &nodes, NodeId const nodeId)
+{
+    auto it = std::find(nodes.begin(), nodes.end(), nodeId);
+    if (it == nodes.end())
+        return false;
+
+    *it = nodes.back();
+    nodes.pop_back();
+    return true;
+}
+
+} // namespace
+
+GraphAnalysis::GraphAnalysis(AbstractGraphModel &model, QObject *parent)
+    : QObject(parent)
+    , _model(model)
+    , _verticesValid(false)
+    , _strongComponentsValid(false)
+    , _depthsValid(false)
+    , _componentCount(0)
+    , _componentsValid(false)
+{
+    connect(&_model, &AbstractGraphModel::nodeCreated, this, &GraphAnalysis::onNodeCreated);
+
+    connect(&_model, &AbstractGraphModel::nodeDeleted, this, &GraphAnalysis::onNodeDeleted);
+
+    connect(&_model,
+            &AbstractGraphModel::connectionCreated,
+            this,
+            &GraphAnalysis::onConnectionCreated);
+
+    connect(&_model,
+            &AbstractGraphModel::connectionDeleted,
+            this,
+            &GraphAnalysis::onConnectionDeleted);
+
+    connect(&_model, &AbstractGraphModel::modelReset, this, &GraphAnalysis::onModelReset);
+}
+
+bool GraphAnalysis::isAcyclic() const
+{
+    ensureStrongComponents();
+
+    return std::find(_cyclic.begin(), _cyclic.end(), 1) == _cyclic.end();
+}
+
+std::vector<NodeId> GraphAnalysis::topologicalOrder() const
+{
+    ensureStrongComponents();
+
+    std::vector<NodeId> result;
+    result.reserve(_vertices.size());
+
+    for (auto const &strongComponent : _strongComponents)
+        result.insert(result.end(), strongComponent.begin(), strongComponent.end());
+
+    return result;
+}
+
+std::vector<std::vector<NodeId>> GraphAnalysis::stronglyConnectedComponents() const
+{
+    ensureStrongComponents();
+
+    std::vector<std::vector<NodeId>> result;
+
+    for (auto const &strongComponent : _strongComponents) {
+        if (!strongComponent.empty())
+            result.push_back(strongComponent);
+    }
+
+    return result;
+}
+
+bool GraphAnalysis::isOnCycle(NodeId const nodeId) const
+{
+    ensureStrongComponents();
+
+    auto it = _strongComponentOf.find(nodeId);
+    return it != _strongComponentOf.end() && _cyclic[it->second];
+}
+
+std::vector<NodeId> GraphAnalysis::upstream(NodeId const nodeId) const
+{
+    return cone(nodeId, false);
+}
+
+std::vector<NodeId> GraphAnalysis::downstream(NodeId const nodeId) const
+{
+    return cone(nodeId, true);
+}
+
+bool GraphAnalysis::reaches(NodeId const from, NodeId const to) const
+{
+    ensureVertices();
+
+    if (!_vertices.contains(from) || !_vertices.contains(to))
+        return false;
+
+    auto itDownstream = _downstreamCones.find(from);
+    if (itDownstream != _downstreamCones.end())
+        return std::binary_search(itDownstream->second.begin(), itDownstream->second.end(), to);
+
+    auto itUpstream = _upstreamCones.find(to);
+    if (itUpstream != _upstreamCones.end())
+        return std::binary_search(itUpstream->second.begin(), itUpstream->second.end(), from);
+
+    ensureStrongComponents();
+
+    std::size_t const fromIndex = _strongComponentOf.at(from);
+    std::size_t const toIndex = _strongComponentOf.at(to);
+
+    if (fromIndex == toIndex)
+        return from != to || _cyclic[fromIndex];
+
+    if (fromIndex > toIndex)
+        return false;
+
+    // Nodes placed after the target in the order cannot reach it.
+    FlatHashSet<NodeId> seen;
+    seen.insert(from);
+
+    std::vector<NodeId> stack{from};
+
+    while (!stack.empty()) {
+        NodeId const nodeId = stack.back();
+        stack.pop_back();
+
+        for (NodeId const successor : _vertices.at(nodeId).successors) {
+            std::size_t const index = _strongComponentOf.at(successor);
+
+            if (index == toIndex)
+                return true;
+
+            if (index < toIndex && seen.insert(successor).second)
+                stack.push_back(successor);
+        }
+    }
+
+    return false;
+}
+
+std::size_t GraphAnalysis::depth(NodeId const nodeId) const
+{
+    ensureDepths();
+
+    auto it = _strongComponentOf.find(nodeId);
+    return it != _strongComponentOf.end() ? _depths[it->second] : 0;
+}
+
+std::vector<NodeId> GraphAnalysis::longestPath() const
+{
+    ensureDepths();
+
+    std::size_t deepest = _strongComponents.size();
+
+    for (std::size_t index = 0; index < _strongComponents.size(); ++index) {
+        if (_strongComponents[index].empty())
+            continue;
+
+        if (deepest == _strongComponents.size() || _depths[index] > _depths[deepest])
+            deepest = index;
+    }
+
+    std::vector<NodeId> result;
+
+    if (deepest == _strongComponents.size())
+        return result;
+
+    // Walks back along the deepest connections, one strong component a step.
+    std::size_t index = deepest;
+    NodeId exit = InvalidNodeId;
+
+    for (;;) {
+        auto const &edge = _deepestEdge[index];
+
+        NodeId entry = edge.second;
+        if (entry == InvalidNodeId)
+            entry = exit != InvalidNodeId ? exit : _strongComponents[index].front();
+
+        if (exit != InvalidNodeId && exit != entry)
+            result.push_back(exit);
+
+        result.push_back(entry);
+
+        if (edge.first == InvalidNodeId)
+            break;
+
+        exit = edge.first;
+        index = _strongComponentOf.at(exit);
+    }
+
+    std::reverse(result.begin(), result.end());
+
+    return result;
+}
+
+std::size_t GraphAnalysis::componentCount() const
+{
+    ensureComponents();
+
+    return _componentCount;
+}
+
+NodeId GraphAnalysis::component(NodeId const nodeId) const
+{
+    ensureComponents();
+
+    return _componentParent.contains(nodeId) ? findRoot(nodeId) : InvalidNodeId;
+}
+
+std::vector<std::vector<NodeId>> GraphAnalysis::components() const
+{
+    ensureComponents();
+
+    std::vector<std::vector<NodeId>> result;
+    result.reserve(_componentCount);
+
+    FlatHashMap<NodeId, std::size_t> indexOfRoot;
+    indexOfRoot.reserve(_componentCount);
+
+    for (auto const &entry : _vertices) {
+        NodeId const root = findRoot(entry.first);
+
+        auto inserted = indexOfRoot.insert(std::make_pair(root, result.size()));
+        if (inserted.second)
+            result.emplace_back();
+
+        result[inserted.first->second].push_back(entry.first);
+    }
+
+    return result;
+}
+
+void GraphAnalysis::onNodeCreated(NodeId const nodeId)
+{
+    if (!_verticesValid || _vertices.contains(nodeId))
+        return;
+
+    addVertex(nodeId);
+}
+
+void GraphAnalysis::onNodeDeleted(NodeId const nodeId)
+{
+    if (!_verticesValid || !_vertices.contains(nodeId))
+        return;
+
+    // The models normally report the connections of the node first.
+    Vertex const vertex = _vertices.at(nodeId);
+
+    for (NodeId const successor : vertex.successors)
+        removeEdge(nodeId, successor);
+
+    for (NodeId const predecessor : vertex.predecessors)
+        removeEdge(predecessor, nodeId);
+
+    _downstreamCones.erase(nodeId);
+    _upstreamCones.erase(nodeId);
+
+    _depthsValid = false;
+
+    // A node without connections forms its own strong component and its own
+    // connected component, unless the caches are already stale.
+    if (_strongComponentsValid) {
+        std::size_t const index = _strongComponentOf.at(nodeId);
+
+        if (_strongComponents[index].size() == 1) {
+            _strongComponents[index].clear();
+            _cyclic[index] = 0;
+            _strongComponentOf.erase(nodeId);
+        } else {
+            _strongComponentsValid = false;
+        }
+    }
+
+    if (_componentsValid) {
+        _componentParent.erase(nodeId);
+        --_componentCount;
+    }
+
+    _vertices.erase(nodeId);
+}
+
+void GraphAnalysis::onConnectionCreated(ConnectionId const connectionId)
+{
+    if (!_verticesValid)
+        return;
+
+    addEdge(connectionId.outNodeId, connectionId.inNodeId);
+}
+
+void GraphAnalysis::onConnectionDeleted(ConnectionId const connectionId)
+{
+    if (!_verticesValid)
+        return;
+
+    removeEdge(connectionId.outNodeId, connectionId.inNodeId);
+}
+
+void GraphAnalysis::onModelReset()
+{
+    _verticesValid = false;
+    _strongComponentsValid = false;
+    _depthsValid = false;
+    _componentsValid = false;
+
+    _vertices.clear();
+    _downstreamCones.clear();
+    _upstreamCones.clear();
+}
+
+void GraphAnalysis::ensureVertices() const
+{
+    if (_verticesValid)
+        return;
+
+    _vertices.clear();
+    _downstreamCones.clear();
+    _upstreamCones.clear();
+
+    _strongComponentsValid = false;
+    _depthsValid = false;
+    _componentsValid = false;
+
+    auto const nodeIds = _model.allNodeIds();
+
+    _vertices.reserve(nodeIds.size());
+
+    for (NodeId const nodeId : nodeIds)
+        _vertices[nodeId];
+
+    for (NodeId const nodeId : nodeIds) {
+        for (ConnectionId const &connectionId : _model.allConnectionIds(nodeId)) {
+            if (connectionId.outNodeId != nodeId || !_vertices.contains(connectionId.inNodeId))
+                continue;
+
+            _vertices.at(nodeId).successors.push_back(connectionId.inNodeId);
+            _vertices.at(connectionId.inNodeId).predecessors.push_back(nodeId);
+        }
+    }
+
+    _verticesValid = true;
+}
+
+void GraphAnalysis::ensureStrongComponents() const
+{
+    ensureVertices();
+
+    if (_strongComponentsValid)
+        return;
+
+    // Dense indices and compressed adjacency keep the traversal off the hash table.
+    std::size_t const count = _vertices.size();
+
+    std::vector<NodeId> nodes;
+    nodes.reserve(count);
+
+    FlatHashMap<NodeId, std::size_t> indexOf;
+    indexOf.reserve(count);
+
+    for (auto const &entry : _vertices) {
+        indexOf.insert(std::make_pair(entry.first, nodes.size()));
+        nodes.push_back(entry.first);
+    }
+
+    std::vector<std::size_t> offsets;
+    offsets.reserve(count + 1);
+
+    std::vector<std::size_t> targets;
+
+    for (NodeId const nodeId : nodes) {
+        offsets.push_back(targets.size());
+
+        for (NodeId const successor : _vertices.at(nodeId).successors)
+            targets.push_back(indexOf.at(successor));
+    }
+
+    offsets.push_back(targets.size());
+
+    // Iterative Tarjan, the components come out in the reverse topological order.
+    std::size_t const Unvisited = count;
+
+    std::vector<std::size_t> order(count, Unvisited);
+    std::vector<std::size_t> low(count, 0);
+    std::vector<std::uint8_t> onStack(count, 0);
+
+    std::vector<std::size_t> stack;
+
+    /// Node and the position of its next outgoing edge.
+    std::vector<std::pair<std::size_t, std::size_t>> calls;
+
+    std::vector<std::vector<NodeId>> found;
+
+    std::size_t visited = 0;
+
+    auto visit = [&](std::size_t const v) {
+        order[v] = low[v] = visited++;
+        stack.push_back(v);
+        onStack[v] = 1;
+        calls.push_back(std::make_pair(v, offsets[v]));
+    };
+
+    for (std::size_t start = 0; start < count; ++start) {
+        if (order[start] != Unvisited)
+            continue;
+
+        visit(start);
+
+        while (!calls.empty()) {
+            std::size_t const v = calls.back().first;
+
+            if (calls.back().second < offsets[v + 1]) {
+                std::size_t const w = targets[calls.back().second++];
+
+                if (order[w] == Unvisited)
+                    visit(w);
+                else if (onStack[w])
+                    low[v] = std::min(low[v], order[w]);
+
+                continue;
+            }
+
+            calls.pop_back();
+
+            if (!calls.empty()) {
+                std::size_t const caller = calls.back().first;
+                low[caller] = std::min(low[caller], low[v]);
+            }
+
+            if (low[v] != order[v])
+                continue;
+
+            found.emplace_back();
+
+            std::size_t w;
+            do {
+                w = stack.back();
+                stack.pop_back();
+                onStack[w] = 0;
+
+                found.back().push_back(nodes[w]);
+            } while (w != v);
+        }
+    }
+
+    _strongComponents.clear();
+    _strongComponents.reserve(found.size());
+
+    _strongComponentOf.clear();
+    _strongComponentOf.reserve(count);
+
+    _cyclic.clear();
+    _cyclic.reserve(found.size());
+
+    for (auto it = found.rbegin(); it != found.rend(); ++it) {
+        std::size_t const index = _strongComponents.size();
+
+        for (NodeId const nodeId : *it)
+            _strongComponentOf[nodeId] = index;
+
+        bool cyclic = it->size() > 1;
+        if (!cyclic) {
+            auto const &successors = _vertices.at(it->front()).successors;
+            cyclic = std::find(successors.begin(), successors.end(), it->front())
+                     != successors.end();
+        }
+
+        _cyclic.push_back(cyclic ? 1 : 0);
+        _strongComponents.push_back(std::move(*it));
+    }
+
+    _strongComponentsValid = true;
+}
+
+void GraphAnalysis::ensureDepths() const
+{
+    ensureStrongComponents();
+
+    if (_depthsValid)
+        return;
+
+    std::size_t const count = _strongComponents.size();
+
+    _depths.assign(count, 0);
+    _deepestEdge.assign(count, std::make_pair(InvalidNodeId, InvalidNodeId));
+
+    // The components are in the topological order, every connection between
+    // two of them goes forward.
+    for (std::size_t index = 0; index < count; ++index) {
+        for (NodeId const nodeId : _strongComponents[index]) {
+            for (NodeId const successor : _vertices.at(nodeId).successors) {
+                std::size_t const successorIndex = _strongComponentOf.at(successor);
+
+                if (successorIndex != index && _depths[index] + 1 > _depths[successorIndex]) {
+                    _depths[successorIndex] = _depths[index] + 1;
+                    _deepestEdge[successorIndex] = std::make_pair(nodeId, successor);
+                }
+            }
+        }
+    }
+
+    _depthsValid = true;
+}
+
+void GraphAnalysis::ensureComponents() const
+{
+    ensureVertices();
+
+    if (_componentsValid)
+        return;
+
+    _componentParent.clear();
+    _componentParent.reserve(_vertices.size());
+
+    for (auto const &entry : _vertices)
+        _componentParent[entry.first] = entry.first;
+
+    _componentCount = _vertices.size();
+
+    for (auto const &entry : _vertices) {
+        for (NodeId const successor : entry.second.successors) {
+            NodeId const a = findRoot(entry.first);
+            NodeId const b = findRoot(successor);
+
+            if (a != b) {
+                _componentParent.at(a) = b;
+                --_componentCount;
+            }
+        }
+    }
+
+    _componentsValid = true;
+}
+
+void GraphAnalysis::addVertex(NodeId const nodeId)
+{
+    _vertices[nodeId];
+
+    _depthsValid = false;
+
+    if (_strongComponentsValid) {
+        _strongComponentOf[nodeId] = _strongComponents.size();
+        _strongComponents.push_back(std::vector<NodeId>{nodeId});
+        _cyclic.push_back(0);
+    }
+
+    if (_componentsValid) {
+        _componentParent[nodeId] = nodeId;
+        ++_componentCount;
+    }
+}
+
+void GraphAnalysis::addEdge(NodeId const from, NodeId const to)
+{
+    if (!_vertices.contains(from))
+        addVertex(from);
+
+    if (!_vertices.contains(to))
+        addVertex(to);
+
+    _vertices.at(from).successors.push_back(to);
+    _vertices.at(to).predecessors.push_back(from);
+
+    dropCones(from, to);
+
+    _depthsValid = false;
+
+    if (_strongComponentsValid) {
+        std::size_t const fromIndex = _strongComponentOf.at(from);
+        std::size_t const toIndex = _strongComponentOf.at(to);
+
+        // A connection against the order may merge components.
+        if (fromIndex == toIndex)
+            _cyclic[fromIndex] = 1;
+        else if (fromIndex > toIndex)
+            _strongComponentsValid = false;
+    }
+
+    if (_componentsValid) {
+        NodeId const a = findRoot(from);
+        NodeId const b = findRoot(to);
+
+        if (a != b) {
+            _componentParent.at(a) = b;
+            --_componentCount;
+        }
+    }
+}
+
+void GraphAnalysis::removeEdge(NodeId const from, NodeId const to)
+{
+    if (!_vertices.contains(from) || !_vertices.contains(to))
+        return;
+
+    if (!eraseOne(_vertices.at(from).successors, to))
+        return;
+
+    eraseOne(_vertices.at(to).predecessors, from);
+
+    dropCones(from, to);
+
+    _depthsValid = false;
+
+    auto const &successors = _vertices.at(from).successors;
+    bool const stillAdjacent = std::find(successors.begin(), successors.end(), to)
+                               != successors.end();
+
+    if (_strongComponentsValid) {
+        std::size_t const index = _strongComponentOf.at(from);
+
+        // Connections between components never split them.
+        if (index == _strongComponentOf.at(to)) {
+            if (from != to)
+                _strongComponentsValid = false;
+            else if (_strongComponents[index].size() == 1 && !stillAdjacent)
+                _cyclic[index] = 0;
+        }
+    }
+
+    if (_componentsValid && from != to && !stillAdjacent) {
+        auto const &reverse = _vertices.at(to).successors;
+
+        if (std::find(reverse.begin(), reverse.end(), from) == reverse.end())
+            _componentsValid = false;
+    }
+}
+
+void GraphAnalysis::dropCones(NodeId const from, NodeId const to)
+{
+    auto drop = [](FlatHashMap<NodeId, std::vector<NodeId>> &cones, NodeId const nodeId) {
+        std::vector<NodeId> stale;
+
+        for (auto const &entry : cones) {
+            if (entry.first == nodeId
+                || std::binary_search(entry.second.begin(), entry.second.end(), nodeId))
+                stale.push_back(entry.first);
+        }
+
+        for (NodeId const key : stale)
+            cones.erase(key);
+    };
+
+    drop(_downstreamCones, from);
+    drop(_upstreamCones, to);
+}
+
+std::vector<NodeId> GraphAnalysis::cone(NodeId const nodeId, bool downstream) const
+{
+    ensureVertices();
+
+    if (!_vertices.contains(nodeId))
+        return {};
+
+    auto &cones = downstream ? _downstreamCones : _upstreamCones;
+
+    auto it = cones.find(nodeId);
+    if (it != cones.end())
+        return it->second;
+
+    std::vector<NodeId> result;
+
+    FlatHashSet<NodeId> seen;
+    std::vector<NodeId> stack{nodeId};
+
+    while (!stack.empty()) {
+        Vertex const &vertex = _vertices.at(stack.back());
+        stack.pop_back();
+
+        for (NodeId const next : downstream ? vertex.successors : vertex.predecessors) {
+            if (seen.insert(next).second) {
+                result.push_back(next);
+                stack.push_back(next);
+            }
+        }
+    }
+
+    std::sort(result.begin(), result.end());
+
+    // The cones are dropped one by one as the graph changes; a bounded cache
+    // keeps that scan short.
+    if (cones.size() >= MaxCachedCones)
+        cones.clear();
+
+    cones[nodeId] = result;
+
+    return result;
+}
+
+NodeId GraphAnalysis::findRoot(NodeId nodeId) const
+{
+    // Path halving.
+    for (;;) {
+        NodeId &parent = _componentParent.at(nodeId);
+
+        if (parent == nodeId)
+            return nodeId;
+
+        NodeId const grandParent = _componentParent.at(parent);
+        parent = grandParent;
+        nodeId = grandParent;
+    }
+}
+
+} // namespace QtNodes
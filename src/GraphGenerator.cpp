@@ -0,0 +1,399 @@
+#include "GraphGenerator.hpp"
+
+#include "AbstractGraphModel.hpp"
+#include "ConnectionIdUtils.hpp"
+
+#include <QtCore/QJsonArray>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace QtNodes {
+
+namespace {
+
+/// SplitMix64. Unlike the standard distributions it yields the same
+/// sequence with every compiler and standard library.
+class Random
+{
+public:
+    explicit Random(quint64 seed)
+        : _state(seed)
+    {}
+
+    quint64 next()
+    {
+        quint64 z = (_state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    /// Uniform value in [0, n), n must be positive.
+    unsigned int below(unsigned int n) { return static_cast<unsigned int>(next() % n); }
+
+    /// Uniform value in [0, 1).
+    double unit() { return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0); }
+
+private:
+    quint64 _state;
+};
+
+enum class NodeRoleInGraph { Root, Inner, Leaf };
+
+class Builder
+{
+public:
+    Builder(GraphGeneratorOptions const &options)
+        : _options(options)
+        , _random(options.seed)
+    {
+        for (unsigned int t = 0; t < options.nodeTypes.size(); ++t) {
+            GeneratedNodeType const &type = options.nodeTypes[t];
+
+            if (type.inPorts == 0 && type.outPorts > 0)
+                _rootTypes.push_back(t);
+            else if (type.inPorts > 0 && type.outPorts > 0)
+                _innerTypes.push_back(t);
+            else if (type.inPorts > 0)
+                _leafTypes.push_back(t);
+        }
+
+        if (_innerTypes.empty() && options.nodeCount > 2)
+            throw std::logic_error("Graph generator needs a node type with inputs and outputs");
+
+        // Models without dedicated sources or sinks use the inner types there.
+        if (_rootTypes.empty())
+            _rootTypes = _innerTypes;
+
+        if (_leafTypes.empty())
+            _leafTypes = _innerTypes;
+
+        if (_rootTypes.empty())
+            throw std::logic_error("Graph generator needs a node type with outputs");
+
+        _graph.nodeTypes = options.nodeTypes;
+        _graph.nodes.reserve(options.nodeCount);
+
+        _fanOut.reserve(options.nodeCount);
+        _rank.reserve(options.nodeCount);
+    }
+
+    GeneratedGraph take() { return std::move(_graph); }
+
+    unsigned int addNode(NodeRoleInGraph role)
+    {
+        std::vector<unsigned int> const &candidates = role == NodeRoleInGraph::Root
+                                                          ? _rootTypes
+                                                      : role == NodeRoleInGraph::Leaf
+                                                          ? _leafTypes
+                                                          : _innerTypes;
+
+        unsigned int const type = candidates[_random.below(
+            static_cast<unsigned int>(candidates.size()))];
+
+        _graph.nodes.push_back(GeneratedGraph::Node{type, QPointF()});
+        _fanOut.push_back(0);
+        _rank.push_back(0);
+
+        return static_cast<unsigned int>(_graph.nodes.size() - 1);
+    }
+
+    unsigned int inPorts(unsigned int node) const
+    {
+        unsigned int const ports = _graph.nodeTypes[_graph.nodes[node].type].inPorts;
+
+        return _options.maxFanIn > 0 ? std::min(ports, _options.maxFanIn) : ports;
+    }
+
+    bool canFeed(unsigned int node) const
+    {
+        return _graph.nodeTypes[_graph.nodes[node].type].outPorts > 0
+               && (_options.maxFanOut == 0 || _fanOut[node] < _options.maxFanOut);
+    }
+
+    /// Random upstream node from [first, last) which still accepts connections.
+    bool pick(unsigned int first, unsigned int last, unsigned int &result)
+    {
+        if (first >= last)
+            return false;
+
+        for (int attempt = 0; attempt < 8; ++attempt) {
+            unsigned int const candidate = first + _random.below(last - first);
+
+            if (canFeed(candidate)) {
+                result = candidate;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void connect(unsigned int outNode, unsigned int inNode, PortIndex inPort)
+    {
+        unsigned int const outPorts = _graph.nodeTypes[_graph.nodes[outNode].type].outPorts;
+
+        _graph.connections.push_back(
+            GeneratedGraph::Connection{outNode, _random.below(outPorts), inNode, inPort});
+
+        ++_fanOut[outNode];
+
+        _rank[inNode] = std::max(_rank[inNode], _rank[outNode] + 1);
+    }
+
+    double chance() { return _random.unit(); }
+
+    /// Columns are the longest distance from the roots.
+    void layoutByRank()
+    {
+        std::vector<unsigned int> rows;
+
+        for (unsigned int i = 0; i < _graph.nodes.size(); ++i) {
+            unsigned int const column = _rank[i];
+
+            if (rows.size() <= column)
+                rows.resize(column + 1, 0);
+
+            place(i, column, rows[column]++);
+        }
+    }
+
+    void layoutAsGrid(unsigned int columns)
+    {
+        for (unsigned int i = 0; i < _graph.nodes.size(); ++i) {
+            place(i, i % columns, i / columns);
+        }
+    }
+
+private:
+    void place(unsigned int node, unsigned int column, unsigned int row)
+    {
+        _graph.nodes[node].position = QPointF(column * _options.spacing.x(),
+                                              row * _options.spacing.y());
+    }
+
+private:
+    GraphGeneratorOptions const &_options;
+
+    Random _random;
+
+    std::vector<unsigned int> _rootTypes;
+    std::vector<unsigned int> _innerTypes;
+    std::vector<unsigned int> _leafTypes;
+
+    GeneratedGraph _graph;
+
+    std::vector<unsigned int> _fanOut;
+    std::vector<unsigned int> _rank;
+};
+
+unsigned int squareRoot(unsigned int n)
+{
+    return std::max(1u, static_cast<unsigned int>(std::sqrt(static_cast<double>(n))));
+}
+
+void generateChain(GraphGeneratorOptions const &options, Builder &builder)
+{
+    unsigned int const n = options.nodeCount;
+
+    for (unsigned int i = 0; i < n; ++i) {
+        NodeRoleInGraph const role = i == 0           ? NodeRoleInGraph::Root
+                                     : (i + 1 == n)   ? NodeRoleInGraph::Leaf
+                                                      : NodeRoleInGraph::Inner;
+        builder.addNode(role);
+
+        if (i > 0 && builder.inPorts(i) > 0 && builder.canFeed(i - 1))
+            builder.connect(i - 1, i, 0);
+    }
+
+    // A long chain is wrapped into rows.
+    builder.layoutAsGrid(squareRoot(n));
+}
+
+void generateTree(GraphGeneratorOptions const &options, Builder &builder)
+{
+    unsigned int const n = options.nodeCount;
+    unsigned int const branching = std::max(1u, options.branching);
+
+    for (unsigned int i = 0; i < n; ++i) {
+        bool const hasChildren = static_cast<quint64>(i) * branching + 1 < n;
+
+        NodeRoleInGraph const role = i == 0         ? NodeRoleInGraph::Root
+                                     : hasChildren ? NodeRoleInGraph::Inner
+                                                   : NodeRoleInGraph::Leaf;
+        builder.addNode(role);
+
+        if (i > 0 && builder.inPorts(i) > 0) {
+            unsigned int const parent = (i - 1) / branching;
+
+            // The parents are never limited by `maxFanOut` in a tree.
+            builder.connect(parent, i, 0);
+        }
+    }
+
+    builder.layoutByRank();
+}
+
+void generateLayered(GraphGeneratorOptions const &options, Builder &builder)
+{
+    unsigned int const n = options.nodeCount;
+    unsigned int const width = options.layerWidth > 0 ? options.layerWidth : squareRoot(n);
+    unsigned int const lastLayer = (n - 1) / width;
+
+    for (unsigned int i = 0; i < n; ++i) {
+        unsigned int const layer = i / width;
+
+        NodeRoleInGraph const role = layer == 0                           ? NodeRoleInGraph::Root
+                                     : (layer == lastLayer && layer > 1) ? NodeRoleInGraph::Leaf
+                                                                          : NodeRoleInGraph::Inner;
+        builder.addNode(role);
+
+        if (layer == 0)
+            continue;
+
+        unsigned int const previousLayerStart = (layer - 1) * width;
+
+        for (unsigned int port = 0; port < builder.inPorts(i); ++port) {
+            unsigned int upstream = 0;
+            if (builder.pick(previousLayerStart, previousLayerStart + width, upstream))
+                builder.connect(upstream, i, port);
+        }
+    }
+
+    builder.layoutByRank();
+}
+
+void generateRandom(GraphGeneratorOptions const &options, Builder &builder)
+{
+    unsigned int const n = options.nodeCount;
+    unsigned int const rootCount = std::max(1u, n / 10);
+
+    for (unsigned int i = 0; i < n; ++i) {
+        builder.addNode(i < rootCount ? NodeRoleInGraph::Root : NodeRoleInGraph::Inner);
+
+        if (i < rootCount)
+            continue;
+
+        // Connections go only forward, so the graph never has cycles.
+        for (unsigned int port = 0; port < builder.inPorts(i); ++port) {
+            if (builder.chance() >= options.connectionProbability)
+                continue;
+
+            unsigned int upstream = 0;
+            if (builder.pick(0, i, upstream))
+                builder.connect(upstream, i, port);
+        }
+    }
+
+    builder.layoutByRank();
+}
+
+} // namespace
+
+QJsonObject GeneratedGraph::toJson() const
+{
+    QJsonArray nodesJsonArray;
+
+    for (unsigned int i = 0; i < nodes.size(); ++i) {
+        GeneratedNodeType const &type = nodeTypes[nodes[i].type];
+
+        QJsonObject internalData = type.internalData;
+        internalData["model-name"] = type.modelName;
+
+        QJsonObject posJson;
+        posJson["x"] = nodes[i].position.x();
+        posJson["y"] = nodes[i].position.y();
+
+        QJsonObject nodeJson;
+        nodeJson["id"] = static_cast<qint64>(i);
+        nodeJson["internal-data"] = internalData;
+        nodeJson["position"] = posJson;
+
+        nodesJsonArray.append(nodeJson);
+    }
+
+    QJsonArray connJsonArray;
+
+    for (Connection const &c : connections) {
+        connJsonArray.append(
+            QtNodes::toJson(ConnectionId{c.outNode, c.outPort, c.inNode, c.inPort}));
+    }
+
+    QJsonObject sceneJson;
+    sceneJson["nodes"] = nodesJsonArray;
+    sceneJson["connections"] = connJsonArray;
+
+    return sceneJson;
+}
+
+std::vector<NodeId> GeneratedGraph::populate(AbstractGraphModel &model) const
+{
+    std::vector<NodeId> ids;
+    ids.reserve(nodes.size());
+
+    for (Node const &node : nodes) {
+        NodeId const nodeId = model.addNode(nodeTypes[node.type].modelName);
+
+        model.setNodeData(nodeId, NodeRole::Position, node.position);
+
+        ids.push_back(nodeId);
+    }
+
+    for (Connection const &c : connections) {
+        model.addConnection(ConnectionId{ids[c.outNode], c.outPort, ids[c.inNode], c.inPort});
+    }
+
+    return ids;
+}
+
+std::vector<GeneratedNodeType> GraphGenerator::calculatorNodeTypes()
+{
+    QJsonObject sourceData;
+    sourceData["number"] = QStringLiteral("1");
+
+    return {GeneratedNodeType{"NumberSource", 0, 1, sourceData},
+            GeneratedNodeType{"Addition", 2, 1, QJsonObject()},
+            GeneratedNodeType{"Subtraction", 2, 1, QJsonObject()},
+            GeneratedNodeType{"Multiplication", 2, 1, QJsonObject()},
+            GeneratedNodeType{"Division", 2, 1, QJsonObject()},
+            GeneratedNodeType{"Result", 1, 0, QJsonObject()}};
+}
+
+std::vector<GeneratedNodeType> GraphGenerator::simpleNodeTypes()
+{
+    return {GeneratedNodeType{"Default Node Type", 1, 1, QJsonObject()}};
+}
+
+GeneratedGraph GraphGenerator::generate(GraphGeneratorOptions const &options)
+{
+    GraphGeneratorOptions effective = options;
+
+    if (effective.nodeTypes.empty())
+        effective.nodeTypes = calculatorNodeTypes();
+
+    Builder builder(effective);
+
+    switch (effective.topology) {
+    case GraphGeneratorOptions::Topology::Chain:
+        generateChain(effective, builder);
+        break;
+
+    case GraphGeneratorOptions::Topology::Tree:
+        generateTree(effective, builder);
+        break;
+
+    case GraphGeneratorOptions::Topology::Layered:
+        generateLayered(effective, builder);
+        break;
+
+    case GraphGeneratorOptions::Topology::Random:
+        generateRandom(effective, builder);
+        break;
+    }
+
+    return builder.take();
+}
+
+} // namespace QtNodes
@@ -0,0 +1,127 @@
+#include "GraphProfiler.hpp"
+
+#include <QtCore/QTimer>
+
+#include <algorithm>
+
+namespace QtNodes {
+
+void ProfileStats::add(qint64 durationNs, qint64 selfDurationNs, qint64 endNs)
+{
+    ++count;
+    totalNs += durationNs;
+    selfNs += selfDurationNs;
+    maxNs = std::max(maxNs, durationNs);
+    lastNs = durationNs;
+    lastEndNs = endNs;
+}
+
+GraphProfiler::GraphProfiler(QObject *parent)
+    : QObject(parent)
+    , _enabled(false)
+    , _updateScheduled(false)
+{
+    _clock.start();
+}
+
+void GraphProfiler::setEnabled(bool enabled)
+{
+    // Measurements which are already running are finished by their
+    // ScopedProfile instances regardless of the flag.
+    _enabled = enabled;
+}
+
+void GraphProfiler::reset()
+{
+    _nodes.clear();
+    _totals = {};
+
+    scheduleUpdateSignal();
+}
+
+ProfileStats GraphProfiler::stats(NodeId const nodeId, ProfileCategory const category) const
+{
+    auto it = _nodes.find(nodeId);
+    if (it == _nodes.end())
+        return ProfileStats();
+
+    return it->second[category];
+}
+
+void GraphProfiler::removeNode(NodeId const nodeId)
+{
+    _nodes.erase(nodeId);
+}
+
+void GraphProfiler::begin(NodeId const nodeId, ProfileCategory const category)
+{
+    _frames.push_back(Frame{nodeId, category, now(), 0});
+}
+
+void GraphProfiler::end()
+{
+    if (_frames.empty())
+        return;
+
+    Frame const frame = _frames.back();
+    _frames.pop_back();
+
+    qint64 const endNs = now();
+    qint64 const duration = endNs - frame.startNs;
+    qint64 const self = std::max<qint64>(duration - frame.childrenNs, 0);
+
+    if (!_frames.empty())
+        _frames.back().childrenNs += duration;
+
+    int const c = static_cast<int>(frame.category);
+
+    _totals[c].add(duration, self, endNs);
+
+    if (frame.nodeId != InvalidNodeId)
+        _nodes[frame.nodeId].stats[c].add(duration, self, endNs);
+
+    for (auto listener : _listeners)
+        listener->measured(frame.nodeId, frame.category, frame.startNs, endNs);
+
+    if (frame.category == ProfileCategory::SetInData
+        || frame.category == ProfileCategory::Propagation)
+        scheduleUpdateSignal();
+}
+
+void GraphProfiler::mark(ProfileMark const mark, NodeId const nodeId, PortIndex const portIndex)
+{
+    if (!_enabled || _listeners.empty())
+        return;
+
+    qint64 const timeNs = now();
+
+    for (auto listener : _listeners)
+        listener->marked(mark, nodeId, portIndex, timeNs);
+}
+
+void GraphProfiler::addListener(AbstractProfileListener *listener)
+{
+    if (std::find(_listeners.begin(), _listeners.end(), listener) == _listeners.end())
+        _listeners.push_back(listener);
+}
+
+void GraphProfiler::removeListener(AbstractProfileListener *listener)
+{
+    _listeners.erase(std::remove(_listeners.begin(), _listeners.end(), listener),
+                     _listeners.end());
+}
+
+void GraphProfiler::scheduleUpdateSignal()
+{
+    if (_updateScheduled)
+        return;
+
+    _updateScheduled = true;
+
+    QTimer::singleShot(0, this, [this]() {
+        _updateScheduled = false;
+        Q_EMIT profileUpdated();
+    });
+}
+
+} // namespace QtNodes
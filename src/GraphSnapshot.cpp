@@ -0,0 +1,71 @@
+#include "GraphSnapshot.hpp"
+
+#include "SlotAllocator.hpp"
+
+namespace QtNodes {
+
+SnapshotNode const *GraphSnapshot::node(NodeId const nodeId) const
+{
+    if (!SlotAllocator::isWellFormed(nodeId))
+        return nullptr;
+
+    std::size_t const slot = SlotAllocator::slotIndex(nodeId);
+    std::size_t const chunkIndex = slot / ChunkSize;
+
+    if (chunkIndex >= _chunks.size() || !_chunks[chunkIndex])
+        return nullptr;
+
+    SnapshotNode const &n = _chunks[chunkIndex]->nodes[slot % ChunkSize];
+
+    // The generation stored in the id tells the stale ids apart.
+    return n.id == nodeId ? &n : nullptr;
+}
+
+std::vector<ConnectionId> const &GraphSnapshot::connections(NodeId const nodeId) const
+{
+    static std::vector<ConnectionId> const empty;
+
+    SnapshotNode const *n = node(nodeId);
+    return n ? n->connections : empty;
+}
+
+std::vector<NodeId> GraphSnapshot::nodeIds() const
+{
+    std::vector<NodeId> result;
+    result.reserve(_nodeCount);
+
+    forEachNode([&result](SnapshotNode const &n) { result.push_back(n.id); });
+
+    return result;
+}
+
+std::vector<ConnectionId> GraphSnapshot::allConnections() const
+{
+    std::vector<ConnectionId> result;
+    result.reserve(_connectionCount);
+
+    forEachNode([&result](SnapshotNode const &n) {
+        for (ConnectionId const &cid : n.connections) {
+            if (cid.outNodeId == n.id)
+                result.push_back(cid);
+        }
+    });
+
+    return result;
+}
+
+void GraphSnapshot::updateCounts()
+{
+    _nodeCount = 0;
+    _connectionCount = 0;
+
+    for (auto const &chunk : _chunks) {
+        if (!chunk)
+            continue;
+
+        _nodeCount += chunk->nodeCount;
+        _connectionCount += chunk->connectionCount;
+    }
+}
+
+} // namespace QtNodes
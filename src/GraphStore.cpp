@@ -0,0 +1,194 @@
+#include "GraphStore.hpp"
+
+#include "ConnectionIdUtils.hpp"
+
+#include <algorithm>
+
+namespace QtNodes {
+
+NodeId GraphStoreBase::reserve()
+{
+    NodeId const nodeId = _slots.reserve();
+
+    _nodes.resize(_slots.slotCount());
+
+    return nodeId;
+}
+
+QPointF GraphStoreBase::position(NodeId const nodeId) const
+{
+    return contains(nodeId) ? _nodes[SlotAllocator::slotIndex(nodeId)].position : QPointF();
+}
+
+QSize GraphStoreBase::size(NodeId const nodeId) const
+{
+    return contains(nodeId) ? _nodes[SlotAllocator::slotIndex(nodeId)].size : QSize();
+}
+
+PortCount GraphStoreBase::portCount(NodeId const nodeId, PortType const portType) const
+{
+    if (!contains(nodeId))
+        return 0;
+
+    Node const &node = _nodes[SlotAllocator::slotIndex(nodeId)];
+
+    switch (portType) {
+    case PortType::In:
+        return node.inPortCount;
+
+    case PortType::Out:
+        return node.outPortCount;
+
+    case PortType::None:
+        break;
+    }
+
+    return 0;
+}
+
+bool GraphStoreBase::setPosition(NodeId const nodeId, QPointF const &position)
+{
+    if (!contains(nodeId))
+        return false;
+
+    _nodes[SlotAllocator::slotIndex(nodeId)].position = position;
+    return true;
+}
+
+bool GraphStoreBase::setSize(NodeId const nodeId, QSize const &size)
+{
+    if (!contains(nodeId))
+        return false;
+
+    _nodes[SlotAllocator::slotIndex(nodeId)].size = size;
+    return true;
+}
+
+bool GraphStoreBase::setPortCount(NodeId const nodeId,
+                                  PortType const portType,
+                                  PortCount const count)
+{
+    if (!contains(nodeId))
+        return false;
+
+    Node &node = _nodes[SlotAllocator::slotIndex(nodeId)];
+
+    switch (portType) {
+    case PortType::In:
+        node.inPortCount = count;
+        return true;
+
+    case PortType::Out:
+        node.outPortCount = count;
+        return true;
+
+    case PortType::None:
+        break;
+    }
+
+    return false;
+}
+
+bool GraphStoreBase::addConnection(ConnectionId const &connectionId)
+{
+    if (!contains(connectionId.outNodeId) || !contains(connectionId.inNodeId))
+        return false;
+
+    if (!_connectivity.insert(connectionId).second)
+        return false;
+
+    _nodes[SlotAllocator::slotIndex(connectionId.outNodeId)].connections.push_back(connectionId);
+
+    if (connectionId.inNodeId != connectionId.outNodeId)
+        _nodes[SlotAllocator::slotIndex(connectionId.inNodeId)].connections.push_back(connectionId);
+
+    return true;
+}
+
+bool GraphStoreBase::removeConnection(ConnectionId const &connectionId)
+{
+    if (_connectivity.erase(connectionId) == 0)
+        return false;
+
+    detach(connectionId.outNodeId, connectionId);
+    detach(connectionId.inNodeId, connectionId);
+
+    return true;
+}
+
+std::vector<ConnectionId> const &GraphStoreBase::connections(NodeId const nodeId) const
+{
+    static std::vector<ConnectionId> const empty;
+
+    return contains(nodeId) ? _nodes[SlotAllocator::slotIndex(nodeId)].connections : empty;
+}
+
+std::vector<ConnectionId> GraphStoreBase::connections(NodeId const nodeId,
+                                                      PortType const portType,
+                                                      PortIndex const portIndex) const
+{
+    std::vector<ConnectionId> result;
+
+    for (ConnectionId const &connectionId : connections(nodeId)) {
+        if (getNodeId(portType, connectionId) == nodeId
+            && getPortIndex(portType, connectionId) == portIndex)
+            result.push_back(connectionId);
+    }
+
+    return result;
+}
+
+std::size_t GraphStoreBase::occupy(NodeId const nodeId)
+{
+    std::size_t const index = _slots.occupy(nodeId);
+
+    _nodes.resize(_slots.slotCount());
+
+    _nodes[index] = Node();
+
+    return index;
+}
+
+bool GraphStoreBase::release(NodeId const nodeId)
+{
+    if (!contains(nodeId))
+        return false;
+
+    std::size_t const index = SlotAllocator::slotIndex(nodeId);
+
+    // A copy, detaching edits the list.
+    std::vector<ConnectionId> const attached = _nodes[index].connections;
+
+    for (ConnectionId const &connectionId : attached)
+        removeConnection(connectionId);
+
+    _nodes[index] = Node();
+
+    return _slots.release(nodeId);
+}
+
+void GraphStoreBase::releaseAll()
+{
+    for (Node &node : _nodes)
+        node = Node();
+
+    _slots.releaseAll();
+
+    _connectivity.clear();
+}
+
+void GraphStoreBase::detach(NodeId const nodeId, ConnectionId const &connectionId)
+{
+    if (!contains(nodeId))
+        return;
+
+    std::vector<ConnectionId> &attached = _nodes[SlotAllocator::slotIndex(nodeId)].connections;
+
+    auto it = std::find(attached.begin(), attached.end(), connectionId);
+    if (it != attached.end()) {
+        *it = attached.back();
+        attached.pop_back();
+    }
+}
+
+} // namespace QtNodes
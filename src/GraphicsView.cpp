@@ -2,6 +2,7 @@
 
 #include "BasicGraphicsScene.hpp"
 #include "ConnectionGraphicsObject.hpp"
+#include "GraphProfiler.hpp"
 #include "NodeGraphicsObject.hpp"
 #include "StyleCollection.hpp"
 #include "UndoCommands.hpp"
@@ -20,11 +21,75 @@
 #include <QtOpenGL>
 #include <QtWidgets>
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
+using QtNodes::AbstractOverlayPainter;
 using QtNodes::BasicGraphicsScene;
+using QtNodes::ConnectionGraphicsObject;
 using QtNodes::GraphicsView;
+using QtNodes::GraphProfiler;
+using QtNodes::NodeGraphicsObject;
+using QtNodes::ProfileCategory;
+using QtNodes::ViewStatistics;
+
+namespace {
+
+/// Draws `GraphicsView::statistics()` in the top left corner.
+class StatisticsOverlayPainter : public AbstractOverlayPainter
+{
+public:
+    void paint(QPainter *painter, GraphicsView const &view) const override
+    {
+        ViewStatistics const &s = view.statistics();
+
+        QStringList lines;
+        lines << QString("%1 fps, frame %2 ms (max %3 ms)")
+                     .arg(s.framesPerSecond, 0, 'f', 1)
+                     .arg(s.lastFrameMs, 0, 'f', 2)
+                     .arg(s.maxFrameMs, 0, 'f', 2);
+        lines << QString("Nodes %1 / %2, connections %3 / %4")
+                     .arg(s.visibleNodes)
+                     .arg(s.totalNodes)
+                     .arg(s.visibleConnections)
+                     .arg(s.totalConnections);
+        lines << QString("Painted: %1 nodes %2 ms, %3 connections %4 ms")
+                     .arg(s.nodesPainted)
+                     .arg(s.nodePaintMs, 0, 'f', 2)
+                     .arg(s.connectionsPainted)
+                     .arg(s.connectionPaintMs, 0, 'f', 2);
+        lines << QString("Node cache hits %1%").arg(s.nodeCacheHitRate * 100.0, 0, 'f', 0);
+
+        QFontMetrics const metrics(painter->font());
+
+        int width = 0;
+        for (QString const &line : lines)
+            width = std::max(width, metrics.horizontalAdvance(line));
+
+        int const margin = 10;
+        int const padding = 6;
+
+        QRect const box(margin,
+                        margin,
+                        width + 2 * padding,
+                        lines.size() * metrics.height() + 2 * padding);
+
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(QColor(0, 0, 0, 160));
+        painter->drawRoundedRect(box, 3, 3);
+
+        painter->setPen(Qt::white);
+
+        int y = box.top() + padding + metrics.ascent();
+        for (QString const &line : lines) {
+            painter->drawText(box.left() + padding, y, line);
+            y += metrics.height();
+        }
+    }
+};
+
+} // namespace
 
 GraphicsView::GraphicsView(QWidget *parent)
     : QGraphicsView(parent)
@@ -385,6 +450,174 @@ void GraphicsView::drawBackground(QPainter *painter, const QRectF &r)
     drawGrid(150);
 }
 
+void GraphicsView::drawForeground(QPainter *painter, const QRectF &r)
+{
+    QGraphicsView::drawForeground(painter, r);
+
+    if (_overlayPainters.empty())
+        return;
+
+    painter->save();
+    painter->resetTransform();
+
+    for (auto const &overlay : _overlayPainters) {
+        overlay->paint(painter, *this);
+    }
+
+    painter->restore();
+}
+
+AbstractOverlayPainter *GraphicsView::addOverlayPainter(
+    std::unique_ptr<AbstractOverlayPainter> overlay)
+{
+    AbstractOverlayPainter *result = overlay.get();
+
+    if (_overlayPainters.empty())
+        _overlaylessUpdateMode = viewportUpdateMode();
+
+    _overlayPainters.push_back(std::move(overlay));
+
+    // Partial updates would leave stale overlay pixels when scrolling.
+    setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
+
+    viewport()->update();
+
+    return result;
+}
+
+void GraphicsView::removeOverlayPainter(AbstractOverlayPainter *overlay)
+{
+    auto it = std::find_if(_overlayPainters.begin(),
+                           _overlayPainters.end(),
+                           [overlay](auto const &p) { return p.get() == overlay; });
+
+    if (it == _overlayPainters.end())
+        return;
+
+    if (overlay == _statisticsOverlay)
+        _statisticsOverlay = nullptr;
+
+    _overlayPainters.erase(it);
+
+    if (_overlayPainters.empty())
+        setViewportUpdateMode(_overlaylessUpdateMode);
+
+    viewport()->update();
+}
+
+void GraphicsView::setStatisticsEnabled(bool enabled)
+{
+    if (!enabled && _statisticsOverlay)
+        setStatisticsVisible(false);
+
+    _statisticsEnabled = enabled;
+
+    resetStatistics();
+}
+
+void GraphicsView::resetStatistics()
+{
+    _statistics = ViewStatistics();
+    _recentFrames.clear();
+    _statisticsClock.start();
+}
+
+void GraphicsView::setStatisticsVisible(bool visible)
+{
+    if (visible == statisticsVisible())
+        return;
+
+    if (visible) {
+        if (!_statisticsEnabled)
+            setStatisticsEnabled(true);
+
+        _statisticsOverlay = addOverlayPainter(std::make_unique<StatisticsOverlayPainter>());
+    } else {
+        removeOverlayPainter(_statisticsOverlay);
+    }
+}
+
+void GraphicsView::paintEvent(QPaintEvent *event)
+{
+    if (!_statisticsEnabled) {
+        QGraphicsView::paintEvent(event);
+        return;
+    }
+
+    BasicGraphicsScene *scene = nodeScene();
+
+    GraphProfiler *profiler = (scene && scene->profiler() && scene->profiler()->isEnabled())
+                                  ? scene->profiler()
+                                  : nullptr;
+
+    auto const nodesBefore = profiler ? profiler->totals(ProfileCategory::PaintNode)
+                                      : QtNodes::ProfileStats();
+    auto const connectionsBefore = profiler ? profiler->totals(ProfileCategory::PaintConnection)
+                                            : QtNodes::ProfileStats();
+
+    qint64 const startNs = _statisticsClock.nsecsElapsed();
+
+    QGraphicsView::paintEvent(event);
+
+    qint64 const endNs = _statisticsClock.nsecsElapsed();
+
+    ViewStatistics &s = _statistics;
+
+    ++s.frameCount;
+    s.lastFrameMs = (endNs - startNs) / 1.0e6;
+    s.maxFrameMs = std::max(s.maxFrameMs, s.lastFrameMs);
+
+    _recentFrames.push_back(endNs);
+    while (_recentFrames.front() < endNs - 1000000000)
+        _recentFrames.pop_front();
+
+    s.framesPerSecond = static_cast<double>(_recentFrames.size());
+
+    if (profiler) {
+        auto const &nodesAfter = profiler->totals(ProfileCategory::PaintNode);
+        auto const &connectionsAfter = profiler->totals(ProfileCategory::PaintConnection);
+
+        s.nodesPainted = static_cast<int>(nodesAfter.count - nodesBefore.count);
+        s.nodePaintMs = (nodesAfter.totalNs - nodesBefore.totalNs) / 1.0e6;
+
+        s.connectionsPainted = static_cast<int>(connectionsAfter.count - connectionsBefore.count);
+        s.connectionPaintMs = (connectionsAfter.totalNs - connectionsBefore.totalNs) / 1.0e6;
+    }
+
+    s.visibleNodes = 0;
+    s.visibleConnections = 0;
+    s.totalNodes = 0;
+    s.totalConnections = 0;
+
+    if (scene) {
+        QRectF const visibleRect = mapToScene(viewport()->rect()).boundingRect();
+
+        for (QGraphicsItem *item : scene->items()) {
+            int const type = item->type();
+
+            if (type != NodeGraphicsObject::Type && type != ConnectionGraphicsObject::Type)
+                continue;
+
+            bool const visible = item->isVisible()
+                                 && visibleRect.intersects(item->sceneBoundingRect());
+
+            if (type == NodeGraphicsObject::Type) {
+                ++s.totalNodes;
+                s.visibleNodes += visible;
+            } else {
+                ++s.totalConnections;
+                s.visibleConnections += visible;
+            }
+        }
+    }
+
+    // Nodes use `DeviceCoordinateCache`, the visible ones which were not
+    // painted in this frame were blitted from their cached pixmaps.
+    s.nodeCacheHitRate = (profiler && s.visibleNodes > 0)
+                             ? std::max(0.0, 1.0 - double(s.nodesPainted) / s.visibleNodes)
+                             : 0.0;
+}
+
 void GraphicsView::showEvent(QShowEvent *event)
 {
     QGraphicsView::showEvent(event);
@@ -0,0 +1,295 @@
+#include "HeatMap.hpp"
+
+#include "AbstractNodeGeometry.hpp"
+#include "BasicGraphicsScene.hpp"
+#include "ConnectionGraphicsObject.hpp"
+#include "DefaultConnectionPainter.hpp"
+#include "DefaultNodePainter.hpp"
+#include "GraphProfiler.hpp"
+#include "GraphicsView.hpp"
+#include "NodeGraphicsObject.hpp"
+
+#include <QtGui/QFontMetrics>
+#include <QtGui/QLinearGradient>
+#include <QtGui/QPainterPath>
+
+#include <algorithm>
+#include <cmath>
+
+namespace QtNodes {
+
+namespace {
+
+/// Refresh period while some node is still warm.
+int const DecayIntervalMs = 100;
+
+/// Heat below this level is not painted.
+double const VisibleHeat = 0.02;
+
+} // namespace
+
+HeatMap::HeatMap(GraphProfiler &profiler, QObject *parent)
+    : QObject(parent)
+    , _profiler(profiler)
+    , _halfLifeMs(1000)
+    , _peakComputeRate(0.0)
+    , _peakPropagationRate(0.0)
+{
+    _sinceRefresh.start();
+
+    _decayTimer.setInterval(DecayIntervalMs);
+
+    connect(&_decayTimer, &QTimer::timeout, this, [this]() { refresh(); });
+
+    connect(&_profiler, &GraphProfiler::profileUpdated, this, [this]() {
+        refresh();
+
+        if (!_decayTimer.isActive())
+            _decayTimer.start();
+    });
+}
+
+void HeatMap::setHalfLife(int milliseconds)
+{
+    _halfLifeMs = std::max(milliseconds, 1);
+}
+
+double HeatMap::heat(NodeId const nodeId) const
+{
+    auto it = _entries.find(nodeId);
+    if (it == _entries.end() || _peakComputeRate <= 0.0)
+        return 0.0;
+
+    return std::min(it->second.computeRate / _peakComputeRate, 1.0);
+}
+
+double HeatMap::frequency(NodeId const nodeId) const
+{
+    auto it = _entries.find(nodeId);
+    if (it == _entries.end() || _peakPropagationRate <= 0.0)
+        return 0.0;
+
+    return std::min(it->second.propagationRate / _peakPropagationRate, 1.0);
+}
+
+QColor HeatMap::color(double heat)
+{
+    heat = std::max(0.0, std::min(heat, 1.0));
+
+    // Hue goes from blue (240) to red (0), the cold end is almost transparent.
+    QColor result = QColor::fromHsvF((1.0 - heat) * 240.0 / 360.0, 1.0, 1.0);
+    result.setAlphaF(0.15 + 0.6 * heat);
+
+    return result;
+}
+
+void HeatMap::install(BasicGraphicsScene &scene, GraphicsView *view)
+{
+    scene.setNodePainter(std::make_unique<HeatMapNodePainter>(*this));
+    scene.setConnectionPainter(std::make_unique<HeatMapConnectionPainter>(*this));
+
+    connect(this, &HeatMap::heatChanged, &scene, [&scene]() { scene.update(); });
+
+    if (view)
+        view->addOverlayPainter(std::make_unique<HeatMapLegendPainter>(*this));
+}
+
+void HeatMap::refresh()
+{
+    double const seconds = std::max<qint64>(_sinceRefresh.restart(), 1) / 1000.0;
+
+    double const decay = std::pow(0.5, seconds * 1000.0 / _halfLifeMs);
+
+    auto const &profiles = _profiler.nodeProfiles();
+
+    double maxCompute = 0.0;
+    double maxPropagation = 0.0;
+
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        if (profiles.count(it->first) == 0)
+            it = _entries.erase(it);
+        else
+            ++it;
+    }
+
+    for (auto const &p : profiles) {
+        ProfileStats const &compute = p.second[ProfileCategory::SetInData];
+        ProfileStats const &propagation = p.second[ProfileCategory::Propagation];
+
+        Entry &entry = _entries[p.first];
+
+        // The counters only go down after `GraphProfiler::reset`.
+        qint64 const selfNs = compute.selfNs >= entry.lastSelfNs
+                                  ? compute.selfNs - entry.lastSelfNs
+                                  : compute.selfNs;
+        quint64 const propagations = propagation.count >= entry.lastPropagations
+                                         ? propagation.count - entry.lastPropagations
+                                         : propagation.count;
+
+        entry.lastSelfNs = compute.selfNs;
+        entry.lastPropagations = propagation.count;
+
+        double const computeRate = selfNs / 1.0e6 / seconds;
+        double const propagationRate = propagations / seconds;
+
+        entry.computeRate = entry.computeRate * decay + computeRate * (1.0 - decay);
+        entry.propagationRate = entry.propagationRate * decay + propagationRate * (1.0 - decay);
+
+        maxCompute = std::max(maxCompute, entry.computeRate);
+        maxPropagation = std::max(maxPropagation, entry.propagationRate);
+    }
+
+    // The peaks fade four times slower than the nodes, so an idle graph
+    // cools down instead of being renormalized to the full scale.
+    double const peakDecay = std::pow(decay, 0.25);
+
+    _peakComputeRate = std::max(maxCompute, _peakComputeRate * peakDecay);
+    _peakPropagationRate = std::max(maxPropagation, _peakPropagationRate * peakDecay);
+
+    bool const warm = (_peakComputeRate > 0.0 && maxCompute / _peakComputeRate > VisibleHeat)
+                      || (_peakPropagationRate > 0.0
+                          && maxPropagation / _peakPropagationRate > VisibleHeat);
+
+    if (!warm) {
+        _decayTimer.stop();
+
+        for (auto &p : _entries) {
+            p.second.computeRate = 0.0;
+            p.second.propagationRate = 0.0;
+        }
+    }
+
+    Q_EMIT heatChanged();
+}
+
+//------------------------------------------------------------------------------
+
+HeatMapNodePainter::HeatMapNodePainter(HeatMap const &heatMap,
+                                       std::unique_ptr<AbstractNodePainter> base)
+    : _heatMap(heatMap)
+    , _base(base ? std::move(base) : std::make_unique<DefaultNodePainter>())
+{}
+
+void HeatMapNodePainter::paint(QPainter *painter, NodeGraphicsObject &ngo) const
+{
+    _base->paint(painter, ngo);
+
+    double const heat = _heatMap.heat(ngo.nodeId());
+
+    if (heat < VisibleHeat)
+        return;
+
+    QSize const size = ngo.nodeScene()->nodeGeometry().size(ngo.nodeId());
+
+    painter->save();
+
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(HeatMap::color(heat));
+
+    double const radius = 3.0;
+    painter->drawRoundedRect(QRectF(QPointF(0, 0), size), radius, radius);
+
+    painter->restore();
+}
+
+//------------------------------------------------------------------------------
+
+HeatMapConnectionPainter::HeatMapConnectionPainter(HeatMap const &heatMap,
+                                                   std::unique_ptr<AbstractConnectionPainter> base)
+    : _heatMap(heatMap)
+    , _base(base ? std::move(base) : std::make_unique<DefaultConnectionPainter>())
+{}
+
+void HeatMapConnectionPainter::paint(QPainter *painter, ConnectionGraphicsObject const &cgo) const
+{
+    _base->paint(painter, cgo);
+
+    NodeId const outNodeId = cgo.connectionId().outNodeId;
+
+    // Draft connections have one loose end.
+    if (outNodeId == InvalidNodeId || cgo.connectionId().inNodeId == InvalidNodeId)
+        return;
+
+    double const frequency = _heatMap.frequency(outNodeId);
+
+    if (frequency < VisibleHeat)
+        return;
+
+    QPointF const &in = cgo.endPoint(PortType::In);
+    QPointF const &out = cgo.endPoint(PortType::Out);
+
+    auto const c1c2 = cgo.pointsC1C2();
+
+    QPainterPath cubic(out);
+    cubic.cubicTo(c1c2.first, c1c2.second, in);
+
+    painter->save();
+
+    QPen pen(HeatMap::color(frequency), 2.0 + 6.0 * frequency);
+    pen.setCapStyle(Qt::RoundCap);
+
+    painter->setPen(pen);
+    painter->setBrush(Qt::NoBrush);
+    painter->drawPath(cubic);
+
+    painter->restore();
+}
+
+QPainterPath HeatMapConnectionPainter::getPainterStroke(ConnectionGraphicsObject const &cgo) const
+{
+    return _base->getPainterStroke(cgo);
+}
+
+//------------------------------------------------------------------------------
+
+HeatMapLegendPainter::HeatMapLegendPainter(HeatMap const &heatMap)
+    : _heatMap(heatMap)
+{}
+
+void HeatMapLegendPainter::paint(QPainter *painter, GraphicsView const &view) const
+{
+    int const margin = 10;
+    int const barWidth = 160;
+    int const barHeight = 10;
+
+    QFontMetrics const metrics(painter->font());
+    int const lineHeight = metrics.height();
+
+    QRect const viewport = view.viewport()->rect();
+
+    QRect const bar(margin,
+                    viewport.height() - margin - lineHeight - barHeight,
+                    barWidth,
+                    barHeight);
+
+    QLinearGradient gradient(bar.topLeft(), bar.topRight());
+    for (int i = 0; i <= 4; ++i) {
+        QColor c = HeatMap::color(i / 4.0);
+        c.setAlpha(255);
+        gradient.setColorAt(i / 4.0, c);
+    }
+
+    painter->save();
+
+    QRect const background = bar.adjusted(-4, -lineHeight - 6, 4, lineHeight + 4);
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(QColor(0, 0, 0, 140));
+    painter->drawRoundedRect(background, 3, 3);
+
+    painter->setBrush(gradient);
+    painter->drawRect(bar);
+
+    painter->setPen(Qt::white);
+
+    painter->drawText(bar.left(), bar.top() - 4, QStringLiteral("Compute, ms/s"));
+
+    int const textY = bar.bottom() + lineHeight;
+    painter->drawText(bar.left(), textY, QStringLiteral("0"));
+
+    QString const peak = QString::number(_heatMap.peakComputeRate(), 'f', 1);
+    painter->drawText(bar.right() - metrics.horizontalAdvance(peak), textY, peak);
+
+    painter->restore();
+}
+
+} // namespace QtNodes
@@ -50,13 +50,11 @@ bool NodeConnectionInteraction::canConnect(PortIndex *portIndex) const
 
     // 4. Model allows connection.
 
-    AbstractGraphModel &model = _ngo.nodeScene()->graphModel();
-
     ConnectionId connectionId = makeCompleteConnectionId(_cgo.connectionId(), // incomplete
                                                          _ngo.nodeId(),       // missing node id
                                                          *portIndex);         // missing port index
 
-    return model.connectionPossible(connectionId);
+    return _scene.connectionPossible(connectionId);
 }
 
 bool NodeConnectionInteraction::tryConnect() const
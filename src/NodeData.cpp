@@ -0,0 +1,70 @@
+#include "NodeData.hpp"
+
+#include "QStringStdHash.hpp"
+
+#include <QtCore/QReadWriteLock>
+
+#include <unordered_map>
+#include <vector>
+
+namespace QtNodes {
+
+namespace {
+
+struct NodeDataTypeTable
+{
+    QReadWriteLock lock;
+
+    std::unordered_map<QString, NodeDataTypeId> ids;
+
+    std::vector<QString> strings;
+};
+
+NodeDataTypeTable &nodeDataTypeTable()
+{
+    static NodeDataTypeTable table;
+    return table;
+}
+
+} // namespace
+
+NodeDataTypeId internNodeDataType(QString const &typeId)
+{
+    NodeDataTypeTable &table = nodeDataTypeTable();
+
+    {
+        QReadLocker locker(&table.lock);
+
+        auto it = table.ids.find(typeId);
+        if (it != table.ids.end())
+            return it->second;
+    }
+
+    QWriteLocker locker(&table.lock);
+
+    // Another thread could intern the same string in between.
+    auto it = table.ids.find(typeId);
+    if (it != table.ids.end())
+        return it->second;
+
+    NodeDataTypeId const id = static_cast<NodeDataTypeId>(table.strings.size());
+
+    table.ids[typeId] = id;
+    table.strings.push_back(typeId);
+
+    return id;
+}
+
+QString nodeDataTypeString(NodeDataTypeId const id)
+{
+    NodeDataTypeTable &table = nodeDataTypeTable();
+
+    QReadLocker locker(&table.lock);
+
+    if (id >= table.strings.size())
+        return QString();
+
+    return table.strings[id];
+}
+
+} // namespace QtNodes
@@ -6,6 +6,7 @@ namespace QtNodes {
 
 NodeDelegateModel::NodeDelegateModel()
     : _nodeStyle(StyleCollection::nodeStyle())
+    , _modelTypeId(InvalidModelTypeId)
 {
     // Derived classes can initialize specific style here
 }
@@ -19,6 +20,11 @@ QJsonObject NodeDelegateModel::save() const
     return modelJson;
 }
 
+NodeDataTypeId NodeDelegateModel::portDataTypeId(PortType portType, PortIndex portIndex) const
+{
+    return internNodeDataType(dataType(portType, portIndex).id);
+}
+
 void NodeDelegateModel::load(QJsonObject const &)
 {
     //
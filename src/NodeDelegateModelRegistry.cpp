@@ -3,19 +3,145 @@
 #include <QtCore/QFile>
 #include <QtWidgets/QMessageBox>
 
+using QtNodes::ModelDescriptor;
+using QtNodes::ModelTypeId;
 using QtNodes::NodeDataType;
 using QtNodes::NodeDelegateModel;
 using QtNodes::NodeDelegateModelRegistry;
+using QtNodes::PortIndex;
+using QtNodes::PortType;
+
+ModelTypeId NodeDelegateModelRegistry::registerModel(ModelDescriptor descriptor,
+                                                     RegistryItemCreator creator)
+{
+    auto it = _modelTypeIds.find(descriptor.name);
+    if (it != _modelTypeIds.end())
+        return it->second;
+
+    ModelTypeId const id = static_cast<ModelTypeId>(_descriptors.size());
+
+    descriptor.id = id;
+
+    _modelTypeIds[descriptor.name] = id;
+
+    _categories.insert(descriptor.category);
+    _registeredModelsCategory[descriptor.name] = descriptor.category;
+    _registeredItemCreators[descriptor.name] = creator;
+
+    _creators.push_back(std::move(creator));
+    _descriptors.push_back(std::move(descriptor));
+
+    return id;
+}
 
 std::unique_ptr<NodeDelegateModel> NodeDelegateModelRegistry::create(QString const &modelName)
 {
-    auto it = _registeredItemCreators.find(modelName);
+    return create(modelTypeId(modelName));
+}
 
-    if (it != _registeredItemCreators.end()) {
-        return it->second();
+std::unique_ptr<NodeDelegateModel> NodeDelegateModelRegistry::create(ModelTypeId const modelTypeId)
+{
+    if (modelTypeId >= _creators.size())
+        return nullptr;
+
+    if (modelTypeId < _pools.size() && !_pools[modelTypeId].empty()) {
+        std::unique_ptr<NodeDelegateModel> model = std::move(_pools[modelTypeId].back());
+        _pools[modelTypeId].pop_back();
+        return model;
     }
 
-    return nullptr;
+    std::unique_ptr<NodeDelegateModel> model = _creators[modelTypeId]();
+
+    if (model)
+        model->_modelTypeId = modelTypeId;
+
+    return model;
+}
+
+void NodeDelegateModelRegistry::setPoolCapacity(std::size_t capacity)
+{
+    _poolCapacity = capacity;
+
+    for (auto &pool : _pools) {
+        if (pool.size() > capacity)
+            pool.resize(capacity);
+    }
+}
+
+void NodeDelegateModelRegistry::release(std::unique_ptr<NodeDelegateModel> model,
+                                        QObject const *owner)
+{
+    if (!model)
+        return;
+
+    ModelTypeId const typeId = model->modelTypeId();
+
+    // Models created elsewhere (e.g. by a custom graph model) are just deleted.
+    if (_poolCapacity == 0 || typeId >= _creators.size())
+        return;
+
+    if (_pools.size() <= typeId)
+        _pools.resize(_descriptors.size());
+
+    auto &pool = _pools[typeId];
+
+    if (pool.size() >= _poolCapacity)
+        return;
+
+    // Leaves nothing of the previous owner attached to the model.
+    QObject::disconnect(model.get(), nullptr, owner, nullptr);
+
+    if (model->reset())
+        pool.push_back(std::move(model));
+}
+
+void NodeDelegateModelRegistry::clearPools()
+{
+    _pools.clear();
+}
+
+std::size_t NodeDelegateModelRegistry::pooledModelCount() const
+{
+    std::size_t result = 0;
+
+    for (auto const &pool : _pools)
+        result += pool.size();
+
+    return result;
+}
+
+ModelTypeId NodeDelegateModelRegistry::modelTypeId(QString const &modelName) const
+{
+    auto it = _modelTypeIds.find(modelName);
+
+    if (it != _modelTypeIds.end()) {
+        return it->second;
+    }
+
+    return InvalidModelTypeId;
+}
+
+ModelDescriptor const *NodeDelegateModelRegistry::descriptor(ModelTypeId const modelTypeId) const
+{
+    if (modelTypeId >= _descriptors.size())
+        return nullptr;
+
+    return &_descriptors[modelTypeId];
+}
+
+ModelDescriptor NodeDelegateModelRegistry::describeInstance(NodeDelegateModel const &model)
+{
+    ModelDescriptor descriptor;
+    descriptor.name = model.name();
+    descriptor.caption = model.caption();
+
+    for (PortIndex i = 0; i < model.nPorts(PortType::In); ++i)
+        descriptor.inPortTypes.push_back(model.dataType(PortType::In, i));
+
+    for (PortIndex i = 0; i < model.nPorts(PortType::Out); ++i)
+        descriptor.outPortTypes.push_back(model.dataType(PortType::Out, i));
+
+    return descriptor;
 }
 
 NodeDelegateModelRegistry::RegisteredModelCreatorsMap const &
@@ -12,6 +12,7 @@
 #include "BasicGraphicsScene.hpp"
 #include "ConnectionGraphicsObject.hpp"
 #include "ConnectionIdUtils.hpp"
+#include "GraphProfiler.hpp"
 #include "NodeConnectionInteraction.hpp"
 #include "StyleCollection.hpp"
 #include "UndoCommands.hpp"
@@ -56,7 +57,7 @@ NodeGraphicsObject::NodeGraphicsObject(BasicGraphicsScene &scene, NodeId nodeId)
 
     nodeScene()->nodeGeometry().recomputeSize(_nodeId);
 
-    QPointF const pos = _graphModel.nodeData<QPointF>(_nodeId, NodeRole::Position);
+    QPointF const pos = _graphModel.nodePosition(_nodeId);
 
     setPos(pos);
 
@@ -141,6 +142,8 @@ void NodeGraphicsObject::setGeometryChanged()
 
 void NodeGraphicsObject::moveConnections() const
 {
+    ScopedProfile profile(nodeScene()->profiler(), _nodeId, ProfileCategory::MoveConnections);
+
     auto const &connected = _graphModel.allConnectionIds(_nodeId);
 
     for (auto &cnId : connected) {
@@ -160,6 +163,8 @@ void NodeGraphicsObject::reactToConnection(ConnectionGraphicsObject const *cgo)
 
 void NodeGraphicsObject::paint(QPainter *painter, QStyleOptionGraphicsItem const *option, QWidget *)
 {
+    ScopedProfile profile(nodeScene()->profiler(), _nodeId, ProfileCategory::PaintNode);
+
     painter->setClipRect(option->exposedRect);
 
     nodeScene()->nodePainter().paint(painter, *this);
@@ -0,0 +1,117 @@
+#include "NodeSlots.hpp"
+
+#include <algorithm>
+
+namespace QtNodes {
+
+NodeId NodeSlots::reserve()
+{
+    NodeId const nodeId = _slots.reserve();
+
+    fitSlots();
+
+    return nodeId;
+}
+
+void NodeSlots::insert(NodeId const nodeId, std::unique_ptr<NodeDelegateModel> model)
+{
+    std::size_t const index = _slots.occupy(nodeId);
+
+    fitSlots();
+
+    _models[index] = std::move(model);
+    _positions[index] = QPointF();
+    _sizes[index] = QSize();
+    _connections[index].clear();
+}
+
+std::unique_ptr<NodeDelegateModel> NodeSlots::erase(NodeId const nodeId)
+{
+    if (!contains(nodeId))
+        return nullptr;
+
+    std::size_t const index = SlotAllocator::slotIndex(nodeId);
+
+    std::unique_ptr<NodeDelegateModel> model = std::move(_models[index]);
+
+    _connections[index].clear();
+
+    _slots.release(nodeId);
+
+    return model;
+}
+
+void NodeSlots::clear()
+{
+    for (std::size_t i = 0; i < _models.size(); ++i) {
+        _models[i].reset();
+        _connections[i].clear();
+    }
+
+    _slots.releaseAll();
+}
+
+bool NodeSlots::setPosition(NodeId const nodeId, QPointF const &position)
+{
+    if (!contains(nodeId))
+        return false;
+
+    _positions[SlotAllocator::slotIndex(nodeId)] = position;
+    return true;
+}
+
+bool NodeSlots::setSize(NodeId const nodeId, QSize const &size)
+{
+    if (!contains(nodeId))
+        return false;
+
+    _sizes[SlotAllocator::slotIndex(nodeId)] = size;
+    return true;
+}
+
+std::vector<ConnectionId> const &NodeSlots::connections(NodeId const nodeId) const
+{
+    static std::vector<ConnectionId> const empty;
+
+    return contains(nodeId) ? _connections[SlotAllocator::slotIndex(nodeId)] : empty;
+}
+
+void NodeSlots::attach(ConnectionId const &connectionId)
+{
+    if (contains(connectionId.outNodeId))
+        _connections[SlotAllocator::slotIndex(connectionId.outNodeId)].push_back(connectionId);
+
+    if (connectionId.inNodeId != connectionId.outNodeId && contains(connectionId.inNodeId))
+        _connections[SlotAllocator::slotIndex(connectionId.inNodeId)].push_back(connectionId);
+}
+
+void NodeSlots::detach(ConnectionId const &connectionId)
+{
+    for (NodeId const nodeId : {connectionId.outNodeId, connectionId.inNodeId}) {
+        if (!contains(nodeId))
+            continue;
+
+        std::vector<ConnectionId> &attached = _connections[SlotAllocator::slotIndex(nodeId)];
+
+        auto it = std::find(attached.begin(), attached.end(), connectionId);
+        if (it != attached.end()) {
+            *it = attached.back();
+            attached.pop_back();
+        }
+    }
+}
+
+void NodeSlots::fitSlots()
+{
+    std::size_t const n = _slots.slotCount();
+
+    if (_models.size() == n)
+        return;
+
+    _models.resize(n);
+    _positions.resize(n);
+    _sizes.resize(n);
+    _connections.resize(n);
+}
+
+} // namespace QtNodes
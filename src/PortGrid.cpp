@@ -0,0 +1,144 @@
+#include "PortGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace QtNodes {
+
+PortGrid::PortGrid(double const cellSize)
+    : _cellSize(std::max(cellSize, 1.0))
+    , _size(0)
+{}
+
+void PortGrid::setCellSize(double const cellSize)
+{
+    double const size = std::max(cellSize, 1.0);
+
+    if (size == _cellSize)
+        return;
+
+    _cellSize = size;
+
+    rebuildCells();
+}
+
+void PortGrid::insert(PortLocation const &port)
+{
+    std::vector<PortLocation> &ports = _nodes[port.nodeId];
+
+    _cells[cellKey(port.scenePos)].push_back(CellEntry{port.nodeId, ports.size()});
+
+    ports.push_back(port);
+
+    ++_size;
+}
+
+void PortGrid::removeNode(NodeId const nodeId)
+{
+    auto it = _nodes.find(nodeId);
+    if (it == _nodes.end())
+        return;
+
+    for (PortLocation const &port : it->second) {
+        auto cell = _cells.find(cellKey(port.scenePos));
+        if (cell == _cells.end())
+            continue;
+
+        std::vector<CellEntry> &entries = cell->second;
+
+        entries.erase(std::remove_if(entries.begin(),
+                                     entries.end(),
+                                     [nodeId](CellEntry const &entry) {
+                                         return entry.nodeId == nodeId;
+                                     }),
+                      entries.end());
+
+        if (entries.empty())
+            _cells.erase(cell);
+    }
+
+    _size -= it->second.size();
+
+    _nodes.erase(it);
+}
+
+void PortGrid::clear()
+{
+    _nodes.clear();
+    _cells.clear();
+    _size = 0;
+}
+
+std::vector<NodeId> PortGrid::nodeIds() const
+{
+    std::vector<NodeId> result;
+    result.reserve(_nodes.size());
+
+    for (auto const &entry : _nodes)
+        result.push_back(entry.first);
+
+    return result;
+}
+
+PortLocation const *PortGrid::nearest(QPointF const &scenePos, double radius) const
+{
+    if (_size == 0)
+        return nullptr;
+
+    radius = std::min(radius, _cellSize);
+
+    std::int64_t const cx = cellCoordinate(scenePos.x());
+    std::int64_t const cy = cellCoordinate(scenePos.y());
+
+    PortLocation const *result = nullptr;
+    double bestDistance = radius * radius;
+
+    for (std::int64_t y = cy - 1; y <= cy + 1; ++y) {
+        for (std::int64_t x = cx - 1; x <= cx + 1; ++x) {
+            auto cell = _cells.find(cellKey(x, y));
+            if (cell == _cells.end())
+                continue;
+
+            for (CellEntry const &entry : cell->second) {
+                PortLocation const &port = _nodes.find(entry.nodeId)->second[entry.index];
+
+                QPointF const diff = port.scenePos - scenePos;
+                double const distance = QPointF::dotProduct(diff, diff);
+
+                if (distance <= bestDistance) {
+                    bestDistance = distance;
+                    result = &port;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+std::int64_t PortGrid::cellCoordinate(double const value) const
+{
+    return static_cast<std::int64_t>(std::floor(value / _cellSize));
+}
+
+std::uint64_t PortGrid::cellKey(std::int64_t const x, std::int64_t const y)
+{
+    return (static_cast<std::uint64_t>(x) << 32) ^ static_cast<std::uint32_t>(y);
+}
+
+std::uint64_t PortGrid::cellKey(QPointF const &scenePos) const
+{
+    return cellKey(cellCoordinate(scenePos.x()), cellCoordinate(scenePos.y()));
+}
+
+void PortGrid::rebuildCells()
+{
+    _cells.clear();
+
+    for (auto const &entry : _nodes) {
+        for (std::size_t i = 0; i < entry.second.size(); ++i)
+            _cells[cellKey(entry.second[i].scenePos)].push_back(CellEntry{entry.first, i});
+    }
+}
+
+} // namespace QtNodes
@@ -0,0 +1,258 @@
+#include "SerializedItems.hpp"
+
+#include "ConnectionIdUtils.hpp"
+
+#include <QtCore/QDataStream>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QtGlobal>
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
+#include <QtCore/QCborMap>
+#include <QtCore/QCborValue>
+#endif
+
+#include <algorithm>
+
+namespace QtNodes {
+
+namespace {
+
+quint32 const BinaryMagic = 0x514e4731; // "QNG1"
+
+quint16 const BinaryVersion = 1;
+
+enum class JsonEncoding : quint8 { CompactText = 0, Cbor = 1 };
+
+// Smallest possible size of one serialized node or connection, used to
+// reject garbage counts before allocating anything.
+int const MinNodeRecordSize = 4 + 8 + 8 + 4;
+int const ConnectionRecordSize = 4 * 4;
+
+QByteArray encodeJson(QJsonObject const &json, JsonEncoding encoding)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
+    if (encoding == JsonEncoding::Cbor)
+        return QCborValue::fromJsonValue(json).toCbor();
+#else
+    Q_UNUSED(encoding);
+#endif
+    return QJsonDocument(json).toJson(QJsonDocument::Compact);
+}
+
+bool decodeJson(QByteArray const &bytes, JsonEncoding encoding, QJsonObject &json)
+{
+    if (encoding == JsonEncoding::Cbor) {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
+        QCborValue const value = QCborValue::fromCbor(bytes);
+        if (!value.isMap())
+            return false;
+
+        json = value.toMap().toJsonObject();
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    QJsonDocument const doc = QJsonDocument::fromJson(bytes);
+    if (!doc.isObject())
+        return false;
+
+    json = doc.object();
+    return true;
+}
+
+} // namespace
+
+QJsonObject SerializedNode::toLoadableJson() const
+{
+    QJsonObject result = json;
+
+    result["id"] = static_cast<qint64>(id);
+
+    QJsonObject posJson;
+    posJson["x"] = position.x();
+    posJson["y"] = position.y();
+    result["position"] = posJson;
+
+    return result;
+}
+
+QByteArray SerializedItems::toBinary() const
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
+    JsonEncoding const encoding = JsonEncoding::Cbor;
+#else
+    JsonEncoding const encoding = JsonEncoding::CompactText;
+#endif
+
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_11);
+
+    stream << BinaryMagic << BinaryVersion << static_cast<quint8>(encoding);
+
+    stream << static_cast<quint32>(nodes.size());
+    for (SerializedNode const &node : nodes) {
+        stream << static_cast<quint32>(node.id) << node.position.x() << node.position.y();
+        stream << encodeJson(node.json, encoding);
+    }
+
+    stream << static_cast<quint32>(connections.size());
+    for (ConnectionId const &cid : connections) {
+        stream << static_cast<quint32>(cid.outNodeId) << static_cast<quint32>(cid.outPortIndex)
+               << static_cast<quint32>(cid.inNodeId) << static_cast<quint32>(cid.inPortIndex);
+    }
+
+    return data;
+}
+
+bool SerializedItems::fromBinary(QByteArray const &data, SerializedItems &items)
+{
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_5_11);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    quint8 encoding = 0;
+
+    stream >> magic >> version >> encoding;
+
+    if (stream.status() != QDataStream::Ok || magic != BinaryMagic || version != BinaryVersion)
+        return false;
+
+    SerializedItems result;
+
+    quint32 nodeCount = 0;
+    stream >> nodeCount;
+
+    if (nodeCount > static_cast<quint32>(data.size() / MinNodeRecordSize))
+        return false;
+
+    result.nodes.reserve(nodeCount);
+
+    for (quint32 i = 0; i < nodeCount; ++i) {
+        quint32 id = 0;
+        double x = 0.0;
+        double y = 0.0;
+        QByteArray jsonBytes;
+
+        stream >> id >> x >> y >> jsonBytes;
+
+        if (stream.status() != QDataStream::Ok)
+            return false;
+
+        SerializedNode node{static_cast<NodeId>(id), QPointF(x, y), QJsonObject()};
+
+        if (!decodeJson(jsonBytes, static_cast<JsonEncoding>(encoding), node.json))
+            return false;
+
+        result.nodes.push_back(std::move(node));
+    }
+
+    quint32 connectionCount = 0;
+    stream >> connectionCount;
+
+    if (connectionCount > static_cast<quint32>(data.size() / ConnectionRecordSize))
+        return false;
+
+    result.connections.reserve(connectionCount);
+
+    for (quint32 i = 0; i < connectionCount; ++i) {
+        quint32 outNodeId = 0, outPortIndex = 0, inNodeId = 0, inPortIndex = 0;
+
+        stream >> outNodeId >> outPortIndex >> inNodeId >> inPortIndex;
+
+        result.connections.push_back(ConnectionId{static_cast<NodeId>(outNodeId),
+                                                  static_cast<PortIndex>(outPortIndex),
+                                                  static_cast<NodeId>(inNodeId),
+                                                  static_cast<PortIndex>(inPortIndex)});
+    }
+
+    if (stream.status() != QDataStream::Ok)
+        return false;
+
+    items = std::move(result);
+
+    return true;
+}
+
+QJsonObject SerializedItems::toJson() const
+{
+    QJsonArray nodesJsonArray;
+    for (SerializedNode const &node : nodes) {
+        nodesJsonArray.append(node.toLoadableJson());
+    }
+
+    QJsonArray connJsonArray;
+    for (ConnectionId const &cid : connections) {
+        connJsonArray.append(QtNodes::toJson(cid));
+    }
+
+    QJsonObject sceneJson;
+    sceneJson["nodes"] = nodesJsonArray;
+    sceneJson["connections"] = connJsonArray;
+
+    return sceneJson;
+}
+
+SerializedItems SerializedItems::fromJson(QJsonObject const &sceneJson)
+{
+    SerializedItems items;
+
+    QJsonArray const nodesJsonArray = sceneJson["nodes"].toArray();
+
+    items.nodes.reserve(nodesJsonArray.size());
+
+    for (QJsonValue const node : nodesJsonArray) {
+        QJsonObject nodeJson = node.toObject();
+
+        QJsonObject const posJson = nodeJson["position"].toObject();
+
+        SerializedNode serializedNode{nodeIdFromJson(nodeJson["id"]),
+                                      QPointF(posJson["x"].toDouble(), posJson["y"].toDouble()),
+                                      QJsonObject()};
+
+        nodeJson.remove("id");
+        nodeJson.remove("position");
+        serializedNode.json = nodeJson;
+
+        items.nodes.push_back(std::move(serializedNode));
+    }
+
+    QJsonArray const connJsonArray = sceneJson["connections"].toArray();
+
+    items.connections.reserve(connJsonArray.size());
+
+    for (QJsonValue const connection : connJsonArray) {
+        items.connections.push_back(QtNodes::fromJson(connection.toObject()));
+    }
+
+    return items;
+}
+
+QPointF SerializedItems::averagePosition() const
+{
+    QPointF averagePos(0, 0);
+
+    if (nodes.empty())
+        return averagePos;
+
+    for (SerializedNode const &node : nodes) {
+        averagePos += node.position;
+    }
+
+    averagePos /= static_cast<double>(nodes.size());
+
+    return averagePos;
+}
+
+void SerializedItems::offset(QPointF const &diff)
+{
+    for (SerializedNode &node : nodes) {
+        node.position += diff;
+    }
+}
+
+} // namespace QtNodes
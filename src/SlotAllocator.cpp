@@ -0,0 +1,150 @@
+#include "SlotAllocator.hpp"
+
+#include <stdexcept>
+#include <string>
+
+namespace QtNodes {
+
+NodeId SlotAllocator::reserve()
+{
+    while (!_freeSlots.empty()) {
+        std::size_t const index = _freeSlots.back();
+        _freeSlots.pop_back();
+
+        if (_states[index] == Free) {
+            _states[index] = Reserved;
+            return makeNodeId(index, _generations[index]);
+        }
+    }
+
+    std::size_t const index = _states.size();
+
+    if (index >= MaxSlotCount)
+        throw std::logic_error("Node slot capacity exhausted");
+
+    grow(index);
+
+    // `grow` made the new slot the only free one.
+    _freeSlots.pop_back();
+    _states[index] = Reserved;
+
+    return makeNodeId(index, _generations[index]);
+}
+
+std::size_t SlotAllocator::occupy(NodeId const nodeId)
+{
+    if (!isWellFormed(nodeId))
+        throw std::logic_error("Node id " + std::to_string(nodeId) + " is out of range");
+
+    std::size_t const index = slotIndex(nodeId);
+
+    if (index >= _states.size())
+        grow(index);
+
+    switch (_states[index]) {
+    case Occupied:
+        throw std::logic_error("Node id " + std::to_string(nodeId) + " is already in use");
+
+    case Reserved:
+        if (_generations[index] != generation(nodeId))
+            throw std::logic_error("Node slot of " + std::to_string(nodeId)
+                                   + " is reserved for another node");
+        break;
+
+    case Free:
+        // Still listed in `_freeSlots`, `reserve` skips it.
+        _generations[index] = static_cast<std::uint8_t>(generation(nodeId));
+        break;
+    }
+
+    _states[index] = Occupied;
+
+    ++_count;
+
+    return index;
+}
+
+bool SlotAllocator::release(NodeId const nodeId)
+{
+    if (!contains(nodeId))
+        return false;
+
+    freeSlot(slotIndex(nodeId));
+
+    --_count;
+
+    return true;
+}
+
+bool SlotAllocator::unreserve(NodeId const nodeId)
+{
+    std::size_t const index = slotIndex(nodeId);
+
+    if (!isWellFormed(nodeId) || index >= _states.size() || _states[index] != Reserved
+        || _generations[index] != generation(nodeId))
+        return false;
+
+    freeSlot(index);
+
+    return true;
+}
+
+void SlotAllocator::freeSlot(std::size_t const index)
+{
+    _states[index] = Free;
+    _generations[index] = static_cast<std::uint8_t>((_generations[index] + 1) & GenerationMask);
+
+    // Slots re-taken by `occupy` stay listed, rebuild before the list outgrows the slots.
+    if (_freeSlots.size() >= _states.size()) {
+        _freeSlots.clear();
+
+        for (std::size_t i = _states.size(); i-- > 0;) {
+            if (_states[i] == Free)
+                _freeSlots.push_back(i);
+        }
+    } else {
+        _freeSlots.push_back(index);
+    }
+}
+
+void SlotAllocator::releaseAll()
+{
+    for (std::size_t i = 0; i < _states.size(); ++i) {
+        if (_states[i] == Occupied)
+            _generations[i] = static_cast<std::uint8_t>((_generations[i] + 1) & GenerationMask);
+
+        _states[i] = Free;
+    }
+
+    _freeSlots.clear();
+
+    for (std::size_t i = _states.size(); i-- > 0;)
+        _freeSlots.push_back(i);
+
+    _count = 0;
+}
+
+std::vector<NodeId> SlotAllocator::nodeIds() const
+{
+    std::vector<NodeId> result;
+    result.reserve(_count);
+
+    forEach([&result](NodeId const nodeId, std::size_t) { result.push_back(nodeId); });
+
+    return result;
+}
+
+void SlotAllocator::grow(std::size_t const index)
+{
+    std::size_t const oldSize = _states.size();
+    std::size_t const newSize = index + 1;
+
+    _generations.resize(newSize, 0);
+    _states.resize(newSize, Free);
+
+    // Lower slots are handed out first.
+    for (std::size_t i = newSize; i-- > oldSize;)
+        _freeSlots.push_back(i);
+}
+
+} // namespace QtNodes
@@ -0,0 +1,231 @@
+#include "TopologicalOrder.hpp"
+
+#include <algorithm>
+
+namespace QtNodes {
+
+namespace {
+
+void eraseOne(std::vector<NodeId> &nodes, NodeId const nodeId)
+{
+    auto it = std::find(nodes.begin(), nodes.end(), nodeId);
+    if (it != nodes.end()) {
+        *it = nodes.back();
+        nodes.pop_back();
+    }
+}
+
+} // namespace
+
+void TopologicalOrder::addNode(NodeId const nodeId)
+{
+    if (contains(nodeId))
+        return;
+
+    _vertices[nodeId].position = _nodeAt.size();
+    _nodeAt.push_back(nodeId);
+}
+
+void TopologicalOrder::removeNode(NodeId const nodeId)
+{
+    auto it = _vertices.find(nodeId);
+    if (it == _vertices.end())
+        return;
+
+    for (NodeId const successor : it->second.successors)
+        eraseOne(_vertices[successor].predecessors, nodeId);
+
+    for (NodeId const predecessor : it->second.predecessors)
+        eraseOne(_vertices[predecessor].successors, nodeId);
+
+    _nodeAt[it->second.position] = InvalidNodeId;
+    ++_holes;
+
+    _vertices.erase(it);
+
+    if (_holes > 64 && _holes * 2 > _nodeAt.size())
+        compact();
+}
+
+bool TopologicalOrder::createsCycle(NodeId const from, NodeId const to) const
+{
+    if (from == to)
+        return contains(from);
+
+    auto itFrom = _vertices.find(from);
+    auto itTo = _vertices.find(to);
+
+    if (itFrom == _vertices.end() || itTo == _vertices.end())
+        return false;
+
+    // The order already agrees with the edge.
+    if (itFrom->second.position < itTo->second.position)
+        return false;
+
+    std::vector<NodeId> visited;
+    return !collectForward(to, from, itFrom->second.position, visited);
+}
+
+bool TopologicalOrder::addEdge(NodeId const from, NodeId const to)
+{
+    if (from == to)
+        return false;
+
+    addNode(from);
+    addNode(to);
+
+    Vertex &vFrom = _vertices[from];
+    Vertex &vTo = _vertices[to];
+
+    std::size_t const lowerBound = vTo.position;
+    std::size_t const upperBound = vFrom.position;
+
+    if (lowerBound < upperBound) {
+        std::vector<NodeId> forward;
+        if (!collectForward(to, from, upperBound, forward))
+            return false;
+
+        std::vector<NodeId> backward;
+        collectBackward(from, lowerBound, backward);
+
+        auto byPosition = [this](NodeId const a, NodeId const b) {
+            return _vertices.at(a).position < _vertices.at(b).position;
+        };
+
+        std::sort(forward.begin(), forward.end(), byPosition);
+        std::sort(backward.begin(), backward.end(), byPosition);
+
+        // The affected nodes swap their positions among themselves: all the
+        // upstream nodes of `from` go first, then the downstream nodes of `to`.
+        std::vector<std::size_t> positions;
+        positions.reserve(forward.size() + backward.size());
+
+        for (NodeId const nodeId : backward)
+            positions.push_back(_vertices[nodeId].position);
+        for (NodeId const nodeId : forward)
+            positions.push_back(_vertices[nodeId].position);
+
+        std::sort(positions.begin(), positions.end());
+
+        std::size_t i = 0;
+        for (auto const *group : {&backward, &forward}) {
+            for (NodeId const nodeId : *group) {
+                _vertices[nodeId].position = positions[i];
+                _nodeAt[positions[i]] = nodeId;
+                ++i;
+            }
+        }
+    }
+
+    vFrom.successors.push_back(to);
+    vTo.predecessors.push_back(from);
+
+    return true;
+}
+
+void TopologicalOrder::removeEdge(NodeId const from, NodeId const to)
+{
+    auto itFrom = _vertices.find(from);
+    auto itTo = _vertices.find(to);
+
+    if (itFrom == _vertices.end() || itTo == _vertices.end())
+        return;
+
+    eraseOne(itFrom->second.successors, to);
+    eraseOne(itTo->second.predecessors, from);
+}
+
+void TopologicalOrder::clear()
+{
+    _vertices.clear();
+    _nodeAt.clear();
+    _holes = 0;
+}
+
+std::vector<NodeId> TopologicalOrder::order() const
+{
+    std::vector<NodeId> result;
+    result.reserve(_vertices.size());
+
+    for (NodeId const nodeId : _nodeAt) {
+        if (nodeId != InvalidNodeId)
+            result.push_back(nodeId);
+    }
+
+    return result;
+}
+
+std::size_t TopologicalOrder::position(NodeId const nodeId) const
+{
+    auto it = _vertices.find(nodeId);
+    return it != _vertices.end() ? it->second.position : _nodeAt.size();
+}
+
+bool TopologicalOrder::collectForward(NodeId const start,
+                                      NodeId const target,
+                                      std::size_t const upperBound,
+                                      std::vector<NodeId> &visited) const
+{
+    FlatHashSet<NodeId> seen;
+    seen.insert(start);
+
+    std::vector<NodeId> stack{start};
+
+    while (!stack.empty()) {
+        NodeId const nodeId = stack.back();
+        stack.pop_back();
+
+        visited.push_back(nodeId);
+
+        for (NodeId const successor : _vertices.at(nodeId).successors) {
+            if (successor == target)
+                return false;
+
+            if (_vertices.at(successor).position < upperBound && seen.insert(successor).second)
+                stack.push_back(successor);
+        }
+    }
+
+    return true;
+}
+
+void TopologicalOrder::collectBackward(NodeId const start,
+                                       std::size_t const lowerBound,
+                                       std::vector<NodeId> &visited) const
+{
+    FlatHashSet<NodeId> seen;
+    seen.insert(start);
+
+    std::vector<NodeId> stack{start};
+
+    while (!stack.empty()) {
+        NodeId const nodeId = stack.back();
+        stack.pop_back();
+
+        visited.push_back(nodeId);
+
+        for (NodeId const predecessor : _vertices.at(nodeId).predecessors) {
+            if (_vertices.at(predecessor).position > lowerBound && seen.insert(predecessor).second)
+                stack.push_back(predecessor);
+        }
+    }
+}
+
+void TopologicalOrder::compact()
+{
+    std::size_t next = 0;
+
+    for (NodeId const nodeId : _nodeAt) {
+        if (nodeId == InvalidNodeId)
+            continue;
+
+        _vertices[nodeId].position = next;
+        _nodeAt[next] = nodeId;
+        ++next;
+    }
+
+    _nodeAt.resize(next);
+    _holes = 0;
+}
+
+} // namespace QtNodes
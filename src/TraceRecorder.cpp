@@ -0,0 +1,341 @@
+#include "TraceRecorder.hpp"
+
+#include "AbstractGraphModel.hpp"
+
+#include <QtCore/QFile>
+#include <QtCore/QIODevice>
+#include <QtCore/QThread>
+
+namespace QtNodes {
+
+namespace {
+
+/// Size of the chunks written to the device.
+int const WriteChunkBytes = 1 << 16;
+
+char const *categoryName(ProfileCategory const category)
+{
+    switch (category) {
+    case ProfileCategory::SetInData:
+        return "setInData";
+    case ProfileCategory::Propagation:
+        return "propagation";
+    case ProfileCategory::NodeUpdate:
+        return "nodeUpdate";
+    case ProfileCategory::MoveConnections:
+        return "moveConnections";
+    case ProfileCategory::PaintNode:
+        return "paintNode";
+    case ProfileCategory::PaintConnection:
+        return "paintConnection";
+    default:
+        break;
+    }
+
+    return "unknown";
+}
+
+/// Trace viewers can filter the events by these groups.
+char const *categoryGroup(ProfileCategory const category)
+{
+    switch (category) {
+    case ProfileCategory::SetInData:
+    case ProfileCategory::Propagation:
+        return "compute";
+    case ProfileCategory::NodeUpdate:
+    case ProfileCategory::MoveConnections:
+        return "scene";
+    default:
+        break;
+    }
+
+    return "paint";
+}
+
+char const *markName(ProfileMark const mark)
+{
+    switch (mark) {
+    case ProfileMark::PortDataSet:
+        return "portDataSet";
+    case ProfileMark::SceneFlush:
+        return "sceneFlush";
+    }
+
+    return "unknown";
+}
+
+QByteArray jsonString(QString const &str)
+{
+    QByteArray result;
+    result.reserve(str.size() + 2);
+    result.append('"');
+
+    for (char const c : str.toUtf8()) {
+        switch (c) {
+        case '"':
+            result.append("\\\"");
+            break;
+        case '\\':
+            result.append("\\\\");
+            break;
+        case '\n':
+            result.append("\\n");
+            break;
+        case '\t':
+            result.append("\\t");
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+                result.append(QByteArray("\\u00") + QByteArray::number(c, 16).rightJustified(2, '0'));
+            else
+                result.append(c);
+            break;
+        }
+    }
+
+    result.append('"');
+    return result;
+}
+
+/// Chrome traces are in microseconds.
+QByteArray microseconds(qint64 ns)
+{
+    return QByteArray::number(ns / 1000.0, 'f', 3);
+}
+
+} // namespace
+
+TraceRecorder::TraceRecorder(GraphProfiler &profiler,
+                             AbstractGraphModel const *model,
+                             QObject *parent)
+    : QObject(parent)
+    , _profiler(profiler)
+    , _model(model)
+    , _recording(false)
+    , _maxEvents(1000000)
+    , _dropped(0)
+{}
+
+TraceRecorder::~TraceRecorder()
+{
+    stop();
+}
+
+void TraceRecorder::start()
+{
+    if (_recording)
+        return;
+
+    _recording = true;
+
+    _profiler.addListener(this);
+    _profiler.setEnabled(true);
+
+    for (auto &scene : _scenes) {
+        if (scene)
+            connectScene(scene);
+    }
+}
+
+void TraceRecorder::stop()
+{
+    if (!_recording)
+        return;
+
+    _recording = false;
+
+    // The profiler is left enabled, other clients may rely on it.
+    _profiler.removeListener(this);
+
+    for (auto const &connection : _sceneConnections)
+        disconnect(connection);
+
+    _sceneConnections.clear();
+}
+
+void TraceRecorder::watchScene(QGraphicsScene *scene)
+{
+    _scenes.emplace_back(scene);
+
+    if (_recording)
+        connectScene(scene);
+}
+
+void TraceRecorder::clear()
+{
+    _events.clear();
+    _dropped = 0;
+    _nodeNames.clear();
+}
+
+void TraceRecorder::connectScene(QGraphicsScene *scene)
+{
+    // `changed` is emitted once per processed batch of scene updates. Keeping
+    // the connection only while recording spares the scene the bookkeeping of
+    // the changed regions otherwise.
+    _sceneConnections.push_back(
+        connect(scene, &QGraphicsScene::changed, this, [this](QList<QRectF> const &) {
+            _profiler.mark(ProfileMark::SceneFlush, InvalidNodeId);
+        }));
+}
+
+bool TraceRecorder::reserveEvent()
+{
+    if (_events.size() >= _maxEvents) {
+        ++_dropped;
+        return false;
+    }
+
+    return true;
+}
+
+int TraceRecorder::currentThread()
+{
+    Qt::HANDLE const handle = QThread::currentThreadId();
+
+    auto it = _threads.find(handle);
+    if (it != _threads.end())
+        return it->second;
+
+    int const thread = static_cast<int>(_threads.size()) + 1;
+    _threads[handle] = thread;
+
+    return thread;
+}
+
+void TraceRecorder::rememberNode(NodeId const nodeId)
+{
+    if (nodeId == InvalidNodeId || _nodeNames.count(nodeId))
+        return;
+
+    // Captions are resolved once, the node may be gone when the trace is saved.
+    QString name;
+    if (_model)
+        name = _model->nodeData(nodeId, NodeRole::Caption).toString();
+
+    if (name.isEmpty())
+        name = QStringLiteral("Node");
+
+    _nodeNames[nodeId] = name;
+}
+
+void TraceRecorder::measured(NodeId const nodeId,
+                             ProfileCategory const category,
+                             qint64 startNs,
+                             qint64 endNs)
+{
+    if (!reserveEvent())
+        return;
+
+    rememberNode(nodeId);
+
+    _events.push_back(Event{startNs,
+                            endNs - startNs,
+                            nodeId,
+                            InvalidPortIndex,
+                            static_cast<int>(category),
+                            currentThread()});
+}
+
+void TraceRecorder::marked(ProfileMark const mark,
+                           NodeId const nodeId,
+                           PortIndex const portIndex,
+                           qint64 timeNs)
+{
+    if (!reserveEvent())
+        return;
+
+    rememberNode(nodeId);
+
+    _events.push_back(Event{timeNs, -1, nodeId, portIndex, static_cast<int>(mark), currentThread()});
+}
+
+bool TraceRecorder::write(QIODevice &device) const
+{
+    QByteArray chunk;
+    chunk.reserve(WriteChunkBytes + 512);
+
+    auto flush = [&]() {
+        bool const ok = device.write(chunk) == chunk.size();
+        chunk.clear();
+        return ok;
+    };
+
+    chunk.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    chunk.append("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+                 "\"args\":{\"name\":\"QtNodes\"}}");
+
+    for (auto const &t : _threads) {
+        chunk.append(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":");
+        chunk.append(QByteArray::number(t.second));
+        chunk.append(",\"args\":{\"name\":\"Thread ");
+        chunk.append(QByteArray::number(t.second));
+        chunk.append("\"}}");
+    }
+
+    for (Event const &e : _events) {
+        bool const instant = e.durationNs < 0;
+
+        chunk.append(",\n{\"name\":\"");
+
+        if (instant) {
+            chunk.append(markName(static_cast<ProfileMark>(e.kind)));
+            chunk.append("\",\"cat\":\"data\",\"ph\":\"i\",\"s\":\"t\"");
+        } else {
+            auto const category = static_cast<ProfileCategory>(e.kind);
+
+            chunk.append(categoryName(category));
+            chunk.append("\",\"cat\":\"");
+            chunk.append(categoryGroup(category));
+            chunk.append("\",\"ph\":\"X\",\"dur\":");
+            chunk.append(microseconds(e.durationNs));
+        }
+
+        chunk.append(",\"ts\":");
+        chunk.append(microseconds(e.startNs));
+        chunk.append(",\"pid\":1,\"tid\":");
+        chunk.append(QByteArray::number(e.thread));
+
+        if (e.nodeId != InvalidNodeId) {
+            chunk.append(",\"args\":{\"nodeId\":");
+            chunk.append(QByteArray::number(e.nodeId));
+
+            auto it = _nodeNames.find(e.nodeId);
+            if (it != _nodeNames.end()) {
+                chunk.append(",\"node\":");
+                chunk.append(jsonString(it->second));
+            }
+
+            if (e.portIndex != InvalidPortIndex) {
+                chunk.append(",\"portIndex\":");
+                chunk.append(QByteArray::number(e.portIndex));
+            }
+
+            chunk.append('}');
+        }
+
+        chunk.append('}');
+
+        if (chunk.size() >= WriteChunkBytes && !flush())
+            return false;
+    }
+
+    chunk.append("\n],\"otherData\":{\"droppedEvents\":");
+    chunk.append(QByteArray::number(static_cast<qulonglong>(_dropped)));
+    chunk.append("}}\n");
+
+    return flush();
+}
+
+bool TraceRecorder::save(QString const &fileName) const
+{
+    QFile file(fileName);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    return write(file);
+}
+
+} // namespace QtNodes
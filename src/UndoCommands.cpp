@@ -2,123 +2,294 @@
 
 #include "BasicGraphicsScene.hpp"
 #include "ConnectionGraphicsObject.hpp"
+#include "ConnectionIdHash.hpp"
 #include "ConnectionIdUtils.hpp"
 #include "Definitions.hpp"
+#include "FlatHash.hpp"
 #include "NodeGraphicsObject.hpp"
 
-#include <QtCore/QJsonArray>
+#include <QtCore/QDir>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QMimeData>
+#include <QtCore/QStringList>
+#include <QtCore/QTemporaryFile>
 #include <QtGui/QClipboard>
 #include <QtWidgets/QApplication>
 #include <QtWidgets/QGraphicsObject>
 
+#include <stdexcept>
 #include <typeinfo>
+#include <utility>
+#include <vector>
 
 namespace QtNodes {
 
-static QJsonObject serializeSelectedItems(BasicGraphicsScene *scene)
+static QString const GraphMimeType = QStringLiteral("application/qt-nodes-graph");
+
+/**
+ * Clipboard payload which keeps the copied items in their parsed form.
+ * Pasting within the same application skips any encoding; the binary
+ * and the textual representations are produced only when some other
+ * client asks for them.
+ */
+class GraphMimeData : public QMimeData
 {
-    QJsonObject serializedScene;
+public:
+    explicit GraphMimeData(SerializedItems items)
+        : _items(std::move(items))
+    {}
 
-    auto &graphModel = scene->graphModel();
+    SerializedItems const &items() const { return _items; }
+
+    QStringList formats() const override
+    {
+        return QStringList() << GraphMimeType << QStringLiteral("text/plain");
+    }
+
+    bool hasFormat(QString const &mimeType) const override
+    {
+        return formats().contains(mimeType);
+    }
+
+protected:
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    QVariant retrieveData(QString const &mimeType, QMetaType) const override
+#else
+    QVariant retrieveData(QString const &mimeType, QVariant::Type) const override
+#endif
+    {
+        if (mimeType == GraphMimeType) {
+            if (_binary.isEmpty())
+                _binary = _items.toBinary();
+
+            return _binary;
+        }
+
+        if (mimeType == QStringLiteral("text/plain"))
+            return QString::fromUtf8(QJsonDocument(_items.toJson()).toJson());
+
+        return QVariant();
+    }
+
+private:
+    SerializedItems _items;
+
+    mutable QByteArray _binary;
+};
+
+/// Only the model's json is kept, the id and the position are stored as plain values.
+static SerializedNode serializeNode(AbstractGraphModel &graphModel, NodeId const nodeId)
+{
+    QJsonObject json = graphModel.saveNode(nodeId);
+    json.remove("id");
+    json.remove("position");
 
-    std::unordered_set<NodeId> selectedNodes;
+    return SerializedNode{nodeId,
+                          graphModel.nodeData(nodeId, NodeRole::Position).value<QPointF>(),
+                          json};
+}
 
-    QJsonArray nodesJsonArray;
+static SerializedItems serializeSelectedItems(BasicGraphicsScene *scene)
+{
+    SerializedItems items;
+
+    auto &graphModel = scene->graphModel();
+
+    FlatHashSet<NodeId> selectedNodes;
 
     for (QGraphicsItem *item : scene->selectedItems()) {
         if (auto n = qgraphicsitem_cast<NodeGraphicsObject *>(item)) {
-            nodesJsonArray.append(graphModel.saveNode(n->nodeId()));
+            items.nodes.push_back(serializeNode(graphModel, n->nodeId()));
 
             selectedNodes.insert(n->nodeId());
         }
     }
 
-    QJsonArray connJsonArray;
-
     for (QGraphicsItem *item : scene->selectedItems()) {
         if (auto c = qgraphicsitem_cast<ConnectionGraphicsObject *>(item)) {
             auto const &cid = c->connectionId();
 
             if (selectedNodes.count(cid.outNodeId) > 0 && selectedNodes.count(cid.inNodeId) > 0) {
-                connJsonArray.append(toJson(cid));
+                items.connections.push_back(cid);
             }
         }
     }
 
-    serializedScene["nodes"] = nodesJsonArray;
-    serializedScene["connections"] = connJsonArray;
+    return items;
+}
+
+static void insertSerializedItems(SerializedItems const &items, BasicGraphicsScene *scene)
+{
+    std::vector<QJsonObject> nodesJson;
+    nodesJson.reserve(items.nodes.size());
 
-    return serializedScene;
+    for (SerializedNode const &node : items.nodes) {
+        nodesJson.push_back(node.toLoadableJson());
+    }
+
+    scene->graphModel().addSubgraph(nodesJson, items.connections);
+
+    for (SerializedNode const &node : items.nodes) {
+        scene->nodeGraphicsObject(node.id)->setZValue(1.0);
+        scene->nodeGraphicsObject(node.id)->setSelected(true);
+    }
+
+    for (ConnectionId const &connId : items.connections) {
+        scene->connectionGraphicsObject(connId)->setSelected(true);
+    }
 }
 
-static void insertSerializedItems(QJsonObject const &json, BasicGraphicsScene *scene)
+static void deleteSerializedItems(SerializedItems const &items, AbstractGraphModel &graphModel)
 {
-    AbstractGraphModel &graphModel = scene->graphModel();
+    std::vector<NodeId> nodeIds;
+    nodeIds.reserve(items.nodes.size());
 
-    QJsonArray const &nodesJsonArray = json["nodes"].toArray();
+    for (SerializedNode const &node : items.nodes) {
+        nodeIds.push_back(node.id);
+    }
 
-    for (QJsonValue node : nodesJsonArray) {
-        QJsonObject obj = node.toObject();
+    FlatHashSet<NodeId> deleted;
+    deleted.reserve(nodeIds.size());
 
-        graphModel.loadNode(obj);
+    for (NodeId const nodeId : nodeIds) {
+        deleted.insert(nodeId);
+    }
 
-        auto id = obj["id"].toInt();
-        scene->nodeGraphicsObject(id)->setZValue(1.0);
-        scene->nodeGraphicsObject(id)->setSelected(true);
+    // The connections attached to the deleted nodes go away with them.
+    for (ConnectionId const &connId : items.connections) {
+        if (deleted.count(connId.outNodeId) == 0 && deleted.count(connId.inNodeId) == 0)
+            graphModel.deleteConnection(connId);
     }
 
-    QJsonArray const &connJsonArray = json["connections"].toArray();
+    graphModel.deleteNodes(nodeIds);
+}
+
+//-------------------------------------
 
-    for (QJsonValue connection : connJsonArray) {
-        QJsonObject connJson = connection.toObject();
+SnapshotCommand::SnapshotCommand(BasicGraphicsScene *scene)
+    : _scene(scene)
+    , _storage(SnapshotStorage::Live)
+    , _liveBytes(0)
+{}
 
-        ConnectionId connId = fromJson(connJson);
+SnapshotCommand::~SnapshotCommand() = default;
 
-        // Restore the connection
-        graphModel.addConnection(connId);
+std::size_t SnapshotCommand::memoryUsage() const
+{
+    switch (_storage) {
+    case SnapshotStorage::Live:
+        if (_liveBytes == 0) {
+            // The encoded size is a fair estimate for what the json objects
+            // occupy; it is computed once per modification.
+            _liveBytes = sizeof(SerializedItems)
+                         + _items.nodes.capacity() * sizeof(SerializedNode)
+                         + _items.connections.capacity() * sizeof(ConnectionId)
+                         + static_cast<std::size_t>(_items.toBinary().size());
+        }
+        return _liveBytes;
 
-        scene->connectionGraphicsObject(connId)->setSelected(true);
+    case SnapshotStorage::Compressed:
+        return static_cast<std::size_t>(_compressed.size());
+
+    case SnapshotStorage::Spilled:
+    case SnapshotStorage::Evicted:
+        break;
     }
+
+    return 0;
 }
 
-static void deleteSerializedItems(QJsonObject &sceneJson, AbstractGraphModel &graphModel)
+std::size_t SnapshotCommand::diskUsage() const
 {
-    QJsonArray connectionJsonArray = sceneJson["connections"].toArray();
+    if (_storage == SnapshotStorage::Spilled && _spillFile)
+        return static_cast<std::size_t>(_spillFile->size());
 
-    for (QJsonValueRef connection : connectionJsonArray) {
-        QJsonObject connJson = connection.toObject();
+    return 0;
+}
 
-        ConnectionId connId = fromJson(connJson);
+bool SnapshotCommand::compress()
+{
+    // `SerializedItems::empty` only looks at the nodes.
+    if (_storage != SnapshotStorage::Live
+        || (_items.nodes.empty() && _items.connections.empty()))
+        return false;
 
-        graphModel.deleteConnection(connId);
-    }
+    _compressed = qCompress(_items.toBinary());
 
-    QJsonArray nodesJsonArray = sceneJson["nodes"].toArray();
+    _items = SerializedItems();
+    _liveBytes = 0;
+    _storage = SnapshotStorage::Compressed;
 
-    for (QJsonValueRef node : nodesJsonArray) {
-        QJsonObject nodeJson = node.toObject();
-        graphModel.deleteNode(nodeJson["id"].toInt());
-    }
+    return true;
+}
+
+bool SnapshotCommand::spill(QString const &directory)
+{
+    if (_storage == SnapshotStorage::Live && !compress())
+        return false;
+
+    if (_storage != SnapshotStorage::Compressed)
+        return false;
+
+    auto file = std::make_unique<QTemporaryFile>(
+        QDir(directory).filePath(QStringLiteral("qtnodes-undo-XXXXXX")));
+
+    if (!file->open() || file->write(_compressed) != _compressed.size() || !file->flush())
+        return false;
+
+    _spillFile = std::move(file);
+
+    _compressed.clear();
+    _compressed.squeeze();
+    _storage = SnapshotStorage::Spilled;
+
+    return true;
 }
 
-static QPointF computeAverageNodePosition(QJsonObject const &sceneJson)
+void SnapshotCommand::evict()
 {
-    QPointF averagePos(0, 0);
+    _items = SerializedItems();
+    _liveBytes = 0;
 
-    QJsonArray nodesJsonArray = sceneJson["nodes"].toArray();
+    _compressed.clear();
+    _compressed.squeeze();
 
-    for (QJsonValueRef node : nodesJsonArray) {
-        QJsonObject nodeJson = node.toObject();
+    _spillFile.reset();
 
-        averagePos += QPointF(nodeJson["position"].toObject()["x"].toDouble(),
-                              nodeJson["position"].toObject()["y"].toDouble());
+    _storage = SnapshotStorage::Evicted;
+
+    setObsolete(true);
+}
+
+SerializedItems &SnapshotCommand::items()
+{
+    restore();
+
+    // The caller is free to modify the items.
+    _liveBytes = 0;
+
+    return _items;
+}
+
+void SnapshotCommand::restore()
+{
+    if (_storage == SnapshotStorage::Spilled) {
+        _spillFile->seek(0);
+        _compressed = _spillFile->readAll();
+        _spillFile.reset();
+
+        _storage = SnapshotStorage::Compressed;
     }
 
-    averagePos /= static_cast<double>(nodesJsonArray.size());
+    if (_storage == SnapshotStorage::Compressed) {
+        if (!SerializedItems::fromBinary(qUncompress(_compressed), _items))
+            throw std::logic_error("Corrupted undo snapshot");
 
-    return averagePos;
+        _compressed.clear();
+        _compressed.squeeze();
+
+        _storage = SnapshotStorage::Live;
+    }
 }
 
 //-------------------------------------
@@ -126,8 +297,7 @@ static QPointF computeAverageNodePosition(QJsonObject const &sceneJson)
 CreateCommand::CreateCommand(BasicGraphicsScene *scene,
                              QString const name,
                              QPointF const &mouseScenePos)
-    : _scene(scene)
-    , _sceneJson(QJsonObject())
+    : SnapshotCommand(scene)
 {
     _nodeId = _scene->graphModel().addNode(name);
     if (_nodeId != InvalidNodeId) {
@@ -139,29 +309,34 @@ CreateCommand::CreateCommand(BasicGraphicsScene *scene,
 
 void CreateCommand::undo()
 {
-    QJsonArray nodesJsonArray;
-    nodesJsonArray.append(_scene->graphModel().saveNode(_nodeId));
-    _sceneJson["nodes"] = nodesJsonArray;
+    SerializedItems &createdItems = items();
+
+    createdItems.nodes.clear();
+    createdItems.nodes.push_back(serializeNode(_scene->graphModel(), _nodeId));
 
     _scene->graphModel().deleteNode(_nodeId);
 }
 
 void CreateCommand::redo()
 {
-    if (_sceneJson.empty() || _sceneJson["nodes"].toArray().empty())
+    if (items().empty())
         return;
 
-    insertSerializedItems(_sceneJson, _scene);
+    insertSerializedItems(items(), _scene);
 }
 
 //-------------------------------------
 
 DeleteCommand::DeleteCommand(BasicGraphicsScene *scene)
-    : _scene(scene)
+    : SnapshotCommand(scene)
 {
     auto &graphModel = _scene->graphModel();
 
-    QJsonArray connJsonArray;
+    SerializedItems &deletedItems = items();
+
+    // A connection could be both selected and attached to a selected node.
+    FlatHashSet<ConnectionId> savedConnections;
+
     // Delete the selected connections first, ensuring that they won't be
     // automatically deleted when selected nodes are deleted (deleting a
     // node deletes some connections as well)
@@ -169,88 +344,54 @@ DeleteCommand::DeleteCommand(BasicGraphicsScene *scene)
         if (auto c = qgraphicsitem_cast<ConnectionGraphicsObject *>(item)) {
             auto const &cid = c->connectionId();
 
-            connJsonArray.append(toJson(cid));
+            if (savedConnections.insert(cid).second)
+                deletedItems.connections.push_back(cid);
         }
     }
 
-    QJsonArray nodesJsonArray;
     // Delete the nodes; this will delete many of the connections.
     // Selected connections were already deleted prior to this loop,
     for (QGraphicsItem *item : _scene->selectedItems()) {
         if (auto n = qgraphicsitem_cast<NodeGraphicsObject *>(item)) {
             // saving connections attached to the selected nodes
             for (auto const &cid : graphModel.allConnectionIds(n->nodeId())) {
-                connJsonArray.append(toJson(cid));
+                if (savedConnections.insert(cid).second)
+                    deletedItems.connections.push_back(cid);
             }
 
-            nodesJsonArray.append(graphModel.saveNode(n->nodeId()));
+            deletedItems.nodes.push_back(serializeNode(graphModel, n->nodeId()));
         }
     }
 
     // If nothing is deleted, cancel this operation
-    if (connJsonArray.isEmpty() && nodesJsonArray.isEmpty())
+    if (deletedItems.connections.empty() && deletedItems.nodes.empty())
         setObsolete(true);
-
-    _sceneJson["nodes"] = nodesJsonArray;
-    _sceneJson["connections"] = connJsonArray;
 }
 
 void DeleteCommand::undo()
 {
-    insertSerializedItems(_sceneJson, _scene);
+    insertSerializedItems(items(), _scene);
 }
 
 void DeleteCommand::redo()
 {
-    deleteSerializedItems(_sceneJson, _scene->graphModel());
-}
-
-//-------------------------------------
-
-void offsetNodeGroup(QJsonObject &sceneJson, QPointF const &diff)
-{
-    QJsonArray nodesJsonArray = sceneJson["nodes"].toArray();
-
-    QJsonArray newNodesJsonArray;
-    for (QJsonValueRef node : nodesJsonArray) {
-        QJsonObject obj = node.toObject();
-
-        QPointF oldPos(obj["position"].toObject()["x"].toDouble(),
-                       obj["position"].toObject()["y"].toDouble());
-
-        oldPos += diff;
-
-        QJsonObject posJson;
-        posJson["x"] = oldPos.x();
-        posJson["y"] = oldPos.y();
-        obj["position"] = posJson;
-
-        newNodesJsonArray.append(obj);
-    }
-
-    sceneJson["nodes"] = newNodesJsonArray;
+    deleteSerializedItems(items(), _scene->graphModel());
 }
 
 //-------------------------------------
 
 CopyCommand::CopyCommand(BasicGraphicsScene *scene)
 {
-    QJsonObject sceneJson = serializeSelectedItems(scene);
+    SerializedItems items = serializeSelectedItems(scene);
 
-    if (sceneJson.empty() || sceneJson["nodes"].toArray().empty()) {
+    if (items.empty()) {
         setObsolete(true);
         return;
     }
 
     QClipboard *clipboard = QApplication::clipboard();
 
-    QByteArray const data = QJsonDocument(sceneJson).toJson();
-
-    QMimeData *mimeData = new QMimeData();
-    mimeData->setData("application/qt-nodes-graph", data);
-    mimeData->setText(data);
-
-    clipboard->setMimeData(mimeData);
+    clipboard->setMimeData(new GraphMimeData(std::move(items)));
 
     // Copy command does not have any effective redo/undo operations.
     // It copies the data to the clipboard and could be immediately removed
@@ -261,26 +402,26 @@ CopyCommand::CopyCommand(BasicGraphicsScene *scene)
 //-------------------------------------
 
 PasteCommand::PasteCommand(BasicGraphicsScene *scene, QPointF const &mouseScenePos)
-    : _scene(scene)
+    : SnapshotCommand(scene)
     , _mouseScenePos(mouseScenePos)
 {
-    _newSceneJson = takeSceneJsonFromClipboard();
+    SerializedItems &newItems = items();
+
+    newItems = takeItemsFromClipboard();
 
-    if (_newSceneJson.empty() || _newSceneJson["nodes"].toArray().empty()) {
+    if (newItems.empty()) {
         setObsolete(true);
         return;
     }
 
-    _newSceneJson = makeNewNodeIdsInScene(_newSceneJson);
+    makeNewNodeIdsInScene(newItems);
 
-    QPointF averagePos = computeAverageNodePosition(_newSceneJson);
-
-    offsetNodeGroup(_newSceneJson, _mouseScenePos - averagePos);
+    newItems.offset(_mouseScenePos - newItems.averagePosition());
 }
 
 void PasteCommand::undo()
 {
-    deleteSerializedItems(_newSceneJson, _scene->graphModel());
+    deleteSerializedItems(items(), _scene->graphModel());
 }
 
 void PasteCommand::redo()
@@ -289,84 +430,77 @@ void PasteCommand::redo()
 
     // Ignore if pasted in content does not generate nodes.
     try {
-        insertSerializedItems(_newSceneJson, _scene);
+        insertSerializedItems(items(), _scene);
     } catch (...) {
         // If the paste does not work, delete all selected nodes and connections
         // `deleteNode(...)` implicitly removed connections
-        auto &graphModel = _scene->graphModel();
+        std::vector<NodeId> insertedNodes;
 
-        QJsonArray nodesJsonArray;
         for (QGraphicsItem *item : _scene->selectedItems()) {
             if (auto n = qgraphicsitem_cast<NodeGraphicsObject *>(item)) {
-                graphModel.deleteNode(n->nodeId());
+                insertedNodes.push_back(n->nodeId());
             }
         }
 
+        _scene->graphModel().deleteNodes(insertedNodes);
+
+        // The ids taken in `makeNewNodeIdsInScene` would stay reserved.
+        for (SerializedNode const &node : items().nodes)
+            _scene->graphModel().releaseNodeId(node.id);
+
         setObsolete(true);
     }
 }
 
-QJsonObject PasteCommand::takeSceneJsonFromClipboard()
+SerializedItems PasteCommand::takeItemsFromClipboard()
 {
     QClipboard const *clipboard = QApplication::clipboard();
     QMimeData const *mimeData = clipboard->mimeData();
 
-    QJsonDocument json;
-    if (mimeData->hasFormat("application/qt-nodes-graph")) {
-        json = QJsonDocument::fromJson(mimeData->data("application/qt-nodes-graph"));
-    } else if (mimeData->hasText()) {
-        json = QJsonDocument::fromJson(mimeData->text().toUtf8());
-    }
+    if (!mimeData)
+        return SerializedItems();
 
-    return json.object();
-}
+    // Copied within this application: no decoding at all.
+    if (auto graphMimeData = dynamic_cast<GraphMimeData const *>(mimeData))
+        return graphMimeData->items();
 
-QJsonObject PasteCommand::makeNewNodeIdsInScene(QJsonObject const &sceneJson)
-{
-    AbstractGraphModel &graphModel = _scene->graphModel();
+    if (mimeData->hasFormat(GraphMimeType)) {
+        QByteArray const data = mimeData->data(GraphMimeType);
 
-    std::unordered_map<NodeId, NodeId> mapNodeIds;
+        SerializedItems items;
+        if (SerializedItems::fromBinary(data, items))
+            return items;
 
-    QJsonArray nodesJsonArray = sceneJson["nodes"].toArray();
-
-    QJsonArray newNodesJsonArray;
-    for (QJsonValueRef node : nodesJsonArray) {
-        QJsonObject nodeJson = node.toObject();
-
-        NodeId oldNodeId = nodeJson["id"].toInt();
-
-        NodeId newNodeId = graphModel.newNodeId();
-
-        mapNodeIds[oldNodeId] = newNodeId;
-
-        // Replace NodeId in json
-        nodeJson["id"] = static_cast<qint64>(newNodeId);
-
-        newNodesJsonArray.append(nodeJson);
+        // Payloads written by the earlier versions hold json text.
+        return SerializedItems::fromJson(QJsonDocument::fromJson(data).object());
     }
 
-    QJsonArray connectionJsonArray = sceneJson["connections"].toArray();
+    if (mimeData->hasText()) {
+        return SerializedItems::fromJson(QJsonDocument::fromJson(mimeData->text().toUtf8()).object());
+    }
 
-    QJsonArray newConnJsonArray;
-    for (QJsonValueRef connection : connectionJsonArray) {
-        QJsonObject connJson = connection.toObject();
+    return SerializedItems();
+}
 
-        ConnectionId connId = fromJson(connJson);
+void PasteCommand::makeNewNodeIdsInScene(SerializedItems &items)
+{
+    AbstractGraphModel &graphModel = _scene->graphModel();
 
-        ConnectionId newConnId{mapNodeIds[connId.outNodeId],
-                               connId.outPortIndex,
-                               mapNodeIds[connId.inNodeId],
-                               connId.inPortIndex};
+    FlatHashMap<NodeId, NodeId> mapNodeIds;
+    mapNodeIds.reserve(items.nodes.size());
 
-        newConnJsonArray.append(toJson(newConnId));
-    }
+    for (SerializedNode &node : items.nodes) {
+        NodeId const newNodeId = graphModel.newNodeId();
 
-    QJsonObject newSceneJson;
+        mapNodeIds[node.id] = newNodeId;
 
-    newSceneJson["nodes"] = newNodesJsonArray;
-    newSceneJson["connections"] = newConnJsonArray;
+        node.id = newNodeId;
+    }
 
-    return newSceneJson;
+    for (ConnectionId &connId : items.connections) {
+        connId.outNodeId = mapNodeIds[connId.outNodeId];
+        connId.inNodeId = mapNodeIds[connId.inNodeId];
+    }
 }
 
 //-------------------------------------
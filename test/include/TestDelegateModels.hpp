@@ -0,0 +1,156 @@
+#pragma once
+
+#include <memory>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QThread>
+
+#include <QtNodes/NodeData>
+#include <QtNodes/NodeDelegateModel>
+#include <QtNodes/NodeDelegateModelRegistry>
+
+class NumberData : public QtNodes::NodeData
+{
+public:
+    explicit NumberData(double value)
+        : _value(value)
+    {}
+
+    QtNodes::NodeDataType type() const override { return QtNodes::NodeDataType{"number", "Number"}; }
+
+    double value() const { return _value; }
+
+private:
+    double _value;
+};
+
+/// One out-port with a number restored from `internal-data`.
+class SourceModel : public QtNodes::NodeDelegateModel
+{
+public:
+    static QString Name() { return "Source"; }
+
+    QString name() const override { return Name(); }
+
+    QString caption() const override { return Name(); }
+
+    unsigned int nPorts(QtNodes::PortType portType) const override
+    {
+        return portType == QtNodes::PortType::Out ? 1 : 0;
+    }
+
+    QtNodes::NodeDataType dataType(QtNodes::PortType, QtNodes::PortIndex) const override
+    {
+        return QtNodes::NodeDataType{"number", "Number"};
+    }
+
+    std::shared_ptr<QtNodes::NodeData> outData(QtNodes::PortIndex const) override
+    {
+        return std::make_shared<NumberData>(_value);
+    }
+
+    void setInData(std::shared_ptr<QtNodes::NodeData>, QtNodes::PortIndex const) override {}
+
+    QWidget *embeddedWidget() override { return nullptr; }
+
+    QJsonObject save() const override
+    {
+        QJsonObject modelJson = NodeDelegateModel::save();
+        modelJson["value"] = _value;
+        return modelJson;
+    }
+
+    void preload(QJsonObject const &modelJson) override
+    {
+        _preloadedValue = modelJson["value"].toDouble();
+        _preloadThread = QThread::currentThread();
+    }
+
+    void load(QJsonObject const &modelJson) override
+    {
+        _value = _preloadThread ? _preloadedValue : modelJson["value"].toDouble();
+    }
+
+    void setValue(double value)
+    {
+        _value = value;
+        Q_EMIT dataUpdated(0);
+    }
+
+    double value() const { return _value; }
+
+    /// `nullptr` unless `preload` was called.
+    QThread *preloadThread() const { return _preloadThread; }
+
+private:
+    double _value = 0.0;
+    double _preloadedValue = 0.0;
+    QThread *_preloadThread = nullptr;
+};
+
+/// Adds up its two in-ports and counts the `setInData` calls.
+class SumModel : public QtNodes::NodeDelegateModel
+{
+public:
+    static QString Name() { return "Sum"; }
+
+    QString name() const override { return Name(); }
+
+    QString caption() const override { return Name(); }
+
+    unsigned int nPorts(QtNodes::PortType portType) const override
+    {
+        return portType == QtNodes::PortType::In ? 2 : 1;
+    }
+
+    QtNodes::NodeDataType dataType(QtNodes::PortType, QtNodes::PortIndex) const override
+    {
+        return QtNodes::NodeDataType{"number", "Number"};
+    }
+
+    std::shared_ptr<QtNodes::NodeData> outData(QtNodes::PortIndex const) override
+    {
+        return std::make_shared<NumberData>(_inputs[0] + _inputs[1]);
+    }
+
+    void setInData(std::shared_ptr<QtNodes::NodeData> nodeData,
+                   QtNodes::PortIndex const portIndex) override
+    {
+        auto number = std::dynamic_pointer_cast<NumberData>(nodeData);
+        _inputs[portIndex] = number ? number->value() : 0.0;
+
+        ++_setInDataCalls[portIndex];
+
+        Q_EMIT dataUpdated(0);
+    }
+
+    QWidget *embeddedWidget() override { return nullptr; }
+
+    bool reset() override
+    {
+        _inputs[0] = _inputs[1] = 0.0;
+        _setInDataCalls[0] = _setInDataCalls[1] = 0;
+        return true;
+    }
+
+    double sum() const { return _inputs[0] + _inputs[1]; }
+
+    int setInDataCalls(QtNodes::PortIndex const portIndex) const
+    {
+        return _setInDataCalls[portIndex];
+    }
+
+private:
+    double _inputs[2] = {0.0, 0.0};
+    int _setInDataCalls[2] = {0, 0};
+};
+
+inline std::shared_ptr<QtNodes::NodeDelegateModelRegistry> registerTestModels()
+{
+    auto registry = std::make_shared<QtNodes::NodeDelegateModelRegistry>();
+
+    registry->registerModel<SourceModel>("Test");
+    registry->registerModel<SumModel>("Test");
+
+    return registry;
+}
@@ -0,0 +1,171 @@
+#include <QtNodes/DataFlowGraphModel>
+
+#include <catch2/catch.hpp>
+
+#include <QtCore/QJsonObject>
+
+#include <vector>
+
+#include "TestDelegateModels.hpp"
+
+using QtNodes::AbstractGraphModel;
+using QtNodes::ConnectionId;
+using QtNodes::DataFlowGraphModel;
+using QtNodes::InvalidNodeId;
+using QtNodes::NodeId;
+
+namespace {
+
+struct SignalCounts
+{
+    int nodesAboutToBeDeleted = 0;
+    int nodesDeleted = 0;
+    int nodeDeleted = 0;
+    int connectionDeleted = 0;
+    int modelReset = 0;
+
+    std::vector<NodeId> batch;
+};
+
+void countSignals(DataFlowGraphModel &model, SignalCounts &counts)
+{
+    QObject::connect(&model,
+                     &AbstractGraphModel::nodesAboutToBeDeleted,
+                     [&model, &counts](std::vector<NodeId> const &nodeIds) {
+                         ++counts.nodesAboutToBeDeleted;
+                         counts.batch = nodeIds;
+
+                         // Announced while the nodes are still there.
+                         for (NodeId const nodeId : nodeIds) {
+                             CHECK(model.nodeExists(nodeId));
+                         }
+                     });
+
+    QObject::connect(&model,
+                     &AbstractGraphModel::nodesDeleted,
+                     [&model, &counts](std::vector<NodeId> const &nodeIds) {
+                         ++counts.nodesDeleted;
+
+                         CHECK(nodeIds == counts.batch);
+
+                         for (NodeId const nodeId : nodeIds) {
+                             CHECK_FALSE(model.nodeExists(nodeId));
+                         }
+                     });
+
+    QObject::connect(&model, &AbstractGraphModel::nodeDeleted, [&counts](NodeId) {
+        ++counts.nodeDeleted;
+    });
+
+    QObject::connect(&model, &AbstractGraphModel::connectionDeleted, [&counts](ConnectionId) {
+        ++counts.connectionDeleted;
+    });
+
+    QObject::connect(&model, &AbstractGraphModel::modelReset, [&counts]() { ++counts.modelReset; });
+}
+
+} // namespace
+
+TEST_CASE("DataFlowGraphModel bulk edits", "[model]")
+{
+    DataFlowGraphModel model(registerTestModels());
+
+    // source -> a (both ports) -> b -> c, source -> d
+    NodeId const source = model.addNode(SourceModel::Name());
+    NodeId const a = model.addNode(SumModel::Name());
+    NodeId const b = model.addNode(SumModel::Name());
+    NodeId const c = model.addNode(SumModel::Name());
+    NodeId const d = model.addNode(SumModel::Name());
+
+    std::vector<ConnectionId> const subgraphConnections{ConnectionId{source, 0, a, 0},
+                                                        ConnectionId{source, 0, a, 1},
+                                                        ConnectionId{a, 0, b, 0}};
+
+    for (ConnectionId const &connectionId : subgraphConnections) {
+        model.addConnection(connectionId);
+    }
+
+    model.addConnection(ConnectionId{b, 0, c, 0});
+    model.addConnection(ConnectionId{source, 0, d, 1});
+
+    model.delegateModel<SourceModel>(source)->setValue(2.0);
+
+    REQUIRE(model.delegateModel<SumModel>(c)->sum() == 4.0);
+
+    SignalCounts counts;
+    countSignals(model, counts);
+
+    SECTION("deleteNodes")
+    {
+        SumModel *sumB = model.delegateModel<SumModel>(b);
+        SumModel *sumD = model.delegateModel<SumModel>(d);
+
+        int const callsB = sumB->setInDataCalls(0);
+        int const callsD = sumD->setInDataCalls(1);
+
+        // Repeated and unknown ids are skipped.
+        model.deleteNodes({source, a, source, InvalidNodeId});
+
+        CHECK_FALSE(model.nodeExists(source));
+        CHECK_FALSE(model.nodeExists(a));
+        CHECK(model.allNodeIds().size() == 3);
+
+        CHECK(counts.nodesAboutToBeDeleted == 1);
+        CHECK(counts.nodesDeleted == 1);
+        CHECK(counts.batch == std::vector<NodeId>{source, a});
+        CHECK(counts.nodeDeleted == 2);
+        CHECK(counts.connectionDeleted == 4);
+
+        // The survivors get the empty data once, after all the nodes are gone.
+        CHECK(sumB->setInDataCalls(0) == callsB + 1);
+        CHECK(sumD->setInDataCalls(1) == callsD + 1);
+        CHECK(sumB->sum() == 0.0);
+        CHECK(model.delegateModel<SumModel>(c)->sum() == 0.0);
+    }
+
+    SECTION("addSubgraph")
+    {
+        std::vector<QJsonObject> const nodesJson{model.saveNode(source), model.saveNode(a)};
+
+        model.deleteNodes({source, a});
+
+        SumModel *sumB = model.delegateModel<SumModel>(b);
+        SumModel *sumC = model.delegateModel<SumModel>(c);
+
+        int const callsB = sumB->setInDataCalls(0);
+        int const callsC = sumC->setInDataCalls(0);
+
+        model.addSubgraph(nodesJson, subgraphConnections);
+
+        REQUIRE(model.nodeExists(source));
+        REQUIRE(model.nodeExists(a));
+
+        for (ConnectionId const &connectionId : subgraphConnections) {
+            CHECK(model.connectionExists(connectionId));
+        }
+
+        // One topological pass, then the stale nodes downstream are updated.
+        SumModel *sumA = model.delegateModel<SumModel>(a);
+
+        CHECK(sumA->setInDataCalls(0) == 1);
+        CHECK(sumA->setInDataCalls(1) == 1);
+        CHECK(sumB->setInDataCalls(0) == callsB + 1);
+        CHECK(sumC->setInDataCalls(0) == callsC + 1);
+        CHECK(sumC->sum() == 4.0);
+    }
+
+    SECTION("clear")
+    {
+        model.clear();
+
+        CHECK(model.allNodeIds().empty());
+        CHECK(counts.modelReset == 1);
+        CHECK(counts.nodeDeleted == 0);
+        CHECK(counts.connectionDeleted == 0);
+
+        // The model is usable afterwards.
+        NodeId const nodeId = model.addNode(SumModel::Name());
+        CHECK(model.nodeExists(nodeId));
+        CHECK(model.topologicalOrder() == std::vector<NodeId>{nodeId});
+    }
+}
@@ -0,0 +1,98 @@
+#include <QtNodes/ConnectionStyle>
+#include <QtNodes/NodeData>
+
+#include <catch2/catch.hpp>
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
+#include <QtCore/QStringList>
+
+#include <cstdlib>
+
+using QtNodes::ConnectionStyle;
+using QtNodes::InvalidNodeDataTypeId;
+using QtNodes::internNodeDataType;
+
+TEST_CASE("ConnectionStyle data type colors", "[style]")
+{
+    ConnectionStyle style;
+
+    SECTION("generated once per type")
+    {
+        QColor const color = style.normalColor(QString("style-test-a"));
+
+        CHECK(color.isValid());
+        CHECK(style.normalColor(QString("style-test-a")) == color);
+        CHECK(style.normalColor(internNodeDataType("style-test-a")) == color);
+
+        // Derived from the id only.
+        CHECK(ConnectionStyle().normalColor(QString("style-test-a")) == color);
+    }
+
+    SECTION("invalid type")
+    {
+        CHECK(style.normalColor(InvalidNodeDataTypeId) == style.normalColor());
+    }
+
+    SECTION("registered color replaces the cached one")
+    {
+        style.normalColor(QString("style-test-b"));
+
+        style.setDataTypeColor("style-test-b", Qt::darkYellow);
+
+        CHECK(style.normalColor(QString("style-test-b")) == QColor(Qt::darkYellow));
+        CHECK(style.dataTypeColors().at("style-test-b") == QColor(Qt::darkYellow));
+    }
+
+    SECTION("palette")
+    {
+        QStringList const typeIds{"style-test-c", "style-test-d", "style-test-e"};
+
+        style.setDataTypeColor("style-test-e", Qt::red);
+        style.setDataTypePalette(typeIds);
+
+        int const hueC = style.normalColor(QString("style-test-c")).hslHue();
+        int const hueD = style.normalColor(QString("style-test-d")).hslHue();
+
+        // Neighbours in the list are a golden angle apart.
+        CHECK(std::abs(hueC - hueD) > 90);
+
+        // The explicitly registered color wins over the palette.
+        CHECK(style.normalColor(QString("style-test-e")) == QColor(Qt::red));
+
+        // Palette colors are not saved.
+        CHECK(style.dataTypeColors().count("style-test-c") == 0);
+    }
+}
+
+TEST_CASE("ConnectionStyle data type colors in json", "[style]")
+{
+    QJsonObject dataTypeColors;
+    dataTypeColors["style-json-a"] = "#3f9fd8";
+    dataTypeColors["style-json-b"] = QJsonArray{200, 120, 40};
+    dataTypeColors["style-json-c"] = "not a color";
+
+    QJsonObject connectionStyle;
+    connectionStyle["UseDataDefinedColors"] = true;
+    connectionStyle["DataTypeColors"] = dataTypeColors;
+
+    QJsonObject json;
+    json["ConnectionStyle"] = connectionStyle;
+
+    ConnectionStyle style;
+    style.loadJson(json);
+
+    CHECK(style.useDataDefinedColors());
+    CHECK(style.normalColor(QString("style-json-a")) == QColor("#3f9fd8"));
+    CHECK(style.normalColor(QString("style-json-b")) == QColor(200, 120, 40));
+    CHECK(style.dataTypeColors().count("style-json-c") == 0);
+
+    SECTION("saved and restored")
+    {
+        ConnectionStyle restored;
+        restored.loadJson(style.toJson());
+
+        CHECK(restored.dataTypeColors().size() == 2);
+        CHECK(restored.normalColor(QString("style-json-b")) == QColor(200, 120, 40));
+    }
+}
@@ -0,0 +1,94 @@
+#include <QtNodes/DataFlowGraphModel>
+
+#include <catch2/catch.hpp>
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
+
+#include "TestDelegateModels.hpp"
+
+using QtNodes::ConnectionId;
+using QtNodes::DataFlowGraphModel;
+using QtNodes::NodeId;
+
+TEST_CASE("DataFlowGraphModel::load propagates in one topological pass", "[load]")
+{
+    // source -> a (both ports), a -> b, source -> b, b -> c, a -> c
+    QJsonObject scene;
+    NodeId source, a, b, c;
+    {
+        DataFlowGraphModel model(registerTestModels());
+
+        source = model.addNode(SourceModel::Name());
+        a = model.addNode(SumModel::Name());
+        b = model.addNode(SumModel::Name());
+        c = model.addNode(SumModel::Name());
+
+        model.delegateModel<SourceModel>(source)->setValue(1.0);
+
+        model.addConnection(ConnectionId{source, 0, a, 0});
+        model.addConnection(ConnectionId{source, 0, a, 1});
+        model.addConnection(ConnectionId{a, 0, b, 0});
+        model.addConnection(ConnectionId{source, 0, b, 1});
+        model.addConnection(ConnectionId{b, 0, c, 0});
+        model.addConnection(ConnectionId{a, 0, c, 1});
+
+        scene = model.save();
+    }
+
+    auto withConnections = [&scene](QJsonArray const &connections) {
+        QJsonObject reordered = scene;
+        reordered["connections"] = connections;
+        return reordered;
+    };
+
+    QJsonArray const saved = scene["connections"].toArray();
+
+    QJsonArray reversed;
+    for (int i = saved.size() - 1; i >= 0; --i) {
+        reversed.append(saved[i]);
+    }
+
+    for (QJsonArray const &connections : {saved, reversed}) {
+        DataFlowGraphModel model(registerTestModels());
+        model.load(withConnections(connections));
+
+        SumModel *sumA = model.delegateModel<SumModel>(a);
+        SumModel *sumB = model.delegateModel<SumModel>(b);
+        SumModel *sumC = model.delegateModel<SumModel>(c);
+
+        REQUIRE(sumA);
+        REQUIRE(sumB);
+        REQUIRE(sumC);
+
+        // Every in-port is set once, the nested `dataUpdated` is not followed.
+        for (SumModel *sum : {sumA, sumB, sumC}) {
+            CHECK(sum->setInDataCalls(0) == 1);
+            CHECK(sum->setInDataCalls(1) == 1);
+        }
+
+        // The upstream nodes are complete by the time they are read.
+        CHECK(sumA->sum() == 2.0);
+        CHECK(sumB->sum() == 3.0);
+        CHECK(sumC->sum() == 5.0);
+    }
+}
+
+TEST_CASE("DataFlowGraphModel propagates edits after the load", "[load]")
+{
+    DataFlowGraphModel model(registerTestModels());
+
+    NodeId const source = model.addNode(SourceModel::Name());
+    NodeId const sum = model.addNode(SumModel::Name());
+
+    model.addConnection(ConnectionId{source, 0, sum, 0});
+
+    DataFlowGraphModel loaded(registerTestModels());
+    loaded.load(model.save());
+
+    // The suppression ends with the ordered pass.
+    loaded.delegateModel<SourceModel>(source)->setValue(4.0);
+
+    CHECK(loaded.delegateModel<SumModel>(sum)->sum() == 4.0);
+    CHECK(loaded.delegateModel<SumModel>(sum)->setInDataCalls(0) == 2);
+}
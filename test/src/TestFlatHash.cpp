@@ -0,0 +1,169 @@
+#include <QtNodes/internal/FlatHash.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <unordered_map>
+
+using QtNodes::FlatHashMap;
+using QtNodes::FlatHashSet;
+
+namespace {
+
+/// Multiplicative inverse of the table's Fibonacci constant modulo 2^64.
+constexpr std::uint64_t inverseGolden()
+{
+    std::uint64_t const golden = 0x9e3779b97f4a7c15ull;
+
+    // Newton's iteration doubles the correct low bits every step.
+    std::uint64_t x = golden;
+    for (int i = 0; i < 6; ++i)
+        x *= 2 - golden * x;
+
+    return x;
+}
+
+static_assert(0x9e3779b97f4a7c15ull * inverseGolden() == 1, "Not the inverse");
+
+/// Sends every key to the last slot, the probe chains wrap around the table.
+struct LastSlotHash
+{
+    std::size_t operator()(int) const
+    {
+        return static_cast<std::size_t>(~std::uint64_t(0) * inverseGolden());
+    }
+};
+
+/// Four ideal slots only, long clustered chains.
+struct ClusteredHash
+{
+    std::size_t operator()(int key) const { return static_cast<std::size_t>(key % 4); }
+};
+
+} // namespace
+
+TEST_CASE("FlatHashMap basic operations", "[flathash]")
+{
+    FlatHashMap<int, int> map;
+
+    CHECK(map.empty());
+    CHECK(map.find(1) == map.end());
+
+    map[1] = 10;
+    CHECK(map.insert({2, 20}).second);
+    CHECK_FALSE(map.insert({2, 30}).second);
+
+    CHECK(map.size() == 2);
+    CHECK(map.at(2) == 20);
+    CHECK_THROWS_AS(map.at(3), std::out_of_range);
+
+    CHECK(map.erase(1) == 1);
+    CHECK(map.erase(1) == 0);
+    CHECK_FALSE(map.contains(1));
+
+    map.clear();
+    CHECK(map.empty());
+    CHECK(map.find(2) == map.end());
+}
+
+TEST_CASE("FlatHashMap backward shift erase keeps the chains reachable", "[flathash]")
+{
+    SECTION("chain wrapping around the end of the table")
+    {
+        FlatHashMap<int, int, LastSlotHash> map;
+
+        // Seven values fill the table of eight slots up to the load limit.
+        for (int key = 0; key < 7; ++key)
+            map[key] = key;
+
+        REQUIRE(map.capacity() == 8);
+
+        std::set<int> remaining{0, 1, 2, 3, 4, 5, 6};
+
+        for (int erased : {0, 3, 6, 1}) {
+            REQUIRE(map.erase(erased) == 1);
+            remaining.erase(erased);
+
+            for (int key = 0; key < 7; ++key)
+                CHECK(map.contains(key) == (remaining.count(key) == 1));
+        }
+
+        CHECK(map.size() == 3);
+    }
+    SECTION("erasing while every chain is clustered")
+    {
+        FlatHashMap<int, int, ClusteredHash> map;
+        std::unordered_map<int, int> expected;
+
+        std::mt19937 random(7);
+
+        for (int step = 0; step < 20000; ++step) {
+            int const key = static_cast<int>(random() % 200);
+
+            if (random() % 3 == 0) {
+                REQUIRE(map.erase(key) == expected.erase(key));
+            } else {
+                map[key] = step;
+                expected[key] = step;
+            }
+
+            REQUIRE(map.size() == expected.size());
+        }
+
+        for (auto const &entry : expected) {
+            auto it = map.find(entry.first);
+            REQUIRE(it != map.end());
+            CHECK(it->second == entry.second);
+        }
+
+        std::size_t visited = 0;
+        for (auto const &entry : map) {
+            CHECK(expected.count(entry.first) == 1);
+            ++visited;
+        }
+
+        CHECK(visited == expected.size());
+    }
+}
+
+TEST_CASE("FlatHashMap destroys an erased value after the table is consistent", "[flathash]")
+{
+    using Map = FlatHashMap<int, std::shared_ptr<int>, ClusteredHash>;
+
+    Map map;
+
+    for (int key = 0; key < 6; ++key)
+        map[key] = std::make_shared<int>(key);
+
+    bool found = false;
+
+    // The value's destructor looks up a key moved back by the erasure.
+    map[0] = std::shared_ptr<int>(new int(0), [&map, &found](int *value) {
+        found = map.contains(4);
+        delete value;
+    });
+
+    map.erase(0);
+
+    CHECK(found);
+}
+
+TEST_CASE("FlatHashSet basic operations", "[flathash]")
+{
+    FlatHashSet<int> set;
+
+    CHECK(set.insert(5).second);
+    CHECK_FALSE(set.insert(5).second);
+    CHECK(set.count(5) == 1);
+
+    set.reserve(100);
+    CHECK(set.capacity() >= 100);
+    CHECK(set.contains(5));
+
+    set.erase(set.find(5));
+    CHECK(set.empty());
+}
@@ -0,0 +1,443 @@
+#include <QtNodes/AbstractGraphModel>
+#include <QtNodes/GraphAnalysis>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <unordered_set>
+#include <vector>
+
+using QtNodes::AbstractGraphModel;
+using QtNodes::ConnectionId;
+using QtNodes::GraphAnalysis;
+using QtNodes::NodeId;
+using QtNodes::NodeRole;
+using QtNodes::PortIndex;
+using QtNodes::PortRole;
+using QtNodes::PortType;
+
+namespace {
+
+/// Nodes and connections only, the analysis reads nothing else.
+class GraphModel : public AbstractGraphModel
+{
+public:
+    static constexpr unsigned int PortsPerNode = 64;
+
+    NodeId newNodeId() override { return _nextNodeId++; }
+
+    std::unordered_set<NodeId> allNodeIds() const override { return _nodes; }
+
+    std::unordered_set<ConnectionId> allConnectionIds(NodeId const nodeId) const override
+    {
+        std::unordered_set<ConnectionId> result;
+
+        for (ConnectionId const &connectionId : _connections) {
+            if (connectionId.outNodeId == nodeId || connectionId.inNodeId == nodeId)
+                result.insert(connectionId);
+        }
+
+        return result;
+    }
+
+    std::unordered_set<ConnectionId> connections(NodeId nodeId,
+                                                 PortType portType,
+                                                 PortIndex portIndex) const override
+    {
+        std::unordered_set<ConnectionId> result;
+
+        for (ConnectionId const &connectionId : _connections) {
+            bool const out = portType == PortType::Out;
+
+            if ((out ? connectionId.outNodeId : connectionId.inNodeId) == nodeId
+                && (out ? connectionId.outPortIndex : connectionId.inPortIndex) == portIndex)
+                result.insert(connectionId);
+        }
+
+        return result;
+    }
+
+    bool connectionExists(ConnectionId const connectionId) const override
+    {
+        return _connections.count(connectionId) != 0;
+    }
+
+    NodeId addNode(QString const = QString()) override
+    {
+        NodeId const nodeId = newNodeId();
+
+        _nodes.insert(nodeId);
+
+        Q_EMIT nodeCreated(nodeId);
+
+        return nodeId;
+    }
+
+    bool connectionPossible(ConnectionId const connectionId) const override
+    {
+        return nodeExists(connectionId.outNodeId) && nodeExists(connectionId.inNodeId)
+               && connectionId.outPortIndex < PortsPerNode && !connectionExists(connectionId);
+    }
+
+    void addConnection(ConnectionId const connectionId) override
+    {
+        _connections.insert(connectionId);
+
+        Q_EMIT connectionCreated(connectionId);
+    }
+
+    bool nodeExists(NodeId const nodeId) const override { return _nodes.count(nodeId) != 0; }
+
+    QVariant nodeData(NodeId, NodeRole) const override { return QVariant(); }
+
+    bool setNodeData(NodeId, NodeRole, QVariant) override { return false; }
+
+    QVariant portData(NodeId, PortType, PortIndex, PortRole) const override { return QVariant(); }
+
+    bool setPortData(NodeId, PortType, PortIndex, QVariant const &, PortRole) override
+    {
+        return false;
+    }
+
+    bool deleteConnection(ConnectionId const connectionId) override
+    {
+        if (_connections.erase(connectionId) == 0)
+            return false;
+
+        Q_EMIT connectionDeleted(connectionId);
+
+        return true;
+    }
+
+    bool deleteNode(NodeId const nodeId) override
+    {
+        if (!nodeExists(nodeId))
+            return false;
+
+        for (ConnectionId const &connectionId : allConnectionIds(nodeId))
+            deleteConnection(connectionId);
+
+        _nodes.erase(nodeId);
+
+        Q_EMIT nodeDeleted(nodeId);
+
+        return true;
+    }
+
+    void clear() override
+    {
+        _nodes.clear();
+        _connections.clear();
+
+        Q_EMIT modelReset();
+    }
+
+private:
+    NodeId _nextNodeId = 0;
+
+    std::unordered_set<NodeId> _nodes;
+
+    std::unordered_set<ConnectionId> _connections;
+};
+
+/// Connects the nodes through the next free ports.
+void connect(GraphModel &model, NodeId const from, NodeId const to)
+{
+    for (PortIndex outPort = 0; outPort < GraphModel::PortsPerNode; ++outPort) {
+        ConnectionId const connectionId{from, outPort, to, 0};
+
+        if (model.connectionPossible(connectionId)) {
+            model.addConnection(connectionId);
+            return;
+        }
+    }
+
+    FAIL("No free port");
+}
+
+/// Disconnects one of the connections between the nodes.
+void disconnect(GraphModel &model, NodeId const from, NodeId const to)
+{
+    for (ConnectionId const &connectionId : model.allConnectionIds(from)) {
+        if (connectionId.outNodeId == from && connectionId.inNodeId == to) {
+            model.deleteConnection(connectionId);
+            return;
+        }
+    }
+
+    FAIL("No connection");
+}
+
+std::vector<ConnectionId> allConnections(GraphModel const &model)
+{
+    std::vector<ConnectionId> result;
+
+    for (NodeId const nodeId : model.allNodeIds()) {
+        for (ConnectionId const &connectionId : model.allConnectionIds(nodeId)) {
+            if (connectionId.outNodeId == nodeId)
+                result.push_back(connectionId);
+        }
+    }
+
+    return result;
+}
+
+/// Nodes reachable from `nodeId`, sorted, following the connections backwards
+/// for `downstream == false`.
+std::vector<NodeId> bruteForceCone(GraphModel const &model, NodeId const nodeId, bool downstream)
+{
+    std::vector<ConnectionId> const connections = allConnections(model);
+
+    std::set<NodeId> seen;
+    std::vector<NodeId> stack{nodeId};
+
+    while (!stack.empty()) {
+        NodeId const current = stack.back();
+        stack.pop_back();
+
+        for (ConnectionId const &connectionId : connections) {
+            NodeId const from = downstream ? connectionId.outNodeId : connectionId.inNodeId;
+            NodeId const to = downstream ? connectionId.inNodeId : connectionId.outNodeId;
+
+            if (from == current && seen.insert(to).second)
+                stack.push_back(to);
+        }
+    }
+
+    return std::vector<NodeId>(seen.begin(), seen.end());
+}
+
+/// Connected components ignoring the directions, as sorted sets.
+std::set<std::vector<NodeId>> bruteForceComponents(GraphModel const &model)
+{
+    std::set<std::vector<NodeId>> result;
+    std::set<NodeId> done;
+
+    for (NodeId const nodeId : model.allNodeIds()) {
+        if (done.count(nodeId))
+            continue;
+
+        std::set<NodeId> component{nodeId};
+        std::vector<NodeId> stack{nodeId};
+
+        while (!stack.empty()) {
+            NodeId const current = stack.back();
+            stack.pop_back();
+
+            for (ConnectionId const &connectionId : model.allConnectionIds(current)) {
+                for (NodeId const next : {connectionId.outNodeId, connectionId.inNodeId}) {
+                    if (component.insert(next).second)
+                        stack.push_back(next);
+                }
+            }
+        }
+
+        done.insert(component.begin(), component.end());
+        result.insert(std::vector<NodeId>(component.begin(), component.end()));
+    }
+
+    return result;
+}
+
+std::set<std::vector<NodeId>> sorted(std::vector<std::vector<NodeId>> groups)
+{
+    std::set<std::vector<NodeId>> result;
+
+    for (auto &group : groups) {
+        std::sort(group.begin(), group.end());
+        result.insert(group);
+    }
+
+    return result;
+}
+
+bool isOnCycle(GraphModel const &model, NodeId const nodeId)
+{
+    auto const down = bruteForceCone(model, nodeId, true);
+    return std::binary_search(down.begin(), down.end(), nodeId);
+}
+
+} // namespace
+
+TEST_CASE("GraphAnalysis follows cycles as they appear and vanish", "[analysis]")
+{
+    GraphModel model;
+    GraphAnalysis analysis(model);
+
+    NodeId const a = model.addNode();
+    NodeId const b = model.addNode();
+    NodeId const c = model.addNode();
+
+    connect(model, a, b);
+    connect(model, b, c);
+
+    REQUIRE(analysis.isAcyclic());
+    CHECK(analysis.topologicalOrder() == (std::vector<NodeId>{a, b, c}));
+    CHECK(analysis.depth(c) == 2);
+
+    SECTION("edge agreeing with the order")
+    {
+        connect(model, a, c);
+
+        CHECK(analysis.isAcyclic());
+        CHECK(analysis.topologicalOrder() == (std::vector<NodeId>{a, b, c}));
+        CHECK(analysis.depth(c) == 2);
+    }
+    SECTION("back edge")
+    {
+        connect(model, c, a);
+
+        CHECK_FALSE(analysis.isAcyclic());
+        CHECK(analysis.isOnCycle(b));
+        CHECK(analysis.upstream(a) == (std::vector<NodeId>{a, b, c}));
+        CHECK(analysis.stronglyConnectedComponents().size() == 1);
+
+        // A second connection along the cycle keeps it.
+        connect(model, c, a);
+        disconnect(model, c, a);
+        CHECK_FALSE(analysis.isAcyclic());
+
+        disconnect(model, b, c);
+        CHECK(analysis.isAcyclic());
+        CHECK(analysis.topologicalOrder() == (std::vector<NodeId>{c, a, b}));
+        CHECK_FALSE(analysis.reaches(b, c));
+    }
+    SECTION("self loop")
+    {
+        connect(model, b, b);
+
+        CHECK_FALSE(analysis.isAcyclic());
+        CHECK(analysis.isOnCycle(b));
+        CHECK_FALSE(analysis.isOnCycle(a));
+        CHECK(analysis.downstream(b) == (std::vector<NodeId>{b, c}));
+    }
+}
+
+TEST_CASE("GraphAnalysis merges and splits the connected components", "[analysis]")
+{
+    GraphModel model;
+    GraphAnalysis analysis(model);
+
+    NodeId const a = model.addNode();
+    NodeId const b = model.addNode();
+    NodeId const c = model.addNode();
+    NodeId const d = model.addNode();
+
+    CHECK(analysis.componentCount() == 4);
+
+    connect(model, a, b);
+    connect(model, d, c);
+    CHECK(analysis.componentCount() == 2);
+    CHECK(analysis.component(a) == analysis.component(b));
+    CHECK(analysis.component(a) != analysis.component(c));
+
+    connect(model, c, b);
+    CHECK(analysis.componentCount() == 1);
+    CHECK(analysis.component(a) == analysis.component(d));
+
+    disconnect(model, c, b);
+    CHECK(analysis.componentCount() == 2);
+    CHECK(analysis.component(a) != analysis.component(d));
+
+    model.deleteNode(b);
+    CHECK(analysis.componentCount() == 2);
+    CHECK(analysis.component(b) == QtNodes::InvalidNodeId);
+
+    model.clear();
+    CHECK(analysis.componentCount() == 0);
+    CHECK(analysis.isAcyclic());
+}
+
+TEST_CASE("GraphAnalysis matches a brute force after random edits", "[analysis]")
+{
+    std::mt19937 random(11);
+
+    for (int round = 0; round < 20; ++round) {
+        GraphModel model;
+        GraphAnalysis analysis(model);
+
+        std::vector<NodeId> nodes;
+
+        for (int step = 0; step < 200; ++step) {
+            unsigned int const operation = random() % 10;
+
+            if (operation < 2 || nodes.size() < 2) {
+                nodes.push_back(model.addNode());
+            } else if (operation < 3) {
+                std::size_t const index = random() % nodes.size();
+
+                model.deleteNode(nodes[index]);
+                nodes.erase(nodes.begin() + index);
+            } else if (operation < 7) {
+                NodeId const from = nodes[random() % nodes.size()];
+                NodeId const to = nodes[random() % nodes.size()];
+
+                // Keep the self loops rare.
+                if (from != to || random() % 4 == 0)
+                    connect(model, from, to);
+            } else if (operation < 9) {
+                std::vector<ConnectionId> const connections = allConnections(model);
+
+                if (!connections.empty())
+                    model.deleteConnection(connections[random() % connections.size()]);
+            } else if (random() % 10 == 0) {
+                model.clear();
+                nodes.clear();
+            }
+
+            if (nodes.empty())
+                continue;
+
+            NodeId const x = nodes[random() % nodes.size()];
+            NodeId const y = nodes[random() % nodes.size()];
+
+            std::vector<NodeId> const down = bruteForceCone(model, x, true);
+
+            switch (random() % 4) {
+            case 0:
+                REQUIRE(analysis.downstream(x) == down);
+                REQUIRE(analysis.upstream(x) == bruteForceCone(model, x, false));
+                break;
+
+            case 1:
+                REQUIRE(analysis.reaches(x, y) == std::binary_search(down.begin(), down.end(), y));
+                REQUIRE(analysis.isOnCycle(x) == isOnCycle(model, x));
+                break;
+
+            case 2: {
+                std::vector<NodeId> const order = analysis.topologicalOrder();
+                REQUIRE(order.size() == nodes.size());
+
+                bool acyclic = true;
+                for (NodeId const nodeId : nodes)
+                    acyclic = acyclic && !isOnCycle(model, nodeId);
+
+                REQUIRE(analysis.isAcyclic() == acyclic);
+
+                // Every connection leaving a cycle goes forward.
+                for (ConnectionId const &connectionId : allConnections(model)) {
+                    auto const back = bruteForceCone(model, connectionId.inNodeId, true);
+                    if (std::binary_search(back.begin(), back.end(), connectionId.outNodeId))
+                        continue;
+
+                    auto const from = std::find(order.begin(), order.end(), connectionId.outNodeId);
+                    auto const to = std::find(order.begin(), order.end(), connectionId.inNodeId);
+
+                    REQUIRE(from < to);
+                    REQUIRE(analysis.depth(connectionId.inNodeId)
+                            > analysis.depth(connectionId.outNodeId));
+                }
+            } break;
+
+            case 3: {
+                auto const components = bruteForceComponents(model);
+
+                REQUIRE(analysis.componentCount() == components.size());
+                REQUIRE(sorted(analysis.components()) == components);
+            } break;
+            }
+        }
+    }
+}
@@ -0,0 +1,144 @@
+#include "ApplicationSetup.hpp"
+#include "TestDelegateModels.hpp"
+
+#include <QtNodes/DataFlowGraphModel>
+#include <QtNodes/GraphSnapshot>
+
+#include <catch2/catch.hpp>
+
+#include <QtCore/QCoreApplication>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using QtNodes::ConnectionId;
+using QtNodes::DataFlowGraphModel;
+using QtNodes::GraphSnapshot;
+using QtNodes::NodeId;
+using QtNodes::NodeRole;
+using QtNodes::SnapshotNode;
+
+TEST_CASE("GraphSnapshot copy-on-write", "[snapshot]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(registerTestModels());
+
+    CHECK(model.snapshot()->version() == 0);
+    CHECK(model.snapshot()->nodeCount() == 0);
+
+    // Two chunks of nodes.
+    std::vector<NodeId> nodeIds;
+    for (std::size_t i = 0; i < GraphSnapshot::ChunkSize + 10; ++i) {
+        nodeIds.push_back(model.addNode(SumModel::Name()));
+    }
+
+    NodeId const first = nodeIds.front();
+    NodeId const last = nodeIds.back();
+
+    model.addConnection(ConnectionId{first, 0, last, 0});
+
+    model.setSnapshotsEnabled(true);
+
+    std::shared_ptr<GraphSnapshot const> const before = model.snapshot();
+
+    REQUIRE(before->version() == 1);
+    CHECK(before->nodeCount() == nodeIds.size());
+    CHECK(before->connectionCount() == 1);
+    CHECK(before->connections(last) == std::vector<ConnectionId>{ConnectionId{first, 0, last, 0}});
+
+    SnapshotNode const *lastBefore = before->node(last);
+    REQUIRE(lastBefore);
+    CHECK(lastBefore->type == SumModel::Name());
+    CHECK(lastBefore->inPortCount == 2);
+    CHECK(lastBefore->outPortCount == 1);
+
+    SECTION("only the edited chunk is rebuilt")
+    {
+        model.setNodeData(last, NodeRole::Position, QPointF(40.0, 50.0));
+        model.publishSnapshot();
+
+        std::shared_ptr<GraphSnapshot const> const after = model.snapshot();
+
+        CHECK(after->version() == 2);
+        CHECK(after->node(last)->position == QPointF(40.0, 50.0));
+
+        // The published snapshot never changes.
+        CHECK(before->node(last)->position == QPointF());
+
+        // The first chunk is shared.
+        CHECK(after->node(first) == before->node(first));
+        CHECK(after->node(last) != lastBefore);
+    }
+
+    SECTION("deleted nodes and stale ids")
+    {
+        model.deleteNode(last);
+        model.publishSnapshot();
+
+        std::shared_ptr<GraphSnapshot const> const after = model.snapshot();
+
+        CHECK_FALSE(after->contains(last));
+        CHECK(after->connections(first).empty());
+        CHECK(after->nodeCount() == nodeIds.size() - 1);
+        CHECK(after->connectionCount() == 0);
+
+        // The slot is reused under a new generation.
+        NodeId const reused = model.addNode(SourceModel::Name());
+        model.publishSnapshot();
+
+        CHECK(model.snapshot()->contains(reused));
+        CHECK_FALSE(model.snapshot()->contains(last));
+        CHECK(before->contains(last));
+    }
+
+    SECTION("one snapshot per batch of edits")
+    {
+        int published = 0;
+        QObject::connect(&model, &DataFlowGraphModel::snapshotPublished, [&published](quint64) {
+            ++published;
+        });
+
+        for (NodeId const nodeId : nodeIds) {
+            model.setNodeData(nodeId, NodeRole::Position, QPointF(1.0, 1.0));
+        }
+
+        CHECK(published == 0);
+
+        QCoreApplication::processEvents();
+
+        CHECK(published == 1);
+        CHECK(model.snapshot()->version() == 2);
+    }
+
+    SECTION("read on other threads while the model changes")
+    {
+        std::atomic<bool> stop{false};
+        std::atomic<bool> consistent{true};
+
+        std::thread reader([&]() {
+            while (!stop) {
+                std::shared_ptr<GraphSnapshot const> const snapshot = model.snapshot();
+
+                std::size_t nodes = 0;
+                snapshot->forEachNode([&nodes](SnapshotNode const &) { ++nodes; });
+
+                if (nodes != snapshot->nodeCount())
+                    consistent = false;
+            }
+        });
+
+        for (int i = 0; i < 100; ++i) {
+            model.deleteNode(model.addNode(SumModel::Name()));
+            model.publishSnapshot();
+        }
+
+        stop = true;
+        reader.join();
+
+        CHECK(consistent);
+        CHECK(model.snapshot()->version() == 101);
+    }
+}
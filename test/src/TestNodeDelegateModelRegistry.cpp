@@ -0,0 +1,256 @@
+#include <QtNodes/DataFlowGraphModel>
+#include <QtNodes/NodeDelegateModelRegistry>
+
+#include <catch2/catch.hpp>
+
+#include <memory>
+#include <vector>
+
+#include "TestDelegateModels.hpp"
+
+using QtNodes::ConnectionId;
+using QtNodes::DataFlowGraphModel;
+using QtNodes::InvalidModelTypeId;
+using QtNodes::ModelDescriptor;
+using QtNodes::ModelTypeId;
+using QtNodes::NodeData;
+using QtNodes::NodeDataType;
+using QtNodes::NodeDelegateModel;
+using QtNodes::NodeDelegateModelRegistry;
+using QtNodes::NodeId;
+using QtNodes::PortIndex;
+using QtNodes::PortType;
+
+namespace {
+
+/// Counts the instances, the registry must not create any to learn the name.
+class CountedModel : public SourceModel
+{
+public:
+    CountedModel() { ++Instances; }
+
+    static QString Name() { return "Counted"; }
+
+    static QString Caption() { return "Counted caption"; }
+
+    QString name() const override { return Name(); }
+
+    QString caption() const override { return Caption(); }
+
+    static int Instances;
+};
+
+int CountedModel::Instances = 0;
+
+/// No static `Name()`, the registry has to ask an instance.
+class InstanceNamedModel : public NodeDelegateModel
+{
+public:
+    QString name() const override { return "InstanceNamed"; }
+
+    QString caption() const override { return "Instance named"; }
+
+    unsigned int nPorts(PortType portType) const override
+    {
+        return portType == PortType::In ? 2 : 1;
+    }
+
+    NodeDataType dataType(PortType, PortIndex) const override
+    {
+        return NodeDataType{"number", "Number"};
+    }
+
+    std::shared_ptr<NodeData> outData(PortIndex const) override { return nullptr; }
+
+    void setInData(std::shared_ptr<NodeData>, PortIndex const) override {}
+
+    QWidget *embeddedWidget() override { return nullptr; }
+};
+
+} // namespace
+
+TEST_CASE("NodeDelegateModelRegistry descriptors", "[registry]")
+{
+    NodeDelegateModelRegistry registry;
+
+    CountedModel::Instances = 0;
+
+    ModelTypeId const countedId = registry.registerModel<CountedModel>("Sources");
+    ModelTypeId const instanceId = registry.registerModel<InstanceNamedModel>();
+
+    SECTION("ids in the order of registration")
+    {
+        CHECK(countedId == 0);
+        CHECK(instanceId == 1);
+
+        CHECK(registry.modelTypeId("Counted") == countedId);
+        CHECK(registry.modelTypeId("InstanceNamed") == instanceId);
+        CHECK(registry.modelTypeId("Unknown") == InvalidModelTypeId);
+
+        REQUIRE(registry.descriptors().size() == 2);
+        CHECK(registry.descriptors()[1].id == instanceId);
+    }
+
+    SECTION("static name")
+    {
+        CHECK(CountedModel::Instances == 0);
+
+        ModelDescriptor const *descriptor = registry.descriptor(countedId);
+        REQUIRE(descriptor);
+
+        CHECK(descriptor->name == "Counted");
+        CHECK(descriptor->caption == "Counted caption");
+        CHECK(descriptor->category == "Sources");
+        CHECK(descriptor->inPortTypes.empty());
+
+        CHECK(registry.categories().count("Sources") == 1);
+        CHECK(registry.registeredModelsCategoryAssociation().at("Counted") == "Sources");
+    }
+
+    SECTION("instance name")
+    {
+        ModelDescriptor const *descriptor = registry.descriptor(instanceId);
+        REQUIRE(descriptor);
+
+        CHECK(descriptor->name == "InstanceNamed");
+        CHECK(descriptor->caption == "Instance named");
+        CHECK(descriptor->category == "Nodes");
+        CHECK(descriptor->inPortTypes.size() == 2);
+        REQUIRE(descriptor->outPortTypes.size() == 1);
+        CHECK(descriptor->outPortTypes[0].id == "number");
+    }
+
+    SECTION("explicit descriptor")
+    {
+        ModelDescriptor descriptor;
+        descriptor.name = "Described";
+        descriptor.category = "Custom";
+        descriptor.outPortTypes.push_back(NodeDataType{"text", "Text"});
+
+        int created = 0;
+
+        ModelTypeId const id = registry.registerModel(descriptor, [&created]() {
+            ++created;
+            return std::make_unique<CountedModel>();
+        });
+
+        CHECK(created == 0);
+        CHECK(id == 2);
+        CHECK(registry.descriptor(id)->outPortTypes[0].id == "text");
+
+        CHECK(registry.create(id) != nullptr);
+        CHECK(created == 1);
+    }
+
+    SECTION("the earlier registration wins")
+    {
+        ModelDescriptor duplicate;
+        duplicate.name = "Counted";
+        duplicate.category = "Other";
+
+        CHECK(registry.registerModel(duplicate, []() { return std::make_unique<CountedModel>(); })
+              == countedId);
+        CHECK(registry.descriptor(countedId)->category == "Sources");
+        CHECK(registry.descriptors().size() == 2);
+    }
+
+    SECTION("creation")
+    {
+        std::unique_ptr<NodeDelegateModel> byId = registry.create(countedId);
+        std::unique_ptr<NodeDelegateModel> byName = registry.create("InstanceNamed");
+
+        REQUIRE(byId);
+        REQUIRE(byName);
+
+        CHECK(byId->modelTypeId() == countedId);
+        CHECK(byName->modelTypeId() == instanceId);
+
+        CHECK(registry.create("Unknown") == nullptr);
+        CHECK(registry.create(InvalidModelTypeId) == nullptr);
+        CHECK(registry.descriptor(InvalidModelTypeId) == nullptr);
+    }
+}
+
+TEST_CASE("NodeDelegateModelRegistry pools the released models", "[registry]")
+{
+    std::shared_ptr<NodeDelegateModelRegistry> registry = registerTestModels();
+
+    DataFlowGraphModel model(registry);
+
+    NodeId const source = model.addNode(SourceModel::Name());
+    NodeId const sum = model.addNode(SumModel::Name());
+
+    model.addConnection(ConnectionId{source, 0, sum, 0});
+    model.delegateModel<SourceModel>(source)->setValue(2.0);
+
+    SumModel *released = model.delegateModel<SumModel>(sum);
+    REQUIRE(released->setInDataCalls(0) == 2);
+
+    SECTION("disabled by default")
+    {
+        CHECK(registry->poolCapacity() == 0);
+
+        model.deleteNode(sum);
+
+        CHECK(registry->pooledModelCount() == 0);
+    }
+
+    SECTION("reused after a reset")
+    {
+        registry->setPoolCapacity(2);
+
+        model.deleteNode(sum);
+
+        CHECK(registry->pooledModelCount() == 1);
+
+        NodeId const reused = model.addNode(SumModel::Name());
+
+        CHECK(registry->pooledModelCount() == 0);
+        REQUIRE(model.delegateModel<SumModel>(reused) == released);
+        CHECK(released->setInDataCalls(0) == 0);
+        CHECK(released->sum() == 0.0);
+
+        // Only the new node's connections are served.
+        model.addConnection(ConnectionId{source, 0, reused, 1});
+        model.delegateModel<SourceModel>(source)->setValue(5.0);
+
+        CHECK(released->sum() == 5.0);
+        CHECK(released->setInDataCalls(0) == 0);
+        CHECK(released->setInDataCalls(1) == 2);
+    }
+
+    SECTION("models without reset are deleted")
+    {
+        registry->setPoolCapacity(2);
+
+        model.deleteNode(source);
+
+        CHECK(registry->pooledModelCount() == 0);
+    }
+
+    SECTION("capacity")
+    {
+        registry->setPoolCapacity(2);
+
+        for (int i = 0; i < 3; ++i) {
+            model.deleteNode(model.addNode(SumModel::Name()));
+            model.addNode(SumModel::Name());
+        }
+
+        std::vector<NodeId> sums;
+        for (NodeId const nodeId : model.allNodeIds()) {
+            if (model.delegateModel<SumModel>(nodeId))
+                sums.push_back(nodeId);
+        }
+
+        model.deleteNodes(sums);
+
+        CHECK(registry->pooledModelCount() == 2);
+
+        registry->setPoolCapacity(1);
+        CHECK(registry->pooledModelCount() == 1);
+
+        registry->clearPools();
+        CHECK(registry->pooledModelCount() == 0);
+    }
+}
@@ -0,0 +1,126 @@
+#include <QtNodes/internal/NodeSlots.hpp>
+#include <QtNodes/SlotAllocator>
+
+#include <catch2/catch.hpp>
+
+#include <set>
+#include <stdexcept>
+
+using QtNodes::InvalidNodeId;
+using QtNodes::NodeId;
+using QtNodes::NodeSlots;
+using QtNodes::SlotAllocator;
+
+TEST_CASE("NodeSlots resolves only the current id of a slot", "[slots]")
+{
+    NodeSlots nodes;
+
+    NodeId const first = nodes.reserve();
+    nodes.insert(first, nullptr);
+
+    REQUIRE(nodes.contains(first));
+    CHECK(nodes.count() == 1);
+
+    nodes.setPosition(first, QPointF(1.0, 2.0));
+    nodes.setSize(first, QSize(3, 4));
+
+    nodes.erase(first);
+
+    CHECK_FALSE(nodes.contains(first));
+    CHECK(nodes.count() == 0);
+    CHECK_FALSE(nodes.setPosition(first, QPointF(5.0, 6.0)));
+
+    NodeId const second = nodes.reserve();
+    nodes.insert(second, nullptr);
+
+    // The slot is reused under a new generation, the values start over.
+    CHECK(SlotAllocator::slotIndex(second) == SlotAllocator::slotIndex(first));
+    CHECK(second != first);
+    CHECK_FALSE(nodes.contains(first));
+    CHECK(nodes.position(second) == QPointF());
+    CHECK(nodes.size(second) == QSize());
+}
+
+TEST_CASE("NodeSlots generation wraps around", "[slots]")
+{
+    NodeSlots nodes;
+
+    NodeId const original = nodes.reserve();
+    nodes.insert(original, nullptr);
+
+    NodeId nodeId = original;
+    std::set<NodeId> seen{original};
+
+    for (unsigned int i = 1; i < (1u << SlotAllocator::GenerationBits); ++i) {
+        nodes.erase(nodeId);
+
+        nodeId = nodes.reserve();
+        nodes.insert(nodeId, nullptr);
+
+        CHECK(SlotAllocator::slotIndex(nodeId) == 0);
+        CHECK(seen.insert(nodeId).second);
+    }
+
+    // After 128 generations the slot hands out the very first id again.
+    nodes.erase(nodeId);
+    CHECK(nodes.reserve() == original);
+}
+
+TEST_CASE("NodeSlots restores saved ids", "[slots]")
+{
+    NodeSlots nodes;
+
+    SECTION("free slot adopts the generation")
+    {
+        NodeId const saved = SlotAllocator::makeNodeId(3, 9);
+
+        nodes.insert(saved, nullptr);
+
+        CHECK(nodes.contains(saved));
+        CHECK(nodes.nodeIds() == std::vector<NodeId>{saved});
+
+        // The lower slots grown along stay free and are handed out first.
+        CHECK(SlotAllocator::slotIndex(nodes.reserve()) == 0);
+    }
+    SECTION("id in use")
+    {
+        NodeId const nodeId = nodes.reserve();
+        nodes.insert(nodeId, nullptr);
+
+        CHECK_THROWS_AS(nodes.insert(nodeId, nullptr), std::logic_error);
+    }
+    SECTION("slot reserved for another generation")
+    {
+        NodeId const reserved = nodes.reserve();
+
+        NodeId const other = SlotAllocator::makeNodeId(SlotAllocator::slotIndex(reserved),
+                                                       SlotAllocator::generation(reserved) + 1);
+
+        CHECK_THROWS_AS(nodes.insert(other, nullptr), std::logic_error);
+    }
+    SECTION("ill-formed id")
+    {
+        CHECK_THROWS_AS(nodes.insert(NodeId(1) << 31, nullptr), std::logic_error);
+    }
+}
+
+TEST_CASE("NodeSlots clear invalidates every id", "[slots]")
+{
+    NodeSlots nodes;
+
+    NodeId const a = nodes.reserve();
+    NodeId const b = nodes.reserve();
+    nodes.insert(a, nullptr);
+    nodes.insert(b, nullptr);
+
+    nodes.clear();
+
+    CHECK(nodes.count() == 0);
+    CHECK_FALSE(nodes.contains(a));
+    CHECK_FALSE(nodes.contains(b));
+    CHECK(nodes.nodeIds().empty());
+
+    NodeId const c = nodes.reserve();
+    CHECK(c != a);
+    CHECK(SlotAllocator::slotIndex(c) == 0);
+}
@@ -0,0 +1,105 @@
+#include <QtNodes/DataFlowGraphModel>
+
+#include <catch2/catch.hpp>
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
+#include <QtCore/QThread>
+
+#include <stdexcept>
+#include <unordered_set>
+
+#include "TestDelegateModels.hpp"
+
+using QtNodes::ConnectionId;
+using QtNodes::DataFlowGraphModel;
+using QtNodes::NodeId;
+
+namespace {
+
+/// Sources feeding both ports of a sum each, saved by a serially built model.
+QJsonObject makeScene(int const nSums)
+{
+    DataFlowGraphModel model(registerTestModels());
+
+    for (int i = 0; i < nSums; ++i) {
+        NodeId const source = model.addNode(SourceModel::Name());
+        NodeId const sum = model.addNode(SumModel::Name());
+
+        model.delegateModel<SourceModel>(source)->setValue(i);
+
+        model.addConnection(ConnectionId{source, 0, sum, 0});
+        model.addConnection(ConnectionId{source, 0, sum, 1});
+    }
+
+    return model.save();
+}
+
+} // namespace
+
+TEST_CASE("DataFlowGraphModel loads the nodes in parallel", "[load]")
+{
+    QJsonObject const scene = makeScene(64);
+
+    DataFlowGraphModel model(registerTestModels());
+    model.setParallelLoadEnabled(true);
+
+    model.load(scene);
+
+    SECTION("same nodes and connections")
+    {
+        DataFlowGraphModel serial(registerTestModels());
+        serial.load(scene);
+
+        CHECK(model.allNodeIds() == serial.allNodeIds());
+
+        for (NodeId const nodeId : serial.allNodeIds()) {
+            CHECK(model.allConnectionIds(nodeId) == serial.allConnectionIds(nodeId));
+        }
+    }
+
+    SECTION("decoded on the worker threads")
+    {
+        for (NodeId const nodeId : model.allNodeIds()) {
+            if (auto source = model.delegateModel<SourceModel>(nodeId)) {
+                REQUIRE(source->preloadThread() != nullptr);
+                CHECK(source->preloadThread() != QThread::currentThread());
+            }
+        }
+    }
+
+    SECTION("data propagated after the installation")
+    {
+        std::unordered_set<double> sums;
+
+        for (NodeId const nodeId : model.allNodeIds()) {
+            if (auto sum = model.delegateModel<SumModel>(nodeId))
+                sums.insert(sum->sum());
+        }
+
+        for (int i = 0; i < 64; ++i) {
+            CHECK(sums.count(2.0 * i) == 1);
+        }
+    }
+}
+
+TEST_CASE("DataFlowGraphModel parallel load of an unknown model", "[load]")
+{
+    QJsonObject scene = makeScene(4);
+
+    QJsonArray nodes = scene["nodes"].toArray();
+    QJsonObject node = nodes[0].toObject();
+    QJsonObject internalData = node["internal-data"].toObject();
+    internalData["model-name"] = "Unknown";
+    node["internal-data"] = internalData;
+    nodes[0] = node;
+    scene["nodes"] = nodes;
+
+    DataFlowGraphModel model(registerTestModels());
+    model.setParallelLoadEnabled(true);
+
+    CHECK_THROWS_AS(model.load(scene), std::logic_error);
+
+    // The models are created before any node is installed.
+    CHECK(model.allNodeIds().empty());
+}
@@ -0,0 +1,194 @@
+#include <QtNodes/PortGrid>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using QtNodes::NodeId;
+using QtNodes::PortGrid;
+using QtNodes::PortLocation;
+using QtNodes::PortType;
+
+namespace {
+
+PortLocation port(NodeId nodeId, unsigned int portIndex, double x, double y)
+{
+    return PortLocation{nodeId, PortType::In, portIndex, QPointF(x, y)};
+}
+
+/// Linear scan over the same ports, the reference for `PortGrid::nearest`.
+PortLocation const *bruteForceNearest(std::vector<PortLocation> const &ports,
+                                      QPointF const &scenePos,
+                                      double radius)
+{
+    PortLocation const *result = nullptr;
+    double bestDistance = radius * radius;
+
+    for (PortLocation const &candidate : ports) {
+        QPointF const diff = candidate.scenePos - scenePos;
+        double const distance = QPointF::dotProduct(diff, diff);
+
+        if (distance <= bestDistance) {
+            bestDistance = distance;
+            result = &candidate;
+        }
+    }
+
+    return result;
+}
+
+double distance(PortLocation const *port, QPointF const &scenePos)
+{
+    QPointF const diff = port->scenePos - scenePos;
+    return std::sqrt(QPointF::dotProduct(diff, diff));
+}
+
+} // namespace
+
+TEST_CASE("PortGrid finds ports across cell boundaries", "[portgrid]")
+{
+    PortGrid grid(10.0);
+
+    SECTION("empty grid")
+    {
+        CHECK(grid.nearest(QPointF(0, 0), 10.0) == nullptr);
+    }
+    SECTION("neighbouring cell")
+    {
+        grid.insert(port(1, 0, 10.5, 0.0));
+
+        PortLocation const *found = grid.nearest(QPointF(9.5, 0.0), 2.0);
+        REQUIRE(found != nullptr);
+        CHECK(found->nodeId == 1);
+    }
+    SECTION("negative coordinates")
+    {
+        grid.insert(port(1, 0, -0.5, -0.5));
+        grid.insert(port(2, 0, 9.0, 9.0));
+
+        PortLocation const *found = grid.nearest(QPointF(0.5, 0.5), 2.0);
+        REQUIRE(found != nullptr);
+        CHECK(found->nodeId == 1);
+
+        found = grid.nearest(QPointF(-10.5, -10.5), 10.0);
+        CHECK(found == nullptr);
+    }
+    SECTION("diagonal cell")
+    {
+        grid.insert(port(1, 0, 19.9, 19.9));
+
+        PortLocation const *found = grid.nearest(QPointF(20.1, 20.1), 1.0);
+        REQUIRE(found != nullptr);
+        CHECK(found->nodeId == 1);
+    }
+    SECTION("port exactly on the radius")
+    {
+        grid.insert(port(1, 0, 5.0, 0.0));
+
+        CHECK(grid.nearest(QPointF(0.0, 0.0), 5.0) != nullptr);
+        CHECK(grid.nearest(QPointF(0.0, 0.0), 4.9) == nullptr);
+    }
+    SECTION("radius is clamped to the cell size")
+    {
+        grid.insert(port(1, 0, 25.0, 0.0));
+
+        CHECK(grid.nearest(QPointF(0.0, 0.0), 100.0) == nullptr);
+    }
+}
+
+TEST_CASE("PortGrid replaces the ports of one node", "[portgrid]")
+{
+    PortGrid grid(10.0);
+
+    grid.insert(port(1, 0, 0.0, 0.0));
+    grid.insert(port(1, 1, 0.0, 15.0));
+    grid.insert(port(2, 0, 3.0, 0.0));
+
+    CHECK(grid.size() == 3);
+    CHECK(grid.contains(1));
+
+    grid.removeNode(1);
+
+    CHECK(grid.size() == 1);
+    CHECK_FALSE(grid.contains(1));
+    CHECK(grid.nodeIds() == std::vector<NodeId>{2});
+
+    PortLocation const *found = grid.nearest(QPointF(0.0, 0.0), 5.0);
+    REQUIRE(found != nullptr);
+    CHECK(found->nodeId == 2);
+
+    CHECK(grid.nearest(QPointF(0.0, 15.0), 5.0) == nullptr);
+
+    // Moved node.
+    grid.insert(port(1, 0, -1.0, 0.0));
+
+    found = grid.nearest(QPointF(0.0, 0.0), 5.0);
+    REQUIRE(found != nullptr);
+    CHECK(found->nodeId == 1);
+
+    grid.removeNode(42);
+    CHECK(grid.size() == 2);
+
+    grid.clear();
+    CHECK(grid.empty());
+    CHECK(grid.nearest(QPointF(0.0, 0.0), 5.0) == nullptr);
+}
+
+TEST_CASE("PortGrid matches a linear scan", "[portgrid]")
+{
+    std::mt19937 random(7);
+    std::uniform_real_distribution<double> coordinate(-100.0, 100.0);
+
+    PortGrid grid(10.0);
+    std::vector<PortLocation> ports;
+
+    for (NodeId nodeId = 0; nodeId < 50; ++nodeId) {
+        for (unsigned int i = 0; i < 4; ++i) {
+            PortLocation const location = port(nodeId, i, coordinate(random), coordinate(random));
+
+            grid.insert(location);
+            ports.push_back(location);
+        }
+    }
+
+    auto compare = [&](double radius) {
+        for (int i = 0; i < 500; ++i) {
+            QPointF const scenePos(coordinate(random), coordinate(random));
+
+            PortLocation const *expected = bruteForceNearest(ports, scenePos, radius);
+            PortLocation const *found = grid.nearest(scenePos, radius);
+
+            REQUIRE((found == nullptr) == (expected == nullptr));
+
+            if (found)
+                CHECK(distance(found, scenePos) == Approx(distance(expected, scenePos)));
+        }
+    };
+
+    compare(10.0);
+
+    SECTION("after removing nodes")
+    {
+        for (NodeId nodeId = 0; nodeId < 50; nodeId += 3)
+            grid.removeNode(nodeId);
+
+        ports.erase(std::remove_if(ports.begin(),
+                                   ports.end(),
+                                   [](PortLocation const &p) { return p.nodeId % 3 == 0; }),
+                    ports.end());
+
+        CHECK(grid.size() == ports.size());
+        compare(10.0);
+    }
+    SECTION("after changing the cell size")
+    {
+        grid.setCellSize(25.0);
+        compare(25.0);
+
+        grid.setCellSize(3.0);
+        compare(3.0);
+    }
+}
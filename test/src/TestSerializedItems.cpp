@@ -0,0 +1,147 @@
+#include <QtNodes/internal/SerializedItems.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+#include <vector>
+
+using QtNodes::ConnectionId;
+using QtNodes::NodeId;
+using QtNodes::SerializedItems;
+using QtNodes::SerializedNode;
+
+namespace {
+
+SerializedItems makeItems()
+{
+    SerializedItems items;
+
+    QJsonObject internalData;
+    internalData["model-name"] = "Source";
+    internalData["value"] = 2.5;
+    internalData["tags"] = QJsonArray{"a", "b"};
+
+    QJsonObject nodeJson;
+    nodeJson["internal-data"] = internalData;
+
+    // Above `INT_MAX`, the generation bits are set.
+    NodeId const largeId = 0x80000005u;
+
+    items.nodes.push_back(SerializedNode{1u, QPointF(10.0, -20.5), nodeJson});
+    items.nodes.push_back(SerializedNode{largeId, QPointF(0.25, 300.0), nodeJson});
+
+    items.connections.push_back(ConnectionId{1u, 0u, largeId, 1u});
+
+    return items;
+}
+
+void checkEqual(SerializedItems const &a, SerializedItems const &b)
+{
+    REQUIRE(a.nodes.size() == b.nodes.size());
+
+    for (std::size_t i = 0; i < a.nodes.size(); ++i) {
+        CHECK(a.nodes[i].id == b.nodes[i].id);
+        CHECK(a.nodes[i].position == b.nodes[i].position);
+        CHECK(a.nodes[i].json == b.nodes[i].json);
+    }
+
+    CHECK(a.connections == b.connections);
+}
+
+} // namespace
+
+TEST_CASE("SerializedItems binary round trip", "[clipboard]")
+{
+    SerializedItems const items = makeItems();
+
+    SerializedItems restored;
+    REQUIRE(SerializedItems::fromBinary(items.toBinary(), restored));
+
+    checkEqual(items, restored);
+
+    SECTION("empty items")
+    {
+        SerializedItems empty;
+        REQUIRE(SerializedItems::fromBinary(SerializedItems().toBinary(), empty));
+        CHECK(empty.empty());
+        CHECK(empty.connections.empty());
+    }
+}
+
+TEST_CASE("SerializedItems json round trip", "[clipboard]")
+{
+    SerializedItems const items = makeItems();
+
+    QJsonObject const json = items.toJson();
+
+    CHECK(json["nodes"].toArray().size() == 2);
+    CHECK(json["connections"].toArray().size() == 1);
+
+    checkEqual(items, SerializedItems::fromJson(json));
+}
+
+TEST_CASE("SerializedItems::fromBinary rejects other payloads", "[clipboard]")
+{
+    SerializedItems const items = makeItems();
+
+    SerializedItems untouched = makeItems();
+
+    SECTION("json text of the earlier versions")
+    {
+        QByteArray const text = QJsonDocument(items.toJson()).toJson();
+
+        CHECK_FALSE(SerializedItems::fromBinary(text, untouched));
+
+        // The paste falls back to the json parser for such payloads.
+        checkEqual(items, SerializedItems::fromJson(QJsonDocument::fromJson(text).object()));
+    }
+
+    SECTION("empty")
+    {
+        CHECK_FALSE(SerializedItems::fromBinary(QByteArray(), untouched));
+    }
+
+    SECTION("truncated")
+    {
+        QByteArray const binary = items.toBinary();
+
+        for (int size : {4, 7, binary.size() / 2, binary.size() - 1}) {
+            CHECK_FALSE(SerializedItems::fromBinary(binary.left(size), untouched));
+        }
+    }
+
+    SECTION("garbage node count")
+    {
+        QByteArray binary = items.toBinary();
+
+        // magic (4), version (2), encoding (1), then the node count.
+        binary[7] = static_cast<char>(0x7f);
+
+        CHECK_FALSE(SerializedItems::fromBinary(binary, untouched));
+    }
+
+    // Nothing is assigned on a failure.
+    checkEqual(items, untouched);
+}
+
+TEST_CASE("SerializedItems positions", "[clipboard]")
+{
+    SerializedItems items = makeItems();
+
+    CHECK(items.averagePosition() == QPointF(5.125, 139.75));
+
+    items.offset(QPointF(1.0, 2.0));
+
+    CHECK(items.nodes[0].position == QPointF(11.0, -18.5));
+    CHECK(items.nodes[1].position == QPointF(1.25, 302.0));
+
+    // The json is not touched, `toLoadableJson` writes the current values.
+    QJsonObject const loadable = items.nodes[1].toLoadableJson();
+
+    CHECK(loadable["position"].toObject()["x"].toDouble() == 1.25);
+    CHECK(static_cast<NodeId>(loadable["id"].toDouble()) == items.nodes[1].id);
+    CHECK_FALSE(items.nodes[1].json.contains("position"));
+}
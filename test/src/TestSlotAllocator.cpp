@@ -0,0 +1,181 @@
+#include <QtNodes/SlotAllocator>
+
+#include <catch2/catch.hpp>
+
+#include <set>
+#include <stdexcept>
+
+using QtNodes::InvalidNodeId;
+using QtNodes::NodeId;
+using QtNodes::SlotAllocator;
+
+TEST_CASE("SlotAllocator id layout", "[slots]")
+{
+    NodeId const nodeId = SlotAllocator::makeNodeId(5, 3);
+
+    CHECK(SlotAllocator::slotIndex(nodeId) == 5);
+    CHECK(SlotAllocator::generation(nodeId) == 3);
+    CHECK(SlotAllocator::isWellFormed(nodeId));
+
+    CHECK_FALSE(SlotAllocator::isWellFormed(InvalidNodeId));
+    CHECK_FALSE(SlotAllocator::isWellFormed(NodeId(1) << 31));
+}
+
+TEST_CASE("SlotAllocator reuses the freed slots under new ids", "[slots]")
+{
+    SlotAllocator slots;
+
+    NodeId const first = slots.reserve();
+    NodeId const second = slots.reserve();
+
+    // Reserved slots are not nodes yet.
+    CHECK_FALSE(slots.contains(first));
+
+    CHECK(slots.occupy(first) == 0);
+    CHECK(slots.occupy(second) == 1);
+    CHECK(slots.count() == 2);
+
+    REQUIRE(slots.release(first));
+    CHECK_FALSE(slots.contains(first));
+    CHECK_FALSE(slots.release(first));
+
+    NodeId const reused = slots.reserve();
+
+    CHECK(SlotAllocator::slotIndex(reused) == 0);
+    CHECK(reused != first);
+    CHECK(slots.nodeIdAt(0) == InvalidNodeId);
+}
+
+TEST_CASE("SlotAllocator generation wraps around", "[slots]")
+{
+    SlotAllocator slots;
+
+    NodeId const original = slots.reserve();
+    slots.occupy(original);
+
+    NodeId nodeId = original;
+    std::set<NodeId> seen{original};
+
+    for (unsigned int i = 1; i < (1u << SlotAllocator::GenerationBits); ++i) {
+        slots.release(nodeId);
+
+        nodeId = slots.reserve();
+        slots.occupy(nodeId);
+
+        CHECK(SlotAllocator::slotIndex(nodeId) == 0);
+        CHECK(seen.insert(nodeId).second);
+    }
+
+    // After 128 generations the slot hands out the very first id again.
+    slots.release(nodeId);
+    CHECK(slots.reserve() == original);
+}
+
+TEST_CASE("SlotAllocator restores saved ids", "[slots]")
+{
+    SlotAllocator slots;
+
+    SECTION("free slot adopts the generation")
+    {
+        NodeId const saved = SlotAllocator::makeNodeId(3, 9);
+
+        CHECK(slots.occupy(saved) == 3);
+        CHECK(slots.contains(saved));
+        CHECK(slots.slotCount() == 4);
+
+        // The lower slots grown along stay free and are handed out first.
+        CHECK(SlotAllocator::slotIndex(slots.reserve()) == 0);
+    }
+    SECTION("occupied slot")
+    {
+        NodeId const nodeId = slots.reserve();
+        slots.occupy(nodeId);
+
+        CHECK_THROWS_AS(slots.occupy(nodeId), std::logic_error);
+    }
+    SECTION("slot reserved for another generation")
+    {
+        NodeId const reserved = slots.reserve();
+
+        NodeId const other = SlotAllocator::makeNodeId(SlotAllocator::slotIndex(reserved),
+                                                       SlotAllocator::generation(reserved) + 1);
+
+        CHECK_THROWS_AS(slots.occupy(other), std::logic_error);
+    }
+    SECTION("ill-formed id")
+    {
+        CHECK_FALSE(slots.canOccupy(NodeId(1) << 31));
+        CHECK_THROWS_AS(slots.occupy(NodeId(1) << 31), std::logic_error);
+    }
+    SECTION("unused reservation")
+    {
+        NodeId const occupied = slots.reserve();
+        slots.occupy(occupied);
+
+        NodeId const reserved = slots.reserve();
+
+        CHECK_FALSE(slots.unreserve(occupied));
+        REQUIRE(slots.unreserve(reserved));
+        CHECK_FALSE(slots.unreserve(reserved));
+        CHECK(slots.count() == 1);
+
+        // The slot is free again, under a new generation.
+        NodeId const again = slots.reserve();
+        CHECK(SlotAllocator::slotIndex(again) == SlotAllocator::slotIndex(reserved));
+        CHECK(again != reserved);
+    }
+    SECTION("canOccupy agrees with occupy")
+    {
+        NodeId const occupied = slots.reserve();
+        slots.occupy(occupied);
+
+        NodeId const reserved = slots.reserve();
+
+        CHECK_FALSE(slots.canOccupy(occupied));
+        CHECK(slots.canOccupy(reserved));
+        CHECK_FALSE(slots.canOccupy(SlotAllocator::makeNodeId(1, 5)));
+        CHECK(slots.canOccupy(SlotAllocator::makeNodeId(2, 5)));
+        CHECK(slots.canOccupy(SlotAllocator::makeNodeId(100, 0)));
+    }
+    SECTION("slots taken by occupy are skipped by reserve")
+    {
+        for (std::size_t i = 0; i < 8; ++i)
+            slots.occupy(SlotAllocator::makeNodeId(i, 0));
+
+        for (std::size_t i = 0; i < 8; ++i)
+            slots.release(SlotAllocator::makeNodeId(i, 0));
+
+        // The free list now holds every slot, some twice.
+        for (std::size_t i = 0; i < 4; ++i)
+            slots.occupy(SlotAllocator::makeNodeId(i, 1));
+
+        std::set<std::size_t> handedOut;
+        for (std::size_t i = 0; i < 4; ++i)
+            CHECK(handedOut.insert(SlotAllocator::slotIndex(slots.reserve())).second);
+
+        CHECK(*handedOut.begin() == 4);
+        CHECK(SlotAllocator::slotIndex(slots.reserve()) == 8);
+    }
+}
+
+TEST_CASE("SlotAllocator releaseAll invalidates every id", "[slots]")
+{
+    SlotAllocator slots;
+
+    NodeId const a = slots.reserve();
+    NodeId const b = slots.reserve();
+    slots.occupy(a);
+    slots.occupy(b);
+
+    slots.releaseAll();
+
+    CHECK(slots.count() == 0);
+    CHECK_FALSE(slots.contains(a));
+    CHECK_FALSE(slots.contains(b));
+    CHECK(slots.slotCount() == 2);
+    CHECK(slots.nodeIds().empty());
+
+    NodeId const c = slots.reserve();
+    CHECK(c != a);
+    CHECK(SlotAllocator::slotIndex(c) == 0);
+}
@@ -0,0 +1,254 @@
+#include <QtNodes/GraphStore>
+#include <QtNodes/SlotAllocator>
+#include <QtNodes/StoredGraphModel>
+
+#include <catch2/catch.hpp>
+
+#include <QtCore/QJsonObject>
+
+#include <stdexcept>
+#include <vector>
+
+using QtNodes::AbstractGraphModel;
+using QtNodes::ConnectionId;
+using QtNodes::GraphStore;
+using QtNodes::InvalidNodeId;
+using QtNodes::NodeId;
+using QtNodes::NodeRole;
+using QtNodes::PortIndex;
+using QtNodes::PortRole;
+using QtNodes::PortType;
+using QtNodes::SlotAllocator;
+using QtNodes::StoredGraphModel;
+
+namespace {
+
+/// Keeps the node type as the payload, one port on each side.
+class TypedGraphModel : public StoredGraphModel<QString>
+{
+public:
+    QVariant portData(NodeId, PortType, PortIndex, PortRole) const override { return QVariant(); }
+
+    bool setPortData(NodeId, PortType, PortIndex, QVariant const &, PortRole) override
+    {
+        return false;
+    }
+
+protected:
+    void initializeNode(NodeId const nodeId, QString const &nodeType) override
+    {
+        store().payload(nodeId) = nodeType;
+        store().setPortCount(nodeId, PortType::In, 1);
+        store().setPortCount(nodeId, PortType::Out, 1);
+    }
+};
+
+} // namespace
+
+TEST_CASE("GraphStore nodes and connections", "[store]")
+{
+    GraphStore<int> store;
+
+    NodeId const a = store.addNode(1);
+    NodeId const b = store.addNode(2);
+    NodeId const c = store.addNode(3);
+
+    REQUIRE(store.nodeCount() == 3);
+    CHECK(store.nodeIds() == std::vector<NodeId>{a, b, c});
+    CHECK(store.payload(b) == 2);
+
+    store.setPortCount(a, PortType::Out, 2);
+    store.setPortCount(b, PortType::In, 1);
+    store.setPortCount(c, PortType::In, 1);
+
+    ConnectionId const ab{a, 0, b, 0};
+    ConnectionId const ac{a, 1, c, 0};
+
+    REQUIRE(store.addConnection(ab));
+    REQUIRE(store.addConnection(ac));
+
+    SECTION("connections")
+    {
+        CHECK_FALSE(store.addConnection(ab));
+        CHECK_FALSE(store.addConnection(ConnectionId{a, 0, InvalidNodeId, 0}));
+
+        CHECK(store.connectionCount() == 2);
+        CHECK(store.containsConnection(ac));
+        CHECK(store.connections(a).size() == 2);
+        CHECK(store.connections(a, PortType::Out, 1) == std::vector<ConnectionId>{ac});
+        CHECK(store.connections(c, PortType::In, 0) == std::vector<ConnectionId>{ac});
+
+        REQUIRE(store.removeConnection(ab));
+        CHECK_FALSE(store.removeConnection(ab));
+        CHECK(store.connections(b).empty());
+        CHECK(store.connections(a) == std::vector<ConnectionId>{ac});
+    }
+
+    SECTION("erased nodes take their connections along")
+    {
+        REQUIRE(store.eraseNode(a));
+
+        CHECK_FALSE(store.contains(a));
+        CHECK(store.connectionCount() == 0);
+        CHECK(store.connections(b).empty());
+        CHECK_THROWS_AS(store.payload(a), std::logic_error);
+        CHECK(store.position(a) == QPointF());
+        CHECK_FALSE(store.setPosition(a, QPointF(1.0, 1.0)));
+    }
+
+    SECTION("stale ids")
+    {
+        REQUIRE(store.eraseNode(b));
+
+        NodeId const d = store.addNode(4);
+
+        // Same slot, new generation.
+        CHECK(SlotAllocator::slotIndex(d) == SlotAllocator::slotIndex(b));
+        CHECK(d != b);
+        CHECK_FALSE(store.contains(b));
+        CHECK_FALSE(store.eraseNode(b));
+        CHECK(store.payload(d) == 4);
+        CHECK(store.portCount(d, PortType::In) == 0);
+    }
+
+    SECTION("reserved and saved ids")
+    {
+        NodeId const reserved = store.reserve();
+
+        CHECK_FALSE(store.contains(reserved));
+
+        store.insertNode(reserved, 5);
+
+        CHECK(store.payload(reserved) == 5);
+        CHECK_THROWS_AS(store.insertNode(reserved, 6), std::logic_error);
+
+        // A node comes back in its original slot.
+        REQUIRE(store.eraseNode(c));
+        store.insertNode(c, 3);
+
+        CHECK(store.contains(c));
+        CHECK(store.connections(c).empty());
+    }
+
+    SECTION("clear")
+    {
+        store.clear();
+
+        CHECK(store.nodeCount() == 0);
+        CHECK(store.connectionCount() == 0);
+        CHECK_FALSE(store.contains(a));
+    }
+}
+
+TEST_CASE("StoredGraphModel", "[store]")
+{
+    TypedGraphModel model;
+
+    NodeId const a = model.addNode("A");
+    NodeId const b = model.addNode("B");
+
+    ConnectionId const ab{a, 0, b, 0};
+
+    REQUIRE(model.connectionPossible(ab));
+    model.addConnection(ab);
+
+    REQUIRE(model.connectionExists(ab));
+    CHECK_FALSE(model.connectionPossible(ab));
+    CHECK_FALSE(model.connectionPossible(ConnectionId{a, 1, b, 0}));
+    CHECK(model.store().payload(b) == "B");
+    CHECK(model.connections(b, PortType::In, 0).count(ab) == 1);
+
+    SECTION("node data")
+    {
+        REQUIRE(model.setNodeData(a, NodeRole::Position, QPointF(3.0, 4.0)));
+
+        CHECK(model.nodeData(a, NodeRole::Position).toPointF() == QPointF(3.0, 4.0));
+        CHECK(model.nodeData(b, NodeRole::OutPortCount).toUInt() == 1);
+        CHECK_FALSE(model.nodeData(InvalidNodeId, NodeRole::Position).isValid());
+    }
+
+    SECTION("reserved ids are released")
+    {
+        NodeId const reserved = model.newNodeId();
+        model.releaseNodeId(reserved);
+
+        NodeId const c = model.addNode("C");
+
+        CHECK(c != reserved);
+        CHECK(SlotAllocator::slotIndex(c) == SlotAllocator::slotIndex(reserved));
+        CHECK_FALSE(model.nodeExists(reserved));
+    }
+
+    SECTION("deleted nodes")
+    {
+        int connectionsDeleted = 0;
+        QObject::connect(&model, &AbstractGraphModel::connectionDeleted, [&](ConnectionId) {
+            ++connectionsDeleted;
+        });
+
+        REQUIRE(model.deleteNode(a));
+
+        CHECK(connectionsDeleted == 1);
+        CHECK_FALSE(model.nodeExists(a));
+        CHECK_FALSE(model.deleteNode(a));
+        CHECK(model.allConnectionIds(b).empty());
+
+        // The stale id never refers to the node in the reused slot.
+        NodeId const c = model.addNode("C");
+
+        CHECK(SlotAllocator::slotIndex(c) == SlotAllocator::slotIndex(a));
+        CHECK_FALSE(model.nodeExists(a));
+    }
+
+    SECTION("deleteNodes announces one batch")
+    {
+        std::vector<std::vector<NodeId>> aboutToBeDeleted;
+        std::vector<std::vector<NodeId>> deleted;
+
+        QObject::connect(&model,
+                         &AbstractGraphModel::nodesAboutToBeDeleted,
+                         [&](std::vector<NodeId> const &nodeIds) {
+                             aboutToBeDeleted.push_back(nodeIds);
+                             CHECK(model.nodeExists(nodeIds.front()));
+                         });
+
+        QObject::connect(&model,
+                         &AbstractGraphModel::nodesDeleted,
+                         [&](std::vector<NodeId> const &nodeIds) { deleted.push_back(nodeIds); });
+
+        model.deleteNodes({a, a, b, InvalidNodeId});
+
+        REQUIRE(aboutToBeDeleted.size() == 1);
+        CHECK(aboutToBeDeleted[0] == std::vector<NodeId>{a, b});
+        CHECK(deleted == aboutToBeDeleted);
+        CHECK(model.allNodeIds().empty());
+    }
+
+    SECTION("saved and loaded")
+    {
+        model.setNodeData(b, NodeRole::Position, QPointF(5.0, 6.0));
+        model.setNodeData(b, NodeRole::InPortCount, 3u);
+
+        QJsonObject const saved = model.save();
+
+        TypedGraphModel restored;
+        restored.load(saved);
+
+        REQUIRE(restored.nodeExists(a));
+        REQUIRE(restored.nodeExists(b));
+        CHECK(restored.connectionExists(ab));
+        CHECK(restored.nodePosition(b) == QPointF(5.0, 6.0));
+        CHECK(restored.portCount(b, PortType::In) == 3);
+
+        // Loading under an id in use is refused.
+        CHECK_THROWS_AS(restored.loadNode(model.saveNode(a)), std::logic_error);
+    }
+
+    SECTION("removed ports take their connections along")
+    {
+        model.removePorts(b, PortType::In, 0);
+
+        CHECK(model.portCount(b, PortType::In) == 0);
+        CHECK_FALSE(model.connectionExists(ab));
+    }
+}
@@ -0,0 +1,187 @@
+#include <QtNodes/TopologicalOrder>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+using QtNodes::NodeId;
+using QtNodes::TopologicalOrder;
+
+namespace {
+
+using Edges = std::multiset<std::pair<NodeId, NodeId>>;
+
+/// Every edge goes forward in the order.
+bool agrees(TopologicalOrder const &topology, Edges const &edges)
+{
+    for (auto const &edge : edges) {
+        if (topology.position(edge.first) >= topology.position(edge.second))
+            return false;
+    }
+
+    return true;
+}
+
+bool reaches(Edges const &edges, NodeId const from, NodeId const to)
+{
+    std::set<NodeId> seen{from};
+    std::vector<NodeId> stack{from};
+
+    while (!stack.empty()) {
+        NodeId const nodeId = stack.back();
+        stack.pop_back();
+
+        if (nodeId == to)
+            return true;
+
+        for (auto const &edge : edges) {
+            if (edge.first == nodeId && seen.insert(edge.second).second)
+                stack.push_back(edge.second);
+        }
+    }
+
+    return false;
+}
+
+} // namespace
+
+TEST_CASE("TopologicalOrder reorders the affected nodes", "[topology]")
+{
+    TopologicalOrder topology;
+
+    for (NodeId nodeId = 0; nodeId < 5; ++nodeId)
+        topology.addNode(nodeId);
+
+    SECTION("edge agreeing with the order")
+    {
+        CHECK(topology.addEdge(1, 3));
+        CHECK(topology.order() == std::vector<NodeId>{0, 1, 2, 3, 4});
+    }
+    SECTION("edge against the order")
+    {
+        Edges edges{{4, 0}, {3, 4}, {0, 2}};
+
+        for (auto const &edge : edges)
+            REQUIRE(topology.addEdge(edge.first, edge.second));
+
+        CHECK(agrees(topology, edges));
+
+        // Node 1 is not connected and keeps its position.
+        CHECK(topology.order()[1] == 1);
+    }
+    SECTION("unknown nodes are added by the edge")
+    {
+        CHECK(topology.addEdge(7, 6));
+        CHECK(topology.contains(6));
+        CHECK(topology.position(7) < topology.position(6));
+    }
+}
+
+TEST_CASE("TopologicalOrder rejects cycles", "[topology]")
+{
+    TopologicalOrder topology;
+
+    REQUIRE(topology.addEdge(0, 1));
+    REQUIRE(topology.addEdge(1, 2));
+
+    SECTION("closing edge")
+    {
+        std::vector<NodeId> const before = topology.order();
+
+        CHECK(topology.createsCycle(2, 0));
+        CHECK_FALSE(topology.addEdge(2, 0));
+
+        // The graph stays unchanged.
+        CHECK(topology.order() == before);
+        CHECK(topology.addEdge(0, 2));
+    }
+    SECTION("self loop")
+    {
+        CHECK(topology.createsCycle(1, 1));
+        CHECK_FALSE(topology.addEdge(1, 1));
+    }
+    SECTION("unknown nodes never form a cycle")
+    {
+        CHECK_FALSE(topology.createsCycle(2, 9));
+        CHECK_FALSE(topology.createsCycle(9, 9));
+    }
+    SECTION("removed edge no longer blocks")
+    {
+        topology.removeEdge(1, 2);
+
+        CHECK_FALSE(topology.createsCycle(2, 0));
+        CHECK(topology.addEdge(2, 0));
+    }
+    SECTION("parallel edges are removed one by one")
+    {
+        REQUIRE(topology.addEdge(1, 2));
+
+        topology.removeEdge(1, 2);
+        CHECK(topology.createsCycle(2, 0));
+
+        topology.removeEdge(1, 2);
+        CHECK_FALSE(topology.createsCycle(2, 0));
+    }
+    SECTION("removed node takes its edges along")
+    {
+        topology.removeNode(1);
+
+        CHECK_FALSE(topology.contains(1));
+        CHECK(topology.addEdge(2, 0));
+    }
+}
+
+TEST_CASE("TopologicalOrder matches a brute force search", "[topology]")
+{
+    std::mt19937 random(42);
+
+    TopologicalOrder topology;
+    Edges edges;
+
+    NodeId const nodeCount = 40;
+
+    for (int step = 0; step < 3000; ++step) {
+        NodeId const from = random() % nodeCount;
+        NodeId const to = random() % nodeCount;
+
+        switch (random() % 8) {
+        case 0:
+            // Removing nodes leaves holes, enough of them trigger the compaction.
+            topology.removeNode(from);
+            for (auto it = edges.begin(); it != edges.end();) {
+                if (it->first == from || it->second == from)
+                    it = edges.erase(it);
+                else
+                    ++it;
+            }
+            break;
+
+        case 1:
+        case 2: {
+            auto it = edges.find({from, to});
+            if (it != edges.end()) {
+                topology.removeEdge(from, to);
+                edges.erase(it);
+            }
+        } break;
+
+        default: {
+            bool const cycle = from == to || reaches(edges, to, from);
+
+            if (topology.contains(from) && topology.contains(to))
+                REQUIRE(topology.createsCycle(from, to) == cycle);
+
+            REQUIRE(topology.addEdge(from, to) == !cycle);
+
+            if (!cycle)
+                edges.insert({from, to});
+        } break;
+        }
+
+        REQUIRE(agrees(topology, edges));
+    }
+}
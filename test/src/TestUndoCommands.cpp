@@ -0,0 +1,131 @@
+#include "ApplicationSetup.hpp"
+#include "TestDelegateModels.hpp"
+
+#include <QtNodes/BasicGraphicsScene>
+#include <QtNodes/DataFlowGraphModel>
+#include <QtNodes/internal/ConnectionGraphicsObject.hpp>
+#include <QtNodes/internal/NodeGraphicsObject.hpp>
+#include <QtNodes/internal/UndoCommands.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <QUndoStack>
+
+using QtNodes::BasicGraphicsScene;
+using QtNodes::ConnectionId;
+using QtNodes::CreateCommand;
+using QtNodes::DataFlowGraphModel;
+using QtNodes::DeleteCommand;
+using QtNodes::NodeId;
+using QtNodes::NodeRole;
+using QtNodes::SnapshotCommand;
+using QtNodes::SnapshotStorage;
+
+TEST_CASE("DeleteCommand undo and redo", "[undo]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(registerTestModels());
+    BasicGraphicsScene scene(model);
+
+    NodeId const source = model.addNode(SourceModel::Name());
+    NodeId const sum = model.addNode(SumModel::Name());
+    NodeId const other = model.addNode(SumModel::Name());
+
+    model.delegateModel<SourceModel>(source)->setValue(3.0);
+    model.setNodeData(source, NodeRole::Position, QPointF(10.0, 20.0));
+
+    ConnectionId const toSum{source, 0, sum, 0};
+    ConnectionId const toOther{source, 0, other, 1};
+
+    model.addConnection(toSum);
+    model.addConnection(toOther);
+
+    QUndoStack &undoStack = scene.undoStack();
+
+    SECTION("selected nodes with their connections")
+    {
+        scene.nodeGraphicsObject(source)->setSelected(true);
+
+        undoStack.push(new DeleteCommand(&scene));
+
+        CHECK_FALSE(model.nodeExists(source));
+        CHECK_FALSE(model.connectionExists(toSum));
+        CHECK_FALSE(model.connectionExists(toOther));
+        CHECK(model.delegateModel<SumModel>(sum)->sum() == 0.0);
+
+        for (int i = 0; i < 2; ++i) {
+            undoStack.undo();
+
+            // The same id, the internal data and the position are restored.
+            REQUIRE(model.nodeExists(source));
+            CHECK(model.delegateModel<SourceModel>(source)->value() == 3.0);
+            CHECK(model.nodePosition(source) == QPointF(10.0, 20.0));
+            CHECK(model.connectionExists(toSum));
+            CHECK(model.connectionExists(toOther));
+            CHECK(model.delegateModel<SumModel>(sum)->sum() == 3.0);
+            CHECK(scene.nodeGraphicsObject(source) != nullptr);
+            CHECK(scene.connectionGraphicsObject(toSum) != nullptr);
+
+            undoStack.redo();
+
+            CHECK_FALSE(model.nodeExists(source));
+            CHECK(scene.nodeGraphicsObject(source) == nullptr);
+            CHECK(scene.connectionGraphicsObject(toSum) == nullptr);
+        }
+    }
+
+    SECTION("selected connection only")
+    {
+        scene.connectionGraphicsObject(toOther)->setSelected(true);
+
+        undoStack.push(new DeleteCommand(&scene));
+
+        CHECK(model.nodeExists(source));
+        CHECK(model.connectionExists(toSum));
+        CHECK_FALSE(model.connectionExists(toOther));
+
+        undoStack.undo();
+
+        CHECK(model.connectionExists(toOther));
+        CHECK(model.delegateModel<SumModel>(other)->sum() == 3.0);
+    }
+
+    SECTION("nothing selected")
+    {
+        undoStack.push(new DeleteCommand(&scene));
+
+        // The obsolete command is dropped right away.
+        CHECK(undoStack.count() == 0);
+        CHECK(model.allNodeIds().size() == 3);
+    }
+}
+
+TEST_CASE("CreateCommand undo and redo", "[undo]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(registerTestModels());
+    BasicGraphicsScene scene(model);
+
+    QUndoStack &undoStack = scene.undoStack();
+
+    undoStack.push(new CreateCommand(&scene, SumModel::Name(), QPointF(5.0, 6.0)));
+
+    REQUIRE(model.allNodeIds().size() == 1);
+    NodeId const nodeId = *model.allNodeIds().begin();
+
+    undoStack.undo();
+
+    CHECK(model.allNodeIds().empty());
+
+    undoStack.redo();
+
+    // Restored from the typed snapshot taken by `undo`.
+    CHECK(model.nodeExists(nodeId));
+    CHECK(model.nodePosition(nodeId) == QPointF(5.0, 6.0));
+
+    auto command = dynamic_cast<SnapshotCommand const *>(undoStack.command(0));
+    REQUIRE(command);
+    CHECK(command->storage() == SnapshotStorage::Live);
+}
@@ -0,0 +1,198 @@
+#include "ApplicationSetup.hpp"
+#include "TestDelegateModels.hpp"
+
+#include <QtNodes/BasicGraphicsScene>
+#include <QtNodes/DataFlowGraphModel>
+#include <QtNodes/internal/NodeGraphicsObject.hpp>
+#include <QtNodes/internal/UndoCommands.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <QUndoStack>
+#include <QtCore/QTemporaryDir>
+
+#include <algorithm>
+#include <vector>
+
+using QtNodes::BasicGraphicsScene;
+using QtNodes::DataFlowGraphModel;
+using QtNodes::DeleteCommand;
+using QtNodes::NodeId;
+using QtNodes::SnapshotCommand;
+using QtNodes::SnapshotStorage;
+using QtNodes::UndoMemoryBudget;
+using QtNodes::UndoMemoryStats;
+
+namespace {
+
+SnapshotCommand *snapshotAt(QUndoStack &undoStack, int const index)
+{
+    return dynamic_cast<SnapshotCommand *>(const_cast<QUndoCommand *>(undoStack.command(index)));
+}
+
+} // namespace
+
+TEST_CASE("SnapshotCommand storage transitions", "[undo]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(registerTestModels());
+    BasicGraphicsScene scene(model);
+
+    NodeId const nodeId = model.addNode(SourceModel::Name());
+    model.delegateModel<SourceModel>(nodeId)->setValue(7.0);
+
+    scene.nodeGraphicsObject(nodeId)->setSelected(true);
+
+    QUndoStack &undoStack = scene.undoStack();
+    undoStack.push(new DeleteCommand(&scene));
+
+    SnapshotCommand *command = snapshotAt(undoStack, 0);
+    REQUIRE(command);
+    REQUIRE(command->storage() == SnapshotStorage::Live);
+    CHECK(command->memoryUsage() > 0);
+
+    SECTION("compressed")
+    {
+        REQUIRE(command->compress());
+        CHECK(command->storage() == SnapshotStorage::Compressed);
+        CHECK(command->memoryUsage() > 0);
+        CHECK_FALSE(command->compress());
+    }
+
+    SECTION("spilled")
+    {
+        QTemporaryDir directory;
+        REQUIRE(directory.isValid());
+
+        REQUIRE(command->spill(directory.path()));
+        CHECK(command->storage() == SnapshotStorage::Spilled);
+        CHECK(command->memoryUsage() == 0);
+        CHECK(command->diskUsage() > 0);
+    }
+
+    // Undo restores the payload transparently.
+    undoStack.undo();
+
+    REQUIRE(model.nodeExists(nodeId));
+    CHECK(model.delegateModel<SourceModel>(nodeId)->value() == 7.0);
+    CHECK(command->storage() == SnapshotStorage::Live);
+
+    SECTION("evicted")
+    {
+        command->evict();
+
+        CHECK(command->storage() == SnapshotStorage::Evicted);
+        CHECK(command->memoryUsage() == 0);
+        CHECK(command->isObsolete());
+    }
+}
+
+TEST_CASE("BasicGraphicsScene undo memory budget", "[undo]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(registerTestModels());
+    BasicGraphicsScene scene(model);
+
+    QUndoStack &undoStack = scene.undoStack();
+
+    // One deletion per node, the last one is the only hot command.
+    std::vector<NodeId> nodeIds;
+
+    for (int i = 0; i < 4; ++i) {
+        NodeId const nodeId = model.addNode(SourceModel::Name());
+        model.delegateModel<SourceModel>(nodeId)->setValue(i + 1);
+        nodeIds.push_back(nodeId);
+    }
+
+    for (NodeId const nodeId : nodeIds) {
+        scene.clearSelection();
+        scene.nodeGraphicsObject(nodeId)->setSelected(true);
+
+        undoStack.push(new DeleteCommand(&scene));
+    }
+
+    REQUIRE(model.allNodeIds().empty());
+
+    UndoMemoryStats const unlimited = scene.undoMemoryStats();
+    REQUIRE(unlimited.commands.size() == 4);
+
+    std::size_t commandBytes = 0;
+    for (auto const &command : unlimited.commands) {
+        CHECK(command.storage == SnapshotStorage::Live);
+        commandBytes = std::max(commandBytes, command.memoryBytes);
+    }
+
+    UndoMemoryBudget budget;
+    budget.hotCommands = 1;
+
+    auto undoAll = [&]() {
+        while (undoStack.canUndo())
+            undoStack.undo();
+    };
+
+    SECTION("cold commands compressed")
+    {
+        budget.compressColdCommands = true;
+        scene.setUndoMemoryBudget(budget);
+
+        UndoMemoryStats const stats = scene.undoMemoryStats();
+
+        REQUIRE(stats.commands.size() == 4);
+        for (int i = 0; i < 3; ++i) {
+            CHECK(stats.commands[i].storage == SnapshotStorage::Compressed);
+        }
+        CHECK(stats.commands[3].storage == SnapshotStorage::Live);
+        CHECK(stats.diskBytes == 0);
+
+        undoAll();
+
+        CHECK(model.allNodeIds().size() == 4);
+    }
+
+    SECTION("cold commands spilled")
+    {
+        QTemporaryDir directory;
+        REQUIRE(directory.isValid());
+
+        budget.maxBytes = commandBytes * 3 / 2;
+        budget.spillDirectory = directory.path();
+        scene.setUndoMemoryBudget(budget);
+
+        UndoMemoryStats const stats = scene.undoMemoryStats();
+
+        REQUIRE(stats.commands.size() == 4);
+        CHECK(stats.memoryBytes <= budget.maxBytes);
+        CHECK(stats.diskBytes > 0);
+        CHECK(stats.commands[0].storage == SnapshotStorage::Spilled);
+
+        undoAll();
+
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE(model.nodeExists(nodeIds[i]));
+            CHECK(model.delegateModel<SourceModel>(nodeIds[i])->value() == i + 1);
+        }
+    }
+
+    SECTION("oldest commands evicted")
+    {
+        budget.maxBytes = commandBytes * 3 / 2;
+        scene.setUndoMemoryBudget(budget);
+
+        UndoMemoryStats const stats = scene.undoMemoryStats();
+
+        REQUIRE(stats.commands.size() == 4);
+        for (int i = 0; i < 3; ++i) {
+            CHECK(stats.commands[i].storage == SnapshotStorage::Evicted);
+        }
+        CHECK(stats.memoryBytes <= budget.maxBytes);
+
+        undoAll();
+
+        // The history ends where the budget cut it.
+        CHECK(model.allNodeIds().size() == 1);
+        CHECK(model.nodeExists(nodeIds[3]));
+        CHECK(undoStack.count() == 1);
+    }
+}